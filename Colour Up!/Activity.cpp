@@ -46,3 +46,7 @@ void Activity::update(const double dt){
 void Activity::updateInput(){
 	//
 }
+
+bool Activity::isAnimated(){
+	return true;
+}
@@ -1,21 +1,22 @@
 #pragma once
 
-#include "KeyboardDefinitions.h";	// Header File for Keyboard Definitions
+#include "KeyboardDefinitions.h"	// Header File for Keyboard Definitions
 #include <windows.h>				// Header File For Windows
-#include "Image_Loading/nvImage.h"
-#include <gl\gl.h>					// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>					// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "GameObject.h"
 #include "BoundingBox.h"
 #include "CollidableObject.h"
 #include "Math/Point2.h"
 #include "Math/Point4.h"
 #include "Player.h"
-#include "console.h"				//Header File for Console	
 #include "Colour.h"
 #include "Clock.h"
 #include <vector>
-#include "freetype.h"		// Header for font library.
+#include <iostream>
+#include "FreeType.h"		// Header for font library.
+#include "RenderCommands.h"
+#include "Camera.h"
 
 
 #include "ImageLoading.h"
@@ -49,8 +50,13 @@ public:
 	virtual void draw();
 	virtual void update(const double dt);
 	virtual void updateInput();
+	//false when draw() gives the same frame until the activity changes
+	//(the main loop then stops redrawing it)
+	virtual bool isAnimated();
 	int					screenWidth;
 	int					screenHeight;
+	//visible part of the world, kept in sync with reshape()
+	Camera				camera;
 	void turnOn();
 	void turnOff();
 	bool isOn();
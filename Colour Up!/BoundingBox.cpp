@@ -1,6 +1,8 @@
 #include "BoundingBox.h"
 #include "Math/Point4.h"
 #include "Colour.h"
+#include "Palette.h"
+#include "RenderCommands.h"
 
 
 
@@ -22,6 +24,20 @@ BoundingBox::BoundingBox(float width, float height){
 
 	
 	
+}
+
+BoundingBox::BoundingBox(const Transform &transform, const AABB &box){
+	color = GREEN;
+	collision = false;
+
+	width = box.halfWidth * 2;
+	height = box.halfHeight * 2;
+	halfWidth = box.halfWidth;
+	halfHeight = box.halfHeight;
+
+	x = transform.x;
+	y = transform.y;
+	updateCorners();
 }
 
 BoundingBox::~BoundingBox(void)
@@ -31,16 +47,15 @@ BoundingBox::~BoundingBox(void)
 
 void BoundingBox::draw()
 {	
-	glPushMatrix();
-	glColor3fv(getColorGL(color)); //colour the bounding outline
+	commandBuffer.pushMatrix();
+	commandBuffer.colour(Palette::packed(color)); //colour the bounding outline
 	  
-	glBegin(GL_LINE_LOOP);
-		glVertex2f(-halfWidth,-halfHeight);	//left bottom
-		glVertex2f(-halfWidth,halfHeight);	//left top
-		glVertex2f(halfWidth,halfHeight);	//right top
-		glVertex2f(halfWidth,-halfHeight);	//right bottom
-	glEnd();
-	glPopMatrix();
+	commandBuffer.begin(PRIM_LINE_LOOP);
+		commandBuffer.vertex(-halfWidth,-halfHeight);	//left bottom
+		commandBuffer.vertex(-halfWidth,halfHeight);	//left top
+		commandBuffer.vertex(halfWidth,halfHeight);	//right top
+		commandBuffer.vertex(halfWidth,-halfHeight);	//right bottom
+	commandBuffer.popMatrix();
 }
 
 //Colission detection using AABB
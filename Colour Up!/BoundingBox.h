@@ -1,21 +1,33 @@
 
 #pragma once
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "Math/Point4.h"
-#include "GameObject.h"
-#include "Math\Point2.h"
+#include "Colour.h"
+#include "Components.h"
+#include "Math/Point2.h"
 
+/*
+	Axis aligned box for the collision tests, centred on x,y.
 
-class BoundingBox : public GameObject
+	A value of its own rather than a GameObject: it only ever needed the
+	position, and drawing is just the debug outline.
+*/
+class BoundingBox
 {
 	
 public:
+	float x, y;
+	float width, height;
+	float halfWidth, halfHeight;
 	float minX, minY, maxX, maxY; 
+	Color color;		//of the outline
 	bool collision;
 	BoundingBox(void);
 	BoundingBox(float, float);
+	//an obstacle's box where it is now, corners included
+	BoundingBox(const Transform&, const AABB&);
 	~BoundingBox(void);
 
 	bool collide(BoundingBox&);
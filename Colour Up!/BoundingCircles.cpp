@@ -0,0 +1,90 @@
+#include "BoundingCircles.h"
+#include "Math/Matrix4SIMD.h"
+#include <cmath>
+
+const float BoundingCircles::SLACK = 0.5f;
+
+
+BoundingCircles::BoundingCircles()
+{
+	resetStats();
+}
+
+
+BoundingCircles::~BoundingCircles()
+{
+}
+
+void BoundingCircles::assign(const World &world, const std::vector<Entity> &entities){
+	xs.resize(entities.size());
+	ys.resize(entities.size());
+	radii.resize(entities.size());
+	movers.clear();
+	for (size_t o = 0; o < entities.size(); o++){
+		const Transform &transform = world.get<Transform>(entities[o]);
+		xs[o] = transform.x;
+		ys[o] = transform.y;
+		radii[o] = boundingRadius(world.get<AABB>(entities[o]));
+		if (world.has(entities[o], maskOf<Motion>())){
+			movers.push_back((int)o);
+		}
+	}
+}
+
+void BoundingCircles::update(const World &world, const std::vector<Entity> &entities){
+	for (size_t m = 0; m < movers.size(); m++){
+		int o = movers[m];
+		const Transform &transform = world.get<Transform>(entities[o]);
+		xs[o] = transform.x;
+		ys[o] = transform.y;
+	}
+}
+
+//distance from the centre to the nearest point of the rectangle, squared, against
+//the radius squared (the same sum as Circle::intersects(BoundingBox))
+void BoundingCircles::overlapping(float x, float y, float halfWidth, float halfHeight, int first, std::vector<int> &out){
+	out.clear();
+	halfWidth += SLACK;
+	halfHeight += SLACK;
+	int count = xs.size();
+	int i = first;
+
+#ifdef MATH_SIMD_SSE2
+	typedef SimdVec4<float> V;
+	V qx = V::splat(&x), qy = V::splat(&y);
+	V hw = V::splat(&halfWidth), hh = V::splat(&halfHeight);
+	V zero = V::set(0, 0, 0, 0);
+	for (; i + 4 <= count; i += 4){
+		V dx = V::load(&xs[i]) - qx, dy = V::load(&ys[i]) - qy;
+		//|d| past the edge, or 0 inside
+		V ex = V::maximum(V::maximum(dx, zero - dx) - hw, zero);
+		V ey = V::maximum(V::maximum(dy, zero - dy) - hh, zero);
+		V r = V::load(&radii[i]);
+		int hits = V::lessEqual(ex * ex + ey * ey, r * r).bits();
+		for (int lane = 0; hits != 0; lane++, hits >>= 1){
+			if (hits & 1){
+				out.push_back(i + lane);
+			}
+		}
+	}
+#endif
+
+	for (; i < count; i++){
+		float dx = fabs(xs[i] - x) - halfWidth, dy = fabs(ys[i] - y) - halfHeight;
+		float ex = dx > 0 ? dx : 0, ey = dy > 0 ? dy : 0;
+		if (ex * ex + ey * ey <= radii[i] * radii[i]){
+			out.push_back(i);
+		}
+	}
+
+	tested += (first < count) ? count - first : 0;
+	passed += out.size();
+}
+
+void BoundingCircles::resetStats(){
+	tested = passed = 0;
+}
+
+double BoundingCircles::pruneRate() const {
+	return tested ? 1 - (double)passed / tested : 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "World.h"
+#include <vector>
+
+/*
+	Broad phase over the bounding circles of a list of entities (boundingRadius()).
+
+	The centres and radii are packed into separate arrays so a rectangle query
+	(the player's predicted box, the camera) can test them four at a time with a
+	squared distance, and only the obstacles whose circle reaches the rectangle
+	go on to the BoundingBox / Camera test.
+
+	The circle is the one round the entity's box, so a circle that misses the
+	rectangle can't have a box that hits it. Queries are padded by SLACK so
+	float rounding can't turn a box that only just touches into a reject.
+
+	Only entities with a Motion ever move: update() copies just their centres
+	back after the move pass. Anything added or erased needs assign() again.
+	Query results are positions in the list assign() was given.
+*/
+class BoundingCircles
+{
+public:
+	BoundingCircles();
+	~BoundingCircles();
+
+	//padding added to every query rectangle, in world units
+	static const float SLACK;
+
+	//repack the circle of every entity in the list
+	void assign(const World&, const std::vector<Entity>&);
+	//copy the movers' centres again, after they've moved
+	void update(const World&, const std::vector<Entity>&);
+
+	//indices (ascending, from first on) of the circles reaching the rectangle
+	//centred on x,y with the given half extents
+	void overlapping(float x, float y, float halfWidth, float halfHeight, int first, std::vector<int>&);
+
+	//start counting again
+	void resetStats();
+	//share of the circles tested that were rejected
+	double pruneRate() const;
+
+	std::vector<float> xs, ys, radii;
+	std::vector<int> movers;
+
+	//circles tested / circles that reached the rectangle, since resetStats
+	unsigned long long tested;
+	unsigned long long passed;
+};
@@ -0,0 +1,40 @@
+#include "Camera.h"
+#include <cmath>
+
+
+Camera::Camera()
+{
+	x = y = 0;
+	//matches the default window in main.cpp (displaySize 300, square)
+	halfWidth = halfHeight = 300;
+	submitted = culled = 0;
+}
+
+
+Camera::~Camera()
+{
+}
+
+void Camera::setOrtho(float halfW, float halfH){
+	halfWidth = halfW;
+	halfHeight = halfH;
+}
+
+void Camera::centreOn(float centreX, float centreY){
+	x = centreX;
+	y = centreY;
+}
+
+//objects are drawn as their AABB round the Transform
+bool Camera::isVisible(const Transform &transform, const AABB &box) const {
+	return isVisible(transform.x, transform.y, box.halfWidth, box.halfHeight);
+}
+
+bool Camera::isVisible(float objectX, float objectY, float objectHalfWidth, float objectHalfHeight) const {
+	return fabs(objectX - x) <= halfWidth + objectHalfWidth
+		&& fabs(objectY - y) <= halfHeight + objectHalfHeight;
+}
+
+void Camera::resetStats(){
+	submitted = culled = 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Components.h"
+
+/*
+	The visible world rectangle.
+
+	reshape() sets up gluOrtho2D(-displaySize, displaySize, -displaySize/aspect, displaySize/aspect)
+	and PlayGame::draw translates by -player, so what ends up on screen is that
+	window centred on the player. Anything outside it need not be submitted.
+*/
+class Camera
+{
+public:
+	Camera();
+	~Camera();
+
+	//half extents of the orthographic window
+	void setOrtho(float, float);
+	void centreOn(float, float);
+
+	bool isVisible(const Transform&, const AABB&) const;
+	bool isVisible(float, float, float, float) const;
+
+	//start counting a new frame
+	void resetStats();
+
+	float x, y;
+	float halfWidth, halfHeight;
+
+	//objects submitted / culled during the last draw; culled only counts the ones
+	//PlayGame::colourLayers' circles let through, the rest are never looked at
+	unsigned int submitted;
+	unsigned int culled;
+};
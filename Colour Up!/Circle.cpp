@@ -3,12 +3,18 @@
 //#include "Image_Loading/nvImage.h"
 
 #include <windows.h>		// Header file for Windows
-#include <gl\gl.h>			// Header file for the OpenGL32 Library
-#include <gl\glu.h>			// Header file for the GLu32 Library
+#include <GL/gl.h>			// Header file for the OpenGL32 Library
+#include <GL/glu.h>			// Header file for the GLu32 Library
 #include "BoundingBox.h"
+#include "RenderCommands.h"
+#include "Palette.h"
+#include "Math/UnitCircle.h"
 
 const double Circle::PI = 3.1415926535897932384626433;
 
+//the outline's 72 points, every 5 degrees, worked out once
+static const UnitCircle<double, 72> outline;
+
 Circle::Circle(void)
 {
 }
@@ -52,14 +58,13 @@ bool Circle::intersects(const Circle& other) const {
 
 void Circle::draw(/*texturetomap*/) const {
 
-	glPushMatrix();
-	glColor3fv(getColorGL(color));
-	glBegin(GL_LINE_LOOP);
-		for(int i=0; i<360; i+=5)
-			glVertex2f( radius * cos(i*(PI/180)), 
-					    radius * sin(i*(PI/180)));
-	glEnd();
-	glPopMatrix();
+	commandBuffer.pushMatrix();
+	commandBuffer.colour(Palette::packed(color));
+	commandBuffer.begin(PRIM_LINE_LOOP);
+		for(int i=0; i<outline.size(); i++)
+			commandBuffer.vertex( radius * outline.cosines[i], 
+					    radius * outline.sines[i]);
+	commandBuffer.popMatrix();
 }
 
 Circle::~Circle(void)
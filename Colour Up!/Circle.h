@@ -2,18 +2,21 @@
 
 
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "Math/Point4.h"
-#include "GameObject.h"
-#include "Math\Vector2.h"
+#include "Colour.h"
+#include "Math/Vector2.h"
 
 class BoundingBox;
 
-class Circle : public GameObject{
+//centre and radius, drawn as a debug outline
+class Circle {
 
 public:
 	static const double PI;
+	float x, y;
+	Color color;
 	Circle(void);
 	Circle(double, double, double);
 	bool contains(const double x,const double y) const;
@@ -22,6 +25,7 @@ public:
 	bool intersects(const Circle& other) const;
 	bool intersects(const BoundingBox& box) const;
 	void draw(/*texturetomap*/) const;
+	double getRadius() const { return radius; }
 	~Circle(void);
 	
 
@@ -1,77 +1,36 @@
 #include "CollidableObject.h"
-#include "GameObject.h"
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "BoundingBox.h"
-#include "Math\Point2.h"
+#include "RenderCommands.h"
+#include "Math/Point2.h"
 #include <iostream>
 
 
-CollidableObject::CollidableObject(void){
-	this->c = Circle(0, 0, 0);
+//every component zeroed, then what a new obstacle starts with
+CollidableObject::CollidableObject(void) : transform(), box(), sprite(), motion(), pickup(), platformType(PLATFORM), permanent(false){
+	sprite.color = WHITE;
+	sprite.visible = true;
 }
 
-void CollidableObject::toString(){
-	std::cout<<"Collidable"<<std::endl;
-}
+CollidableObject::CollidableObject(Point2<float> dimensions, Point2<float> coordinates, PlatformType plType)
+	: transform(), box(), sprite(), motion(), pickup(), platformType(plType), permanent(false){
 
-CollidableObject::CollidableObject(Point2<float> dimensions, Point2<float> coordinates, PlatformType plType) : GameObject(coordinates){
-	
-	this->platformType = plType;
-	blended = false;
-	this->bB = BoundingBox(dimensions.x, dimensions.y);
-
-	toRemove = false;
-	setSize(dimensions.x, dimensions.y);
-
-	//set the cooordinates for this
-	this->x = coordinates.x;
-	this->y = coordinates.y;
-
-	x_original = x;
-	y_original = y;
-	//create a boundingCircle
-	double radius = getHypotenuse(bB.width, bB.height) / 2;
-	this->c = Circle(x, y, radius);
-
-	//set the coordinates for the bounding box
-	this->bB.y = y;
-	this->bB.x = x;
-	reverseSpeed =  false;
-	 timeElapsed = 0;
-	 motionDuration = 0;
-	 speed = 0;
-	 moveRange = 0;
-	 toDraw = true;
-	 toCollide = true;
-}
+	transform.x = coordinates.x;
+	transform.y = coordinates.y;
+	box.halfWidth = dimensions.x / 2;
+	box.halfHeight = dimensions.y / 2;
 
-CollidableObject::CollidableObject(Point2<float> dimensions, Point2<float> coordinates) : GameObject(coordinates){
-	toRemove = false;
-	this->bB = BoundingBox(dimensions.x, dimensions.y);
-	blended = false;
-	setSize(dimensions.x, dimensions.y);
-	
-	//create a boundingCircle
-	double radius = getHypotenuse(bB.width, bB.height) / 2;
-	this->c = Circle(x, y, radius);
-	c.setColour(GREEN);
+	sprite.color = WHITE;
+	sprite.visible = true;
 
-	//set the coordinates for the bounding box
-	this->bB.y = y;
-	this->bB.x = x;
+	motion.originX = transform.x;
 
-	
-	x_original = x;
-	y_original = y;
-	 reverseSpeed =  false;
-	 timeElapsed = 0;
-	 motionDuration = 0;
-	 	 speed = 0;
-
-		 toDraw = true;
-		 toCollide = true;
+	//the only thing worth picking up
+	if (plType == LAMBDA){
+		pickup.score = 100;
+	}
 }
 
 CollidableObject::~CollidableObject()
@@ -79,174 +38,83 @@ CollidableObject::~CollidableObject()
 
 }
 
-bool CollidableObject::collide(CollidableObject & other){
-	
-	return bB.collide(other.bB); 
+BoundingBox CollidableObject::bounds() const {
+	return BoundingBox(transform, box);
 }
 
-void CollidableObject:: drawBounding(){
-	
-	glPushMatrix();
-	glTranslatef(x,y,0); 
-	this->bB.draw();
-	this->c.draw();
-
-	glPopMatrix();
-	
+float CollidableObject::boundingRadius() const {
+	return ::boundingRadius(box);
+}
 
+void CollidableObject::setColour(Color c){
+	sprite.color = c;
 }
 
+void CollidableObject::setTexture(GLuint textureID){
+	sprite.textured = true;
+	sprite.texture = textureID;
+}
 
-void CollidableObject::update(){ 
-	this->bB.updateCorners();
+void CollidableObject::draw() const {
+	drawSprite(transform, box, sprite);
 }
 
-void CollidableObject::checkBlending(Color c){
+void CollidableObject:: drawBounding() const {
+	BoundingBox outline = bounds();
+	Circle circle(0, 0, boundingRadius());
 
-	blended = (color==c) ? true : false;
+	commandBuffer.pushMatrix();
+	commandBuffer.translate(transform.x, transform.y); 
+	outline.draw();
+	circle.draw();
+
+	commandBuffer.popMatrix();
+	
 
 }
 
 
+//pick the motion's step() once per obstacle; a loop over one type only ever takes one case
 void CollidableObject::move(double dt){
-	
-	float posXlimit;
-	float negXlimit;
-	
 	switch(platformType){
 	case ALPHAFLOOR:
-		 speed = dt * speedMod*2.5;
-		 this->y += speed;
-		 this->bB.y += speed;
+		step(Rise(), transform, motion, sprite, dt);
+		break;
+	case MOVINGY:
+		step(SlideY(), transform, motion, sprite, dt);
+		break;
+	case MOVINGX:
+		step(SlideX(), transform, motion, sprite, dt);
+		break;
+	case ENEMY:
+		step(Patrol(), transform, motion, sprite, dt);
+		break;
+	default:
+		//
 		break;
-		case MOVINGY:
-			
-			speed = dt * speedMod;
-			timeElapsed +=dt;
-			
-			
-			
-			if (timeElapsed>motionDuration ){
-				if(reverseSpeed){
-					reverseSpeed = false;
-				}
-				else{
-					reverseSpeed = true;
-				}
-				timeElapsed = 0;
-			}
-
-			if(reverseSpeed){
-				speed = speed * -1;
-						
-			}
-			
-	
-
-			//apply movement
-			this->y += speed;
-			this->bB.y += speed;
-
-			break;
-		case MOVINGX:
-			
-			speed = dt * speedMod;
-			timeElapsed +=dt;
-			
-			
-			
-			if (timeElapsed>motionDuration ){
-				if(reverseSpeed){
-					reverseSpeed = false;
-				}
-				else{
-					reverseSpeed = true;
-				}
-				timeElapsed = 0;
-			}
-
-			if(reverseSpeed){
-				speed = speed * -1;
-						
-			}
-			
-	
-
-			//apply movement
-			this->x += speed;
-			this->bB.x += speed;
-
-			break;
-		case ENEMY:
-			speed = speedMod * dt;
-
-			
-		    posXlimit = x_original + moveRange;
-			negXlimit = x_original - moveRange;
-
-			if (this->x >= posXlimit || this->x <= negXlimit){
-				if (reverseSpeed){
-					reverseSpeed = false;
-					changeTexture(reverseSpeed);
-				}
-				else{
-					reverseSpeed = true;
-					changeTexture(reverseSpeed);
-				}
-		    }
-
-			if (reverseSpeed){
-				speed = speed * -1;
-				
-							
-
-			}
-			
-
-			//apply movement
-			this->x += speed;
-			this->bB.x += speed;
-			break;
-		default:
-			//
-			break;
 	}
 }
 
+
 void CollidableObject::setMotionDuration(float motion){
-	this->motionDuration = motion;
+	this->motion.duration = motion;
 }
 
 void CollidableObject::setSpeedMod(int mod){
-	this->speedMod = mod;
+	this->motion.speedMod = mod;
 }
 
-void CollidableObject::tieNPCtoPlatform(CollidableObject &platform){
-	float newX = platform.x;
-
-	this->x = newX;
-	this->bB.x = this->x;
-	this->x_original = this->x;
+void CollidableObject::tieNPCtoPlatform(const CollidableObject &platform){
+	transform.x = platform.transform.x;
+	motion.originX = transform.x;
 
-	boolean posValue = platform.y >= 0;
-	float newY = platform.y + this->height / 2 + platform.height / 2;
-	this->y = newY;
-	this->bB.y = newY;
+	transform.y = platform.transform.y + box.halfHeight + platform.box.halfHeight;
 
-	this->moveRange = (platform.width / 2) - this->width / 2;
+	motion.range = platform.box.halfWidth - box.halfWidth;
 
 	
 }
 
 void CollidableObject::stopDisplaying(){
-	toRemove = true;
+	pickup.collected = true;
 }
-
-
-void CollidableObject::changeTexture(bool left){
-	if (left)
-		currentTexture = textures[1];
-	else{
-		currentTexture = textures[0];
-	}
-}
\ No newline at end of file
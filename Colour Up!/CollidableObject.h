@@ -1,70 +1,65 @@
 #pragma once
-#include "GameObject.h"
+#include "Components.h"
 
 #include "BoundingBox.h"
 #include "Circle.h"
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>
 #include "Math/Point2.h"
 #include "Math/Point4.h"
 #include "Maths.h"
 
-class CollidableObject : public GameObject
+/*
+	An obstacle, made of the component structs in Components.h.
+
+	It used to be a GameObject carrying its own BoundingBox and Circle, each of
+	them a GameObject too, with a vtable, textures and draw flags apiece. The
+	box and the circle are now worked out from the Transform and AABB when
+	they're wanted (bounds(), boundingRadius()).
+
+	This is how a level describes an obstacle. While it runs PlayGame keeps
+	them as entities in a World, made by spawnObstacle() (Systems.h).
+*/
+class CollidableObject
 {
 public:
-	
+
 	enum PlatformType{
-		PLATFORM, DEADLYPLATFORM, MOVINGX, MOVINGY, ENEMY, LAMBDA, CMYK, ALPHAFLOOR, HSV
+		PLATFORM, DEADLYPLATFORM, MOVINGX, MOVINGY, ENEMY, LAMBDA, CMYK, ALPHAFLOOR, HSV,
+		PLATFORM_TYPE_COUNT
 	};
 
-	BoundingBox bB;
-	Circle c;
-	
-	float x_original,y_original;
-	bool blended;
-	bool toRemove;
-	float speed;
-	int speedMod;
-	float motionDuration;
-	float moveRange;
-	bool reverseSpeed;
-	float timeElapsed;
-	bool toCollide;
+	Transform transform;
+	AABB box;
+	Sprite sprite;
+	Motion motion;
+	Pickup pickup;
 	PlatformType platformType;
-	GLuint textures[2];
+	bool permanent;		//never erased by the rising floor (the walls)
+
 	CollidableObject(void);
-	/*
-	CollidableObject(BoundingBox,Point2<float>);
-	*/
 	CollidableObject(Point2<float>, Point2<float>, PlatformType);
-	CollidableObject(Point2<float>, Point2<float>);
 
 	~CollidableObject(void);
 
-	virtual bool collide(CollidableObject&);
-	void changeTexture(bool);
-	void tieNPCtoPlatform(CollidableObject&);
+	//the box where the obstacle is now
+	BoundingBox bounds() const;
+	//radius of the circle round the box
+	float boundingRadius() const;
 
-	void updateCorners(void);
+	void setColour(enum Color);
+	void setTexture(GLuint);
+	void tieNPCtoPlatform(const CollidableObject&);
 
-	void drawBounding(void);
-
-	void update(void);
-
-	void checkBlending(enum Color);
-
-	void toString();
+	void draw() const;
+	void drawBounding(void) const;
 
+	//one step of whatever motion the type has, none for the ones that stay put
 	void move(double);
 
 	void setMotionDuration(float);
 	void setSpeedMod(int);
 
 	void stopDisplaying();
-	
-	
-	
-	
 };
-
@@ -1,20 +1,28 @@
 #pragma once
 #include <windows.h>				// Header File For Windows
-#include <gl\gl.h>					// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>					// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "Colour.h"
-#include "Math\Point3.h"
+#include "Palette.h"
+#include "Math/Point3.h"
+#include "RenderCommands.h"
 #include <iostream>
 
 
+//only ever touched through the functions below
+static Color currentBGColor;
 
 //the colors correspond to enums
-//i.e. BLUE = 3 => colorArray[3] => c_blue = {0,0,1)
+//i.e. BLUE = 2 => Palette::packed(BLUE) => 0xFFFF0000 (a, b, g, r)
  void setBGColour(Color c){
 	currentBGColor = c;
 	
 }
 
+ Color getBGColour(){
+	 return currentBGColor;
+ }
+
 
 
  void resetBGColour(){
@@ -23,12 +31,7 @@
 
 void displayBG(){
 	
-	//SET
-	glClearColor(colorArray[currentBGColor][0],colorArray[currentBGColor][1],colorArray[currentBGColor][2],1);
-	glClear(GL_COLOR_BUFFER_BIT);	//DISPLAY
-
-}
+	//SET AND DISPLAY
+	commandBuffer.clearColour(Palette::packed(currentBGColor));
 
-const GLfloat* getColorGL(Color c) {
-	return colorArray[c];
 }
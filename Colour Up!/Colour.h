@@ -1,16 +1,14 @@
 #pragma once
-#include "Math\Point3.h"
+#include "Math/Point3.h"
 #include <map>
 #include <vector>
 
-static int currentBGColor;
-const GLfloat colorArray[9][3] = {{1.0f,0.0f,0.0f}, {0,1,0}, {0,0,1}, {0,0,0}, {1,1,1}, {0,1,1}, {1, 0, 1}, {1,1,0}};
-enum Color{RED, GREEN, BLUE,BLACK, WHITE, CYAN,MAGENTA,YELLOW};
+enum Color{RED, GREEN, BLUE,BLACK, WHITE, CYAN,MAGENTA,YELLOW, COLOR_COUNT};
 
+ //the one background colour, cleared to by displayBG (Palette.h has the values)
  void setBGColour(enum Color);
+ Color getBGColour();
  void displayBG();
  void resetBGColour();
 
- const GLfloat* getColorGL(Color);
-
 
@@ -0,0 +1,106 @@
+#include "ColourLayers.h"
+#include <algorithm>
+
+
+ColourLayers::ColourLayers()
+{
+}
+
+
+ColourLayers::~ColourLayers()
+{
+}
+
+ColourLayer ColourLayers::layerOf(Color c){
+	switch (c){
+	case CYAN:
+		return LAYER_CYAN;
+	case MAGENTA:
+		return LAYER_MAGENTA;
+	case YELLOW:
+		return LAYER_YELLOW;
+	default:
+		return LAYER_NONE;
+	}
+}
+
+void ColourLayers::assign(const World &world, const std::vector<Entity> &entities){
+	for (int l = 0; l < LAYER_COUNT; l++){
+		buckets[l].clear();
+		members[l].clear();
+	}
+	for (size_t o = 0; o < entities.size(); o++){
+		ColourLayer layer = layerOf(world.get<Sprite>(entities[o]).color);
+		buckets[layer].push_back((int)o);
+		members[layer].push_back(entities[o]);
+	}
+	for (int l = 0; l < LAYER_COUNT; l++){
+		circles[l].assign(world, members[l]);
+	}
+}
+
+void ColourLayers::update(const World &world){
+	for (int l = 0; l < LAYER_COUNT; l++){
+		circles[l].update(world, members[l]);
+	}
+}
+
+void ColourLayers::overlapping(ColourLayer layer, float x, float y, float halfWidth, float halfHeight, int first, std::vector<int> &out){
+	const std::vector<int> &bucket = buckets[layer];
+	//the bucket is ascending, so its obstacles from first on start here
+	int from = (int)(std::lower_bound(bucket.begin(), bucket.end(), first) - bucket.begin());
+	circles[layer].overlapping(x, y, halfWidth, halfHeight, from, positions);
+
+	out.clear();
+	for (size_t p = 0; p < positions.size(); p++){
+		out.push_back(bucket[positions[p]]);
+	}
+}
+
+//merge of the showing layers' hits, each already sorted
+void ColourLayers::collidable(float x, float y, float halfWidth, float halfHeight, int first, std::vector<int> &out){
+	out.clear();
+	size_t next[LAYER_COUNT] = { 0 };
+	for (int l = 0; l < LAYER_COUNT; l++){
+		if (isHidden((ColourLayer)l)){
+			layerHits[l].clear();
+		}
+		else{
+			overlapping((ColourLayer)l, x, y, halfWidth, halfHeight, first, layerHits[l]);
+		}
+	}
+
+	for (;;){
+		int best = -1;
+		int bestLayer = 0;
+		for (int l = 0; l < LAYER_COUNT; l++){
+			if (next[l] >= layerHits[l].size()){
+				continue;
+			}
+			if (best < 0 || layerHits[l][next[l]] < best){
+				best = layerHits[l][next[l]];
+				bestLayer = l;
+			}
+		}
+		if (best < 0){
+			return;
+		}
+		out.push_back(best);
+		next[bestLayer]++;
+	}
+}
+
+void ColourLayers::resetStats(){
+	for (int l = 0; l < LAYER_COUNT; l++){
+		circles[l].resetStats();
+	}
+}
+
+double ColourLayers::pruneRate() const {
+	unsigned long long tested = 0, passed = 0;
+	for (int l = 0; l < LAYER_COUNT; l++){
+		tested += circles[l].tested;
+		passed += circles[l].passed;
+	}
+	return tested ? 1 - (double)passed / tested : 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "World.h"
+#include "BoundingCircles.h"
+#include "Colour.h"
+#include <vector>
+
+/*
+	Obstacles bucketed by the colour classes the background can take.
+
+	Switching the background to CYAN / MAGENTA / YELLOW blends every obstacle of
+	that colour away at once. Rather than visiting every obstacle to set a flag,
+	the layer matching getBGColour() is skipped, so a switch costs the same
+	however big the level is. Anything that isn't CMY lives in LAYER_NONE and
+	never blends. The background itself is only kept in Colour.cpp.
+
+	Each layer has its own BoundingCircles over its bucket, so a query only
+	tests the circles of the layers it asks for. Collision only ever looks at
+	the layers still showing, so blended platforms don't even get the circle
+	test; drawing walks the layers one bucket at a time, so same-coloured
+	obstacles are submitted together.
+*/
+enum ColourLayer{
+	LAYER_NONE, LAYER_CYAN, LAYER_MAGENTA, LAYER_YELLOW, LAYER_COUNT
+};
+
+class ColourLayers
+{
+public:
+	ColourLayers();
+	~ColourLayers();
+
+	static ColourLayer layerOf(Color);
+
+	//rebuild the buckets and their circles, needed whenever entities are added or erased
+	void assign(const World&, const std::vector<Entity>&);
+	//copy the movers' centres again, after they've moved
+	void update(const World&);
+
+	//the background colour blends its layer away (BLACK hides nothing)
+	bool isHidden(Color c) const { return isHidden(layerOf(c)); }
+	bool isHidden(ColourLayer layer) const { return layer != LAYER_NONE && layer == layerOf(getBGColour()); }
+
+	//indices (ascending, from first on) of the layer's obstacles whose circle
+	//reaches the rectangle centred on x,y with the given half extents
+	void overlapping(ColourLayer, float x, float y, float halfWidth, float halfHeight, int first, std::vector<int>&);
+	//the same over every layer still showing, merged so collisions resolve in
+	//the same order as a plain walk over the obstacles
+	void collidable(float x, float y, float halfWidth, float halfHeight, int first, std::vector<int>&);
+
+	//start counting again
+	void resetStats();
+	//share of the circles tested that were rejected, over every layer
+	double pruneRate() const;
+
+	//indices into the entity list, in its order
+	std::vector<int> buckets[LAYER_COUNT];
+	//the entities the buckets point at, what each layer's circles were assigned
+	std::vector<Entity> members[LAYER_COUNT];
+	BoundingCircles circles[LAYER_COUNT];
+
+private:
+	//positions in a bucket from the last circle query, then each layer's hits
+	std::vector<int> positions;
+	std::vector<int> layerHits[LAYER_COUNT];
+};
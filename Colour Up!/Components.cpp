@@ -0,0 +1,57 @@
+#include "Components.h"
+#include "Palette.h"
+#include "Maths.h"
+
+
+float boundingRadius(const AABB &box){
+	return (float)(getHypotenuse(box.halfWidth * 2, box.halfHeight * 2) / 2);
+}
+
+void spriteQuad(const AABB &box, float offsetX, float offsetY, RenderVertex *quad){
+	float hw = box.halfWidth;
+	float hh = box.halfHeight;
+	float width = hw * 2, height = hh * 2;
+
+	//repeat the texture along the longer side
+	int tilesU = 1, tilesV = 1;
+	if (width<height){
+		tilesV = (int)height / width;
+	}
+	else{
+		tilesU = (int)width / height;
+	}
+
+	RenderVertex corners[4] = {
+		{ offsetX - hw, offsetY - hh, 0, 0 },
+		{ offsetX - hw, offsetY + hh, 0, (float)tilesV },
+		{ offsetX + hw, offsetY + hh, (float)tilesU, (float)tilesV },
+		{ offsetX + hw, offsetY - hh, (float)tilesU, 0 }
+	};
+	for (int v = 0; v < 4; v++){
+		quad[v] = corners[v];
+	}
+}
+
+void drawSprite(const Transform &transform, const AABB &box, const Sprite &sprite){
+	commandBuffer.pushMatrix();
+	commandBuffer.translate(transform.x, transform.y);
+	commandBuffer.colour(Palette::packed(sprite.color));
+
+	RenderVertex quad[4];
+	spriteQuad(box, 0, 0, quad);
+
+	if (sprite.textured){
+		commandBuffer.begin(PRIM_POLYGON, sprite.texture, (sprite.replace) ? TEX_REPLACE : TEX_MODULATE);
+		for (int v = 0; v < 4; v++){
+			commandBuffer.vertex(quad[v].x, quad[v].y, quad[v].u, quad[v].v);
+		}
+	}
+	else{
+		commandBuffer.begin(PRIM_POLYGON);
+		for (int v = 0; v < 4; v++){
+			commandBuffer.vertex(quad[v].x, quad[v].y);
+		}
+	}
+
+	commandBuffer.popMatrix();
+}
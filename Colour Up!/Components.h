@@ -0,0 +1,127 @@
+#pragma once
+#include <windows.h>
+#include <GL/gl.h>
+#include "Colour.h"
+#include "RenderCommands.h"
+
+/*
+	The plain data an obstacle is made of.
+
+	None of these have virtuals or constructors, so an array of them is just
+	the numbers, and code that only needs positions doesn't drag textures and
+	flags through the cache with them. Behaviour is picked at compile time:
+	each kind of motion is an empty tag type with its own step() overload,
+	so there's no switch inside the loop that moves a run of the same kind.
+	World keeps these per archetype, the tags deciding which archetype.
+*/
+
+//centre, in world units
+struct Transform {
+	float x, y;
+};
+
+//half extents round the Transform
+struct AABB {
+	float halfWidth, halfHeight;
+};
+
+//what gets drawn over the AABB
+struct Sprite {
+	GLuint texture;			//the one drawn, when textured
+	GLuint facing[2];		//right / left, for things that turn round
+	Color color;			//flat colour, or what the texture is modulated by
+	bool textured;
+	bool replace;			//texture without the colour over it
+	bool visible;
+};
+
+//back and forth over duration seconds, patrolling originX +- range, or rising
+struct Motion {
+	float speed;			//the last step's distance
+	int speedMod;			//units a second
+	float duration;
+	float elapsed;
+	float originX;
+	float range;
+	bool reversed;
+};
+
+//picked up by touching it, erased at the end of the tick
+struct Pickup {
+	int score;
+	bool collected;
+};
+
+
+//-----MOTION KINDS-----//
+
+struct SlideX {};		//MOVINGX
+struct SlideY {};		//MOVINGY
+struct Patrol {};		//ENEMY, turns at the ends of its platform
+struct Rise {};			//ALPHAFLOOR, never stops
+
+//speed a second, turned round every duration seconds
+inline float slideStep(Motion &motion, double dt){
+	motion.speed = dt * motion.speedMod;
+	motion.elapsed += dt;
+	if (motion.elapsed > motion.duration){
+		motion.reversed = !motion.reversed;
+		motion.elapsed = 0;
+	}
+	if (motion.reversed){
+		motion.speed = motion.speed * -1;
+	}
+	return motion.speed;
+}
+
+inline void step(SlideX, Transform &transform, Motion &motion, Sprite&, double dt){
+	transform.x += slideStep(motion, dt);
+}
+
+inline void step(SlideY, Transform &transform, Motion &motion, Sprite&, double dt){
+	transform.y += slideStep(motion, dt);
+}
+
+inline void step(Patrol, Transform &transform, Motion &motion, Sprite &sprite, double dt){
+	motion.speed = motion.speedMod * dt;
+	float right = motion.originX + motion.range;
+	float left = motion.originX - motion.range;
+	if (transform.x >= right || transform.x <= left){
+		motion.reversed = !motion.reversed;
+		sprite.texture = sprite.facing[motion.reversed ? 1 : 0];
+	}
+	if (motion.reversed){
+		motion.speed = motion.speed * -1;
+	}
+	transform.x += motion.speed;
+}
+
+inline void step(Rise, Transform &transform, Motion &motion, Sprite&, double dt){
+	motion.speed = dt * motion.speedMod * 2.5;
+	transform.y += motion.speed;
+}
+
+
+//-----TAGS-----//
+
+//only ever in an entity's archetype (World.h), nothing is stored for them
+struct Static {};		//never moves, baked into StaticGeometry
+struct Permanent {};	//never erased (the walls)
+struct Deadly {};		//touching it kills
+struct Goal {};			//touching it wins
+struct Carrier {};		//takes the player along by its motion.speed
+struct Lift {};			//can be jumped off while it moves
+struct PowerUp {};		//picking it up boosts the jump
+struct NoHeight {};		//standing on it doesn't count for the height score
+
+
+//radius of the circle round the AABB
+float boundingRadius(const AABB&);
+
+
+//-----DRAWING-----//
+
+//the four corners of the AABB offset by x,y, the texture tiled along the long side
+void spriteQuad(const AABB&, float, float, RenderVertex*);
+//push / translate / colour / quad / pop, what GameObject::draw used to record
+void drawSprite(const Transform&, const AABB&, const Sprite&);
@@ -0,0 +1,29 @@
+#include "ContactQueue.h"
+
+
+ContactQueue::ContactQueue()
+{
+	touched = 0;
+}
+
+
+ContactQueue::~ContactQueue()
+{
+}
+
+void ContactQueue::reserve(int obstacles){
+	contacts.reserve(obstacles);
+	kinds.reserve(obstacles);
+}
+
+void ContactQueue::clear(){
+	contacts.clear();
+	kinds.clear();
+	touched = 0;
+}
+
+void ContactQueue::push(Entity obstacle, ComponentMask kind){
+	contacts.push_back(obstacle);
+	kinds.push_back(kind);
+	touched |= kind;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "World.h"
+#include <vector>
+
+/*
+	Contacts found by the collision pass during one tick.
+
+	Detection only records which entity was hit; what the hit means (dying,
+	scoring, being carried...) is decided afterwards from its tags, one tag at
+	a time, so nothing the detection loop reads changes under it.
+
+	Storage is reserved up front for the whole level, clearing keeps it.
+*/
+class ContactQueue
+{
+public:
+	ContactQueue();
+	~ContactQueue();
+
+	//make room for a contact with every obstacle, so push never allocates
+	void reserve(int);
+	void clear();
+	void push(Entity, ComponentMask);
+
+	//was anything with one of these tags hit
+	bool any(ComponentMask tags) const { return (touched & tags) != 0; }
+
+	//entities in the order they were hit
+	std::vector<Entity> contacts;
+	//their components and tags, alongside
+	std::vector<ComponentMask> kinds;
+	//every kind hit, or'd together
+	ComponentMask touched;
+};
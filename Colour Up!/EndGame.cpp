@@ -32,8 +32,8 @@ void EndGame::update(const double dt){
 
 void EndGame::draw(){
 	displayBG();
-	glLoadIdentity();
-	glPushMatrix();
+	commandBuffer.loadIdentity();
+	commandBuffer.pushMatrix();
 	if (win){
 		freetype::print(our_font, screenWidth / 2.0 - screenWidth / 10, screenHeight / 2 + screenHeight / 8, "YOU WON\n\nSCORE: %d \nTIME: %d s \nTOTAL SCORE: %d", end_score, end_time, end_score + (200 - end_time) * 100);
 		freetype::print(our_font2, screenWidth / 2.0 - screenWidth / 10, screenHeight / 2 - screenHeight / 5, "PRESS SPACEBAR TO START AGAIN");
@@ -43,8 +43,7 @@ void EndGame::draw(){
 		freetype::print(our_font2, (screenWidth / 2.0) - screenWidth / 10, screenHeight / 2 - screenHeight/10, "PRESS SPACEBAR TO START AGAIN");
 	}
 	
-	glPopMatrix();
-	glFlush();
+	commandBuffer.popMatrix();
 }
 
 void EndGame::updateInput(){
@@ -58,6 +57,11 @@ void EndGame::updateInput(){
 
 }
 
+//the score doesn't change once we're here
+bool EndGame::isAnimated(){
+	return false;
+}
+
 void EndGame::restartGame(){
 	turnOff();
 	restart = true;
@@ -10,6 +10,7 @@ public:
 	void init();
 	void update(const double dt);
 	void updateInput();
+	bool isAnimated();
 	void restartGame();
 
 	
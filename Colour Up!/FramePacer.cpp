@@ -0,0 +1,170 @@
+#include "FramePacer.h"
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+
+double processCpuTime(){
+#ifdef _WIN32
+	//clock() is wall time on Windows
+	FILETIME created, exited, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)){
+		return 0;
+	}
+	ULARGE_INTEGER k, u;
+	k.LowPart = kernel.dwLowDateTime;
+	k.HighPart = kernel.dwHighDateTime;
+	u.LowPart = user.dwLowDateTime;
+	u.HighPart = user.dwHighDateTime;
+	return (k.QuadPart + u.QuadPart) / 1e7;		//100ns units
+#else
+	return clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+double wallClockTime(){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void FrameStats::reset(){
+	frames = 0;
+	totalMs = sumSquaresMs = 0;
+	minMs = maxMs = 0;
+	late = 0;
+	cpuSeconds = wallSeconds = 0;
+}
+
+void FrameStats::add(double ms, double targetMs){
+	if (frames == 0 || ms < minMs) minMs = ms;
+	if (frames == 0 || ms > maxMs) maxMs = ms;
+	frames++;
+	totalMs += ms;
+	sumSquaresMs += ms * ms;
+	if (targetMs > 0 && ms > targetMs * 1.5){
+		late++;
+	}
+}
+
+double FrameStats::meanMs() const {
+	return (frames > 0) ? totalMs / frames : 0;
+}
+
+double FrameStats::stdDevMs() const {
+	if (frames == 0){
+		return 0;
+	}
+	double mean = meanMs();
+	double variance = sumSquaresMs / frames - mean * mean;
+	return (variance > 0) ? sqrt(variance) : 0;
+}
+
+double FrameStats::utilisation() const {
+	return (wallSeconds > 0) ? cpuSeconds / wallSeconds : 0;
+}
+
+
+FramePacer::FramePacer()
+{
+	targetRate = 60;
+	//Sleep() with timeBeginPeriod(1) still overshoots by a millisecond or so
+	spinMargin = 0.002;
+	vsync = false;
+	refreshRate = 0;
+	deadline = lastFrame = 0;
+	started = haveLastFrame = false;
+	period.reset();
+	total.reset();
+	periodCpu = totalCpu = processCpuTime();
+	periodWall = totalWall = wallClockTime();
+}
+
+
+FramePacer::~FramePacer()
+{
+}
+
+void FramePacer::setTargetRate(double rate){
+	targetRate = (rate > 0) ? rate : 0;
+}
+
+void FramePacer::setVSync(bool active, double rate){
+	vsync = active;
+	refreshRate = rate;
+}
+
+bool FramePacer::swapPaces() const {
+	if (!vsync){
+		return false;
+	}
+	//unknown refresh rate: trust the swap rather than risk waiting two vblanks
+	return refreshRate <= 0 || targetRate == 0 || targetRate >= refreshRate * 0.95;
+}
+
+void FramePacer::wait(Platform &platform, bool swapping){
+	if (swapping && (targetRate == 0 || swapPaces())){
+		return;
+	}
+
+	double rate = targetRate;
+	if (rate == 0){
+		rate = (refreshRate > 0) ? refreshRate : 60;
+	}
+	double interval = 1.0 / rate;
+	double now = platform.now();
+	//more than a frame behind (or the swap was pacing until now): start
+	//again from here instead of rushing to catch up
+	if (!started || deadline < now - interval){
+		deadline = now;
+		started = true;
+	}
+	deadline += interval;
+
+	//below the display rate with vsync on: wake half a refresh early so the
+	//swap catches the vertical blank nearest the deadline, not the one after
+	double wakeAt = deadline;
+	if (swapping && vsync && refreshRate > 0){
+		wakeAt -= 0.5 / refreshRate;
+	}
+
+	//a virtual clock lands exactly where it's told, and spinning on it would never end
+	if (platform.clockIsVirtual()){
+		platform.sleep(wakeAt - now);
+		return;
+	}
+
+	double sleepFor = wakeAt - now - spinMargin;
+	if (sleepFor > 0){
+		platform.sleep(sleepFor);
+	}
+	while (platform.now() < wakeAt){
+		//spin the last stretch
+	}
+}
+
+void FramePacer::frameDone(Platform &platform){
+	double now = platform.now();
+	if (haveLastFrame){
+		double ms = (now - lastFrame) * 1000;
+		double targetMs = (targetRate > 0) ? 1000 / targetRate : 0;
+		period.add(ms, targetMs);
+		total.add(ms, targetMs);
+	}
+	lastFrame = now;
+	haveLastFrame = true;
+
+	double cpu = processCpuTime(), wall = wallClockTime();
+	period.cpuSeconds = cpu - periodCpu;
+	period.wallSeconds = wall - periodWall;
+	total.cpuSeconds = cpu - totalCpu;
+	total.wallSeconds = wall - totalWall;
+}
+
+void FramePacer::resetStats(){
+	period.reset();
+	periodCpu = processCpuTime();
+	periodWall = wallClockTime();
+}
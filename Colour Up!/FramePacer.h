@@ -0,0 +1,79 @@
+#pragma once
+#include "Platform.h"
+
+/*
+	Holds the main loop to a target frame rate instead of letting it spin.
+
+	Each frame has a deadline one interval after the previous one. wait()
+	sleeps through most of the gap with the platform's (coarse) sleep and
+	spins on now() for the last spinMargin seconds, which is what makes it
+	accurate. A loop that falls more than a frame behind starts again from
+	now rather than rushing to catch up.
+
+	When the swap already waits for vertical blank and the target is the
+	display rate (or the rate is unknown), the swap does the pacing and
+	wait() returns straight away, unless the frame is not being swapped.
+*/
+
+//frame times and CPU use since the last reset
+struct FrameStats {
+	unsigned int frames;		//intervals measured
+	double totalMs;
+	double sumSquaresMs;		//for the variance
+	double minMs, maxMs;
+	unsigned int late;			//intervals over 1.5 frames of the target
+	double cpuSeconds;			//process CPU time
+	double wallSeconds;			//real time, even when the platform's isn't
+
+	void reset();
+	//one interval (or one frame's work), late if over 1.5 targetMs
+	void add(double ms, double targetMs);
+
+	double meanMs() const;
+	double stdDevMs() const;
+	//CPU time over wall time, 1 = one core busy
+	double utilisation() const;
+};
+
+class FramePacer
+{
+public:
+	FramePacer();
+	~FramePacer();
+
+	//frames per second, 0 = as fast as possible
+	void setTargetRate(double);
+	//what the platform's swap does (Platform::setVSync/refreshRate)
+	void setVSync(bool, double);
+
+	//before the swap: block until this frame's deadline. Pass false when the
+	//frame isn't being swapped (nothing changed), it is then paced here even
+	//if the swap would have done it, at the display rate when uncapped
+	void wait(Platform&, bool);
+	//after the swap: record the interval since the previous frame
+	void frameDone(Platform&);
+
+	//period goes back to zero, total keeps counting
+	void resetStats();
+
+	double targetRate;
+	double spinMargin;
+	FrameStats period;
+	FrameStats total;
+
+private:
+	bool swapPaces() const;
+
+	bool vsync;
+	double refreshRate;
+	double deadline;
+	double lastFrame;
+	bool started, haveLastFrame;
+	double periodCpu, periodWall;
+	double totalCpu, totalWall;
+};
+
+//CPU time used by this process so far, in seconds
+double processCpuTime();
+//real time in seconds, for the utilisation figures
+double wallClockTime();
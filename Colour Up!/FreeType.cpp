@@ -6,7 +6,10 @@
 
 
 //Include our header file.
-#include "freetype.h"
+#include "FreeType.h"
+#include "RenderState.h"
+#include "RenderCommands.h"
+#include "TextureStore.h"
 
 namespace freetype {
 
@@ -20,7 +23,7 @@ inline int next_p2 ( int a )
 }
 
 ///Create a display list coresponding to the give character.
-void make_dlist ( FT_Face face, char ch, GLuint list_base, GLuint * tex_base ) {
+void make_dlist ( FT_Face face, char ch, GLuint list_base, GLuint * tex_base, glyph_metrics * glyphs ) {
 
 	//The first thing we do is get FreeType to render our character
 	//into a bitmap.  This actually requires a couple of FreeType commands:
@@ -78,6 +81,18 @@ void make_dlist ( FT_Face face, char ch, GLuint list_base, GLuint * tex_base ) {
     glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, width, height,
 		  0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, expanded_data );
 
+	//Keep a copy of the texture and the layout for the software backends.
+	textureStore.add(tex_base[(unsigned char)ch], width, height, GL_LUMINANCE_ALPHA, expanded_data);
+
+	glyph_metrics& metrics = glyphs[(unsigned char)ch];
+	metrics.left = bitmap_glyph->left;
+	metrics.top = bitmap_glyph->top;
+	metrics.width = bitmap.width;
+	metrics.rows = bitmap.rows;
+	metrics.advance = face->glyph->advance.x >> 6;
+	metrics.s = (float)bitmap.width / (float)width;
+	metrics.t = (float)bitmap.rows / (float)height;
+
 	//With the texture created, we don't need to expanded data anymore
     delete [] expanded_data;
 
@@ -136,6 +151,7 @@ void make_dlist ( FT_Face face, char ch, GLuint list_base, GLuint * tex_base ) {
 void font_data::init(const char * fname, unsigned int h) {
 	//Allocate some memory to store the texture ids.
 	textures = new GLuint[128];
+	glyphs = new glyph_metrics[128];
 
 	this->h=h;
 
@@ -164,11 +180,11 @@ void font_data::init(const char * fname, unsigned int h) {
 	//all the textures and displays lists which we
 	//are about to create.  
 	list_base=glGenLists(128);
-	glGenTextures( 128, textures );
+	renderState.genTextures( 128, textures );
 
 	//This is where we actually create each of the fonts display lists.
 	for(unsigned char i=0;i<128;i++)
-		make_dlist(face,i,list_base,textures);
+		make_dlist(face,i,list_base,textures,glyphs);
 
 	//We don't need the face information now that the display
 	//lists have been created, so we free the assosiated resources.
@@ -176,12 +192,17 @@ void font_data::init(const char * fname, unsigned int h) {
 
 	//Ditto for the library.
 	FT_Done_FreeType(library);
+
+	//make_dlist bound the glyph textures behind the state cache's back
+	renderState.invalidateTexture();
 }
 
 void font_data::clean() {
 	glDeleteLists(list_base,128);
 	glDeleteTextures(128,textures);
+	for(int i=0;i<128;i++) textureStore.remove(textures[i]);
 	delete [] textures;
+	delete [] glyphs;
 }
 
 /// A fairly straight forward function that pushes
@@ -208,15 +229,10 @@ inline void pop_projection_matrix() {
 }
 
 ///Much like Nehe's glPrint function, but modified to work
-///with freetype fonts.
+///with freetype fonts. The text is only recorded into the command
+///buffer here, drawText does the actual GL work when the frame is replayed.
 void print(const font_data &ft_font, float x, float y, const char *fmt, ...)  {
 	
-	// We want a coordinate system where things coresponding to window pixels.
-	pushScreenCoordinateMatrix();					
-	
-	GLuint font=ft_font.list_base;
-	float h=ft_font.h/.63f;						//We make the height about 1.5* that of
-	
 	char		text[256];								// Holds Our String
 	va_list		ap;										// Pointer To List Of Arguments
 
@@ -229,6 +245,16 @@ void print(const font_data &ft_font, float x, float y, const char *fmt, ...)  {
 	va_end(ap);											// Results Are Stored In Text
 	}
 
+	commandBuffer.text(ft_font, x, y, text);
+}
+
+void drawText(const font_data &ft_font, float x, float y, const char *text)  {
+
+	// We want a coordinate system where things coresponding to window pixels.
+	pushScreenCoordinateMatrix();					
+	
+	GLuint font=ft_font.list_base;
+	float h=ft_font.h/.63f;						//We make the height about 1.5* that of
 
 	//Here is some code to split the text that we have been
 	//given into a set of lines.  
@@ -253,13 +279,15 @@ void print(const font_data &ft_font, float x, float y, const char *fmt, ...)  {
 		lines.push_back(line);
 	}
 
-	glPushAttrib(GL_LIST_BIT | GL_CURRENT_BIT  | GL_ENABLE_BIT | GL_TRANSFORM_BIT);	
+	//No glPushAttrib here - the state we need is set through the render state
+	//cache, so a save/restore of the whole attribute group every print is avoided
+	//and the cache stays in sync with what GL really has.
 	glMatrixMode(GL_MODELVIEW);
-	glDisable(GL_LIGHTING);
-	glEnable(GL_TEXTURE_2D);
-	glDisable(GL_DEPTH_TEST);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	
+	renderState.disable(GL_LIGHTING);
+	renderState.enable(GL_TEXTURE_2D);
+	renderState.disable(GL_DEPTH_TEST);
+	renderState.enable(GL_BLEND);
+	renderState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	
 
 	glListBase(font);
 
@@ -297,8 +325,8 @@ void print(const font_data &ft_font, float x, float y, const char *fmt, ...)  {
 
 	}
 
-
-	glPopAttrib();		
+	//the display lists bind the glyph textures themselves
+	renderState.invalidateTexture();
 
 	pop_projection_matrix();
 }
@@ -39,12 +39,22 @@ using std::vector;
 //Ditto for string.
 using std::string;
 
+//Layout of one character, the same numbers make_dlist bakes into
+//the display list. Used by backends that don't replay display lists.
+struct glyph_metrics {
+	int left, top;		///< Offset of the bitmap from the pen position
+	int width, rows;	///< Size of the bitmap in pixels
+	int advance;		///< How far the pen moves afterwards
+	float s, t;			///< Part of the (power of two) texture the bitmap covers
+};
+
 //This holds all of the information related to any
 //freetype font that we want to create.  
 struct font_data {
 	float h;			///< Holds the height of the font.
 	GLuint * textures;	///< Holds the texture id's 
 	GLuint list_base;	///< Holds the first display list id
+	glyph_metrics * glyphs;	///< Holds the layout of every character
 
 	//The init function will create a font of
 	//of the height h from the file fname.
@@ -59,6 +69,10 @@ struct font_data {
 //The current modelview matrix will also be applied to the text. 
 void print(const font_data &ft_font, float x, float y, const char *fmt, ...) ;
 
+//Draws already formatted text with OpenGL - called by the GL render backend
+//when it replays the CMD_TEXT commands recorded by print.
+void drawText(const font_data &ft_font, float x, float y, const char *text);
+
 }
 
 #endif
\ No newline at end of file
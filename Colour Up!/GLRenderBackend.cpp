@@ -0,0 +1,120 @@
+#include "GLRenderBackend.h"
+#include <windows.h>
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>
+#include "RenderState.h"
+#include "Palette.h"
+#include "FreeType.h"
+#include <string>
+
+
+static const GLenum glPrimitives[] = {
+	GL_POLYGON, GL_QUADS, GL_LINE_LOOP, GL_LINES
+};
+
+
+void applyRenderState(RenderState &state, const RenderCommand &command){
+	switch (command.type){
+	case CMD_COLOUR:
+		state.colour(command.first);
+		break;
+	case CMD_DRAW:
+	case CMD_BATCH:
+		if (command.textured){
+			state.enable(GL_TEXTURE_2D);
+			state.enable(GL_BLEND);
+			state.bindTexture(command.texture);
+			state.texEnvMode((command.textureMode == TEX_REPLACE) ? GL_REPLACE : GL_MODULATE);
+			state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			state.texWrap(GL_REPEAT, GL_REPEAT);
+		}
+		else{
+			state.disable(GL_TEXTURE_2D);
+			state.disable(GL_BLEND);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+
+GLRenderBackend::GLRenderBackend()
+{
+}
+
+
+GLRenderBackend::~GLRenderBackend()
+{
+}
+
+void GLRenderBackend::execute(const CommandBuffer &buffer){
+	for (unsigned int i = 0; i < buffer.commands.size(); i++){
+		const RenderCommand &command = buffer.commands[i];
+
+		switch (command.type){
+		case CMD_CLEAR:
+		{
+			GLfloat rgba[4];
+			Palette::unpack(command.first, rgba);
+			glClearColor(rgba[0], rgba[1], rgba[2], rgba[3]);
+			glClear(GL_COLOR_BUFFER_BIT);
+			break;
+		}
+		case CMD_LOAD_IDENTITY:
+			glLoadIdentity();
+			break;
+		case CMD_PUSH_MATRIX:
+			glPushMatrix();
+			break;
+		case CMD_POP_MATRIX:
+			glPopMatrix();
+			break;
+		case CMD_TRANSLATE:
+			glTranslatef(command.f[0], command.f[1], 0);
+			break;
+		case CMD_COLOUR:
+			applyRenderState(renderState, command);
+			break;
+		case CMD_DRAW:
+			applyRenderState(renderState, command);
+			glBegin(glPrimitives[command.primitive]);
+			for (unsigned int v = command.first; v < command.first + command.count; v++){
+				const RenderVertex &vert = buffer.vertices[v];
+				if (command.textured){
+					glTexCoord2f(vert.u, vert.v);
+				}
+				glVertex2f(vert.x, vert.y);
+			}
+			glEnd();
+			break;
+		case CMD_BATCH:
+		{
+			//plain client arrays are GL 1.1, so no extension loading is needed for this
+			if (command.count == 0){
+				break;
+			}
+			applyRenderState(renderState, command);
+			const RenderVertex *verts = &buffer.batches[command.first]->vertices[0];
+			glEnableClientState(GL_VERTEX_ARRAY);
+			glVertexPointer(2, GL_FLOAT, sizeof(RenderVertex), &verts->x);
+			if (command.textured){
+				glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+				glTexCoordPointer(2, GL_FLOAT, sizeof(RenderVertex), &verts->u);
+			}
+			glDrawArrays(glPrimitives[command.primitive], 0, command.count);
+			if (command.textured){
+				glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+			}
+			glDisableClientState(GL_VERTEX_ARRAY);
+			break;
+		}
+		case CMD_TEXT:
+			freetype::drawText(*buffer.fonts[command.texture], command.f[0], command.f[1],
+				std::string(buffer.characters.begin() + command.first, buffer.characters.begin() + command.first + command.count).c_str());
+			break;
+		}
+	}
+
+	glFlush();
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "RenderBackend.h"
+
+class RenderState;
+
+//sets the cached state (colour, texturing, blending) a command needs; execute()
+//calls it ahead of drawing, and checks call it with a RenderState backed by a
+//counting GLDispatch to see which GL calls get through
+void applyRenderState(RenderState&, const RenderCommand&);
+
+//Replays a recorded frame with immediate-mode OpenGL through the render state cache
+class GLRenderBackend : public RenderBackend
+{
+public:
+	GLRenderBackend();
+	~GLRenderBackend();
+
+	void execute(const CommandBuffer&);
+};
@@ -0,0 +1,82 @@
+#include "Game.h"
+#include "RenderState.h"
+#include "GLRenderBackend.h"
+
+
+int					screenWidth=1000;
+int					screenHeight=1000;
+int					displaySize = 300;
+float				viewHalfWidth = 300;
+float				viewHalfHeight = 300;
+ActivityManager		activityManager;
+
+GLRenderBackend		glBackend;
+RenderBackend*		renderBackend = &glBackend;
+
+StartGame			startScreen;
+PlayGame			game;
+EndGame				endScreen;
+
+
+void init(void)
+{
+	activityManager.getActiveState()->init();
+}
+
+void display(void)
+{
+	renderState.beginFrame();
+	commandBuffer.clear();
+	activityManager.getActiveState()->draw();
+	renderBackend->execute(commandBuffer);
+}
+
+void update(const double dt){
+
+	activityManager.update();
+	activityManager.getActiveState()->screenHeight = screenHeight;
+	activityManager.getActiveState()->screenWidth = screenWidth;
+	activityManager.getActiveState()->camera.setOrtho(viewHalfWidth, viewHalfHeight);
+	activityManager.getActiveState()->update(dt);
+
+}
+
+void initialiseGame(){
+	startScreen = StartGame();
+	game = PlayGame();
+	endScreen = EndGame();
+	activityManager.add(&startScreen);
+	activityManager.add(&game);
+	activityManager.add(&endScreen);
+}
+
+
+void reshape(int w, int h)
+{
+	resizeView(w, h);
+	setProjection(w, h, viewHalfWidth, viewHalfHeight);
+}
+
+void resizeView(int w, int h)
+{
+	activityManager.getActiveState()->screenHeight = w;
+	activityManager.getActiveState()->screenWidth = h;
+	screenWidth=w;
+	screenHeight=h;
+
+	//-displaySize to displaySize across, the height follows the aspect ratio
+	double aspectRatio = w/(double)h;
+	viewHalfWidth = displaySize;
+	viewHalfHeight = displaySize / aspectRatio;
+	activityManager.getActiveState()->camera.setOrtho(viewHalfWidth, viewHalfHeight);
+}
+
+void setProjection(int w, int h, float halfWidth, float halfHeight)
+{
+	glViewport(0,0,(GLsizei) w, (GLsizei) h);
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	gluOrtho2D(-halfWidth, halfWidth, -halfHeight, halfHeight);
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+}
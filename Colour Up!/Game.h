@@ -0,0 +1,42 @@
+#pragma once
+#include "ActivityManager.h"
+#include "StartGame.h"
+#include "PlayGame.h"
+#include "EndGame.h"
+#include "RenderBackend.h"
+
+/*
+	The platform independent half of the old main.cpp: the three screens,
+	the fixed step and the display / update / reshape callbacks.
+
+	Entry points (WinMain in main.cpp, the GLUT window, the headless runner)
+	only create a context if they have one, feed input into the active
+	activity and call these.
+*/
+
+const int			FPS = 60;
+const double		TIME_PER_FRAME = 1.f / FPS;
+
+extern int				screenWidth;
+extern int				screenHeight;
+extern int				displaySize;
+extern float			viewHalfWidth;		//half extents of the gluOrtho2D window
+extern float			viewHalfHeight;
+
+extern ActivityManager	activityManager;
+extern StartGame		startScreen;
+extern PlayGame			game;
+extern EndGame			endScreen;
+
+//draw code records into commandBuffer, this replays it (GL unless changed)
+extern RenderBackend*	renderBackend;
+
+void				initialiseGame();
+void				init();
+void				display();
+void				update(const double dt);
+void				reshape(int width, int height);
+//the two halves of reshape: what the game sees (screen size, view extents,
+//camera) and what GL draws with, for when they happen on different threads
+void				resizeView(int width, int height);
+void				setProjection(int width, int height, float halfWidth, float halfHeight);
@@ -1,11 +1,19 @@
 #pragma once
 #include <windows.h>	
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
-#include "Math\Point3.h"
-#include "Math\Point2.h"
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
+#include "Math/Point3.h"
+#include "Math/Point2.h"
 #include "Colour.h"
+#include "RenderCommands.h"
+#include "Components.h"
 
+/*
+	A single textured quad: the player and the start / end screens.
+
+	Nothing derives from it to be drawn or sized differently, so none of it is
+	virtual. Obstacles are made of the structs in Components.h instead.
+*/
 class GameObject
 {
 public:
@@ -24,14 +32,14 @@ public:
 	GameObject(Point2<float>); //X Y
 	~GameObject(void);
 
-	virtual void setSize(float, float);
-	virtual void setColour(enum Color);
-	virtual void draw();
+	void setSize(float, float);
+	void setColour(enum Color);
+	void draw();
 	void		 setTexture(GLuint);
 
-	virtual void toString(){
-		//
-	}
-
+	//the same quad as components, for drawSprite / spriteQuad
+	Transform	 transform() const;
+	AABB		 box() const;
+	Sprite		 sprite() const;
 };
 
@@ -0,0 +1,176 @@
+#include "GlutPlatform.h"
+#include "KeyboardDefinitions.h"
+#include <windows.h>
+#include <GL/freeglut.h>
+#include <GL/glx.h>
+#include <cctype>
+#include <thread>
+
+typedef int (*SwapIntervalProc)(unsigned int);
+
+//GLUT callbacks carry no user pointer
+static GlutPlatform *activePlatform = 0;
+
+
+//ASCII from glutKeyboardFunc to a keys[] index, -1 for keys the game ignores
+static int virtualKey(unsigned char key){
+	if (key == 13) return VK_RETURN;
+	if (key == 27) return VK_ESCAPE;
+	if (key == ' ') return VK_SPACE;
+	if (isalnum(key)) return toupper(key);
+	return -1;
+}
+
+static int virtualSpecialKey(int key){
+	switch (key){
+	case GLUT_KEY_LEFT:		return VK_LEFT;
+	case GLUT_KEY_UP:		return VK_UP;
+	case GLUT_KEY_RIGHT:	return VK_RIGHT;
+	case GLUT_KEY_DOWN:		return VK_DOWN;
+	}
+	return -1;
+}
+
+static void pushKey(int key, PlatformEvent::Type type){
+	if (key >= 0){
+		activePlatform->push(type, key, 0, 0);
+	}
+}
+
+static void keyDown(unsigned char key, int, int){ pushKey(virtualKey(key), PlatformEvent::KEY_DOWN); }
+static void keyUp(unsigned char key, int, int){ pushKey(virtualKey(key), PlatformEvent::KEY_UP); }
+static void specialDown(int key, int, int){ pushKey(virtualSpecialKey(key), PlatformEvent::KEY_DOWN); }
+static void specialUp(int key, int, int){ pushKey(virtualSpecialKey(key), PlatformEvent::KEY_UP); }
+
+static void mouseMove(int x, int y){
+	activePlatform->push(PlatformEvent::MOUSE_MOVE, 0, x, activePlatform->height - y);
+}
+
+static void mouseButton(int button, int state, int x, int y){
+	if (button == GLUT_LEFT_BUTTON){
+		activePlatform->push((state == GLUT_DOWN) ? PlatformEvent::MOUSE_DOWN : PlatformEvent::MOUSE_UP, 0, x, activePlatform->height - y);
+	}
+}
+
+static void resized(int width, int height){
+	activePlatform->height = height;
+	activePlatform->push(PlatformEvent::RESIZE, 0, width, height);
+}
+
+static void closed(){
+	activePlatform->window = 0;
+	activePlatform->push(PlatformEvent::QUIT, 0, 0, 0);
+}
+
+//the loop in main.cpp draws, but may be skipping frames that didn't change
+static void expose(){
+	activePlatform->push(PlatformEvent::EXPOSE, 0, 0, 0);
+}
+
+
+GlutPlatform::GlutPlatform(int *argumentCount, char **arguments)
+{
+	argc = argumentCount;
+	argv = arguments;
+	window = 0;
+	height = 0;
+	started = std::chrono::steady_clock::now();
+}
+
+
+GlutPlatform::~GlutPlatform()
+{
+}
+
+bool GlutPlatform::createWindow(const char *title, int width, int h){
+	activePlatform = this;
+	height = h;
+
+	glutInit(argc, argv);
+	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
+	glutInitWindowSize(width, h);
+	glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_CONTINUE_EXECUTION);
+	window = glutCreateWindow(title);
+	if (!window){
+		return false;
+	}
+
+	glutIgnoreKeyRepeat(1);
+	glutDisplayFunc(expose);
+	glutReshapeFunc(resized);
+	glutKeyboardFunc(keyDown);
+	glutKeyboardUpFunc(keyUp);
+	glutSpecialFunc(specialDown);
+	glutSpecialUpFunc(specialUp);
+	glutMouseFunc(mouseButton);
+	glutMotionFunc(mouseMove);
+	glutPassiveMotionFunc(mouseMove);
+	glutCloseFunc(closed);
+	return true;
+}
+
+void GlutPlatform::destroyWindow(){
+	if (window){
+		glutDestroyWindow(window);
+		window = 0;
+	}
+}
+
+bool GlutPlatform::pollEvent(PlatformEvent &event){
+	if (events.empty() && window){
+		glutMainLoopEvent();
+	}
+	if (events.empty()){
+		return false;
+	}
+	event = events.front();
+	events.pop_front();
+	return true;
+}
+
+void GlutPlatform::swapBuffers(){
+	if (window){
+		glutSwapBuffers();
+	}
+}
+
+double GlutPlatform::now(){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+void GlutPlatform::sleep(double seconds){
+	if (seconds > 0){
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+	}
+}
+
+bool GlutPlatform::setVSync(bool on){
+	const char *names[] = { "glXSwapIntervalMESA", "glXSwapIntervalSGI" };
+	for (int i = 0; i < 2; i++){
+		SwapIntervalProc swapInterval = (SwapIntervalProc)glXGetProcAddressARB((const GLubyte*)names[i]);
+		//SGI's refuses 0, so turning it off only works through MESA
+		if (swapInterval && swapInterval((on) ? 1 : 0) == 0){
+			return on;
+		}
+	}
+	return false;
+}
+
+double GlutPlatform::refreshRate(){
+	return 0;
+}
+
+bool GlutPlatform::canMoveContext() const {
+	return false;
+}
+
+void GlutPlatform::push(PlatformEvent::Type type, int key, int x, int y){
+	PlatformEvent event;
+	event.type = type;
+	event.key = key;
+	event.x = x;
+	event.y = y;
+	//GLUT gives no timestamps, callbacks only run inside pollEvent
+	event.time = now();
+	events.push_back(event);
+}
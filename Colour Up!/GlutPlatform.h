@@ -0,0 +1,43 @@
+#pragma once
+#include "Platform.h"
+#include <chrono>
+#include <deque>
+
+/*
+	Window, context and input through freeglut, for the windowed build on
+	platforms without Win32. GLUT's callbacks queue events and pollEvent
+	runs one pass of glutMainLoopEvent when the queue is empty, so the game
+	loop in main.cpp stays in charge instead of glutMainLoop.
+*/
+class GlutPlatform : public Platform
+{
+public:
+	GlutPlatform(int*, char**);
+	~GlutPlatform();
+
+	bool createWindow(const char*, int, int);
+	void destroyWindow();
+
+	bool pollEvent(PlatformEvent&);
+	void swapBuffers();
+	double now();
+	void sleep(double);
+	//GLX_MESA_swap_control or GLX_SGI_swap_control, whichever is there
+	bool setVSync(bool);
+	//GLUT doesn't say
+	double refreshRate();
+	//freeglut owns the context and never calls XInitThreads, so it stays on
+	//the main thread and the game runs on one thread
+	bool canMoveContext() const;
+
+	//used by the GLUT callbacks
+	void push(PlatformEvent::Type, int, int, int);
+	int window;
+	int height;
+
+private:
+	int *argc;
+	char **argv;
+	std::deque<PlatformEvent> events;
+	std::chrono::steady_clock::time_point started;
+};
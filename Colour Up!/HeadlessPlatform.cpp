@@ -0,0 +1,180 @@
+#include "HeadlessPlatform.h"
+#include "KeyboardDefinitions.h"
+#include "RenderState.h"
+#include "Game.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+HeadlessPlatform::HeadlessPlatform()
+{
+	//one simulation step per frame, as if vsync'd at the update rate
+	frameTime = TIME_PER_FRAME;
+	width = height = 0;
+	nextEvent = 0;
+	sorted = true;
+	realTime = false;
+	vsync = true;
+	clock = 0;
+}
+
+
+HeadlessPlatform::~HeadlessPlatform()
+{
+}
+
+bool HeadlessPlatform::createWindow(const char*, int w, int h){
+	renderState.setDispatch(getHeadlessGLDispatch());
+	width = w;
+	height = h;
+	clock = 0;
+	started = std::chrono::steady_clock::now();
+	return true;
+}
+
+void HeadlessPlatform::destroyWindow(){
+}
+
+static bool earlier(const HeadlessPlatform::ScriptedEvent &a, const HeadlessPlatform::ScriptedEvent &b){
+	return a.frame < b.frame;
+}
+
+void HeadlessPlatform::sortScript(){
+	//stable, so a down and an up on the same frame stay in the order given
+	std::stable_sort(events.begin() + nextEvent, events.end(), earlier);
+	sorted = true;
+}
+
+bool HeadlessPlatform::pollEvent(PlatformEvent &event){
+	if (!sorted){
+		sortScript();
+	}
+	if (nextEvent == events.size() || events[nextEvent].frame > currentFrame()){
+		return false;
+	}
+	event = events[nextEvent].event;
+	event.time = events[nextEvent].frame * frameTime;
+	nextEvent++;
+	return true;
+}
+
+double HeadlessPlatform::currentFrame(){
+	//a virtual clock sitting on a frame boundary can be an ulp short of it
+	return now() / frameTime + 1e-9;
+}
+
+void HeadlessPlatform::swapBuffers(){
+	if (realTime || !vsync){
+		return;
+	}
+	//the first refresh after now, like a real swap with vsync. Landing
+	//within a hair of one counts as too late for it (frameTime is a float
+	//sixtieth, the pacer's interval a double one)
+	clock = (floor(clock / frameTime + 1e-6) + 1) * frameTime;
+}
+
+double HeadlessPlatform::now(){
+	if (realTime){
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+	}
+	return clock;
+}
+
+void HeadlessPlatform::sleep(double seconds){
+	if (seconds <= 0){
+		return;
+	}
+	if (realTime){
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+	}
+	else{
+		clock += seconds;
+	}
+}
+
+bool HeadlessPlatform::clockIsVirtual() const {
+	return !realTime;
+}
+
+//nothing to wait for in real time, there is no display
+bool HeadlessPlatform::setVSync(bool on){
+	vsync = on && !realTime;
+	return vsync;
+}
+
+double HeadlessPlatform::refreshRate(){
+	return (realTime) ? 0 : 1 / frameTime;
+}
+
+void HeadlessPlatform::script(double atFrame, PlatformEvent::Type type, int key){
+	ScriptedEvent scripted;
+	scripted.frame = atFrame;
+	scripted.event.type = type;
+	scripted.event.key = key;
+	scripted.event.x = scripted.event.y = 0;
+	scripted.event.time = 0;
+	events.push_back(scripted);
+	sorted = false;
+}
+
+void HeadlessPlatform::setFrameLimit(int frames){
+	script(frames, PlatformEvent::QUIT, 0);
+}
+
+int HeadlessPlatform::keyFromName(const char *name){
+	static const struct { const char *name; int key; } named[] = {
+		{ "SPACE", VK_SPACE }, { "RETURN", VK_RETURN }, { "ESCAPE", VK_ESCAPE },
+		{ "LEFT", VK_LEFT }, { "RIGHT", VK_RIGHT }, { "UP", VK_UP }, { "DOWN", VK_DOWN },
+	};
+	for (size_t i = 0; i < sizeof(named) / sizeof(named[0]); i++){
+		if (!strcmp(name, named[i].name)){
+			return named[i].key;
+		}
+	}
+	//letters and digits are their own (upper case) ASCII code
+	if (name[0] && !name[1] && isalnum((unsigned char)name[0])){
+		return toupper((unsigned char)name[0]);
+	}
+	return -1;
+}
+
+bool HeadlessPlatform::loadScript(const char *path){
+	std::ifstream file(path);
+	if (!file){
+		std::cerr << "can't open the script " << path << std::endl;
+		return false;
+	}
+
+	std::string line;
+	for (int lineNumber = 1; std::getline(file, line); lineNumber++){
+		line = line.substr(0, line.find('#'));
+		std::istringstream fields(line);
+		double atFrame;
+		std::string action, keyName;
+		if (!(fields >> atFrame)){
+			continue;		//blank or comment
+		}
+
+		fields >> action;
+		if (action == "quit"){
+			script(atFrame, PlatformEvent::QUIT, 0);
+			continue;
+		}
+
+		fields >> keyName;
+		int key = keyFromName(keyName.c_str());
+		if ((action != "down" && action != "up") || key < 0){
+			std::cerr << path << ":" << lineNumber << ": expected <frame> down|up <key> or <frame> quit" << std::endl;
+			return false;
+		}
+		script(atFrame, (action == "down") ? PlatformEvent::KEY_DOWN : PlatformEvent::KEY_UP, key);
+	}
+	return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Platform.h"
+#include <chrono>
+#include <vector>
+
+/*
+	No window and no GL context. Input comes from a script and by default
+	time is virtual: it only moves when the loop sleeps or swaps, and a swap
+	with vsync on waits for the next multiple of frameTime after now, like a
+	display refreshing at 1/frameTime Hz would. A run replays the same way every
+	time, however slow the box is. With realTime set the clock, sleep and
+	swap are the real thing (minus the display), which is how the frame
+	pacing is checked.
+
+	Script files have one event per line, '#' starts a comment:
+		<frame> down <key>
+		<frame> up <key>
+		<frame> quit
+	where <key> is a letter, a digit, SPACE, RETURN, ESCAPE, LEFT, RIGHT, UP
+	or DOWN. A frame is frameTime seconds of the platform clock, whatever
+	rate the loop actually runs at; events are delivered by the first poll
+	at or after their time and stamped with it. Frames can be fractional
+	(30.25 down UP) to exercise the sub-step input timing in InputQueue.
+*/
+class HeadlessPlatform : public Platform
+{
+public:
+	HeadlessPlatform();
+	~HeadlessPlatform();
+
+	//also switches the state cache over to the headless GL dispatch
+	bool createWindow(const char*, int, int);
+	void destroyWindow();
+
+	bool pollEvent(PlatformEvent&);
+	void swapBuffers();
+	double now();
+	void sleep(double);
+	bool clockIsVirtual() const;
+	bool setVSync(bool);
+	double refreshRate();
+
+	void script(double, PlatformEvent::Type, int);
+	bool loadScript(const char*);
+	//queue a quit at that frame
+	void setFrameLimit(int);
+	//frames of the clock so far
+	double currentFrame();
+
+	//name used in scripts to a VK_ code, -1 if unknown
+	static int keyFromName(const char*);
+
+	struct ScriptedEvent {
+		double frame;
+		PlatformEvent event;
+	};
+
+	double frameTime;
+	int width, height;
+	bool realTime;
+
+private:
+	void sortScript();
+
+	std::vector<ScriptedEvent> events;
+	unsigned int nextEvent;
+	bool sorted;
+
+	bool vsync;
+	double clock;
+	std::chrono::steady_clock::time_point started;
+};
@@ -1,7 +1,26 @@
+#ifdef _WIN32
+#include "Image_Loading/nvImage.h"	//has to come before gl.h (glew)
+#else
+#include <png.h>
+#include <cstring>
+#include <vector>
+#include <iostream>
+#endif
 #include "ImageLoading.h"
+#include "RenderState.h"
+#include "TextureStore.h"
 
 
-GLuint loadPNG(char* name)
+static void setTextureParameters(){
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	renderState.texWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 16.0f);
+}
+
+#ifdef _WIN32
+
+GLuint loadPNG(const char* name)
 {
 	// Texture loading object
 	nv::Image img;
@@ -11,19 +30,54 @@ GLuint loadPNG(char* name)
 	// Return true on success
 	if (img.loadImageFromFile(name))
 	{
-		glGenTextures(1, &myTextureID);
-		glBindTexture(GL_TEXTURE_2D, myTextureID);
+		renderState.genTextures(1, &myTextureID);
+		renderState.bindTexture(myTextureID);
 		glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
 		glTexImage2D(GL_TEXTURE_2D, 0, img.getInternalFormat(), img.getWidth(), img.getHeight(), 0, img.getFormat(), img.getType(), img.getLevel(0));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 16.0f);
+		//keep a copy for the backends that don't sample through GL
+		if (img.getType() == GL_UNSIGNED_BYTE && !img.isCompressed())
+			textureStore.add(myTextureID, img.getWidth(), img.getHeight(), img.getFormat(), img.getLevel(0));
+		setTextureParameters();
 	}
 
 	else
 		MessageBox(NULL, "Failed to load texture", "RUN FOR YOUR LIVES", MB_OK | MB_ICONINFORMATION);
 
 	return myTextureID;
-}
\ No newline at end of file
+}
+
+#else
+
+//nvImage only ships for Windows, elsewhere libpng's simplified API does the job
+GLuint loadPNG(const char* name)
+{
+	png_image image;
+	memset(&image, 0, sizeof(image));
+	image.version = PNG_IMAGE_VERSION;
+
+	GLuint myTextureID = 0;
+
+	if (png_image_begin_read_from_file(&image, name))
+	{
+		image.format = PNG_FORMAT_RGBA;
+		std::vector<unsigned char> pixels(PNG_IMAGE_SIZE(image));
+
+		//negative stride: bottom row first, the way GL (and nvImage) lay it out
+		if (png_image_finish_read(&image, NULL, &pixels[0], -(png_int_32)PNG_IMAGE_ROW_STRIDE(image), NULL))
+		{
+			renderState.genTextures(1, &myTextureID);
+			renderState.bindTexture(myTextureID);
+			glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+			textureStore.add(myTextureID, image.width, image.height, GL_RGBA, &pixels[0]);
+			setTextureParameters();
+			return myTextureID;
+		}
+	}
+
+	std::cerr << "Failed to load texture " << name << ": " << image.message << std::endl;
+	png_image_free(&image);
+	return myTextureID;
+}
+
+#endif
@@ -1,8 +1,7 @@
 #pragma once
 #include <windows.h>	
-#include "Image_Loading/nvImage.h"
-#include <gl\gl.h>					
-#include <gl\glu.h>	
+#include <GL/gl.h>					
+#include <GL/glu.h>	
 
-GLuint loadPNG(char*);
+GLuint loadPNG(const char*);
 
@@ -0,0 +1,136 @@
+#include "ImageWriter.h"
+#include <cstdio>
+#include <vector>
+
+
+bool writePPM(const char *path, int width, int height, const unsigned int *pixels){
+	FILE *file = fopen(path, "wb");
+	if (!file){
+		return false;
+	}
+
+	fprintf(file, "P6\n%d %d\n255\n", width, height);
+
+	std::vector<unsigned char> row(width * 3);
+	//image files go top to bottom
+	for (int y = height - 1; y >= 0; y--){
+		const unsigned int *src = pixels + y * width;
+		for (int x = 0; x < width; x++){
+			row[x * 3 + 0] = src[x] & 0xFF;
+			row[x * 3 + 1] = (src[x] >> 8) & 0xFF;
+			row[x * 3 + 2] = (src[x] >> 16) & 0xFF;
+		}
+		fwrite(&row[0], 1, row.size(), file);
+	}
+
+	fclose(file);
+	return true;
+}
+
+
+//-----PNG-----//
+
+static unsigned int crcTable[256];
+static bool crcTableReady = false;
+
+static unsigned int crc32(unsigned int crc, const unsigned char *data, size_t length){
+	if (!crcTableReady){
+		for (unsigned int n = 0; n < 256; n++){
+			unsigned int c = n;
+			for (int k = 0; k < 8; k++){
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			}
+			crcTable[n] = c;
+		}
+		crcTableReady = true;
+	}
+
+	crc = ~crc;
+	for (size_t i = 0; i < length; i++){
+		crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+static void putBigEndian(std::vector<unsigned char> &out, unsigned int value){
+	out.push_back((value >> 24) & 0xFF);
+	out.push_back((value >> 16) & 0xFF);
+	out.push_back((value >> 8) & 0xFF);
+	out.push_back(value & 0xFF);
+}
+
+static void writeChunk(FILE *file, const char *type, const std::vector<unsigned char> &data){
+	std::vector<unsigned char> chunk;
+	putBigEndian(chunk, (unsigned int)data.size());
+	chunk.insert(chunk.end(), type, type + 4);
+	chunk.insert(chunk.end(), data.begin(), data.end());
+	putBigEndian(chunk, crc32(0, &chunk[4], chunk.size() - 4));
+	fwrite(&chunk[0], 1, chunk.size(), file);
+}
+
+bool writePNG(const char *path, int width, int height, const unsigned int *pixels){
+	FILE *file = fopen(path, "wb");
+	if (!file){
+		return false;
+	}
+
+	static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	fwrite(signature, 1, 8, file);
+
+	std::vector<unsigned char> header;
+	putBigEndian(header, width);
+	putBigEndian(header, height);
+	header.push_back(8);		//bit depth
+	header.push_back(6);		//RGBA
+	header.push_back(0);		//deflate
+	header.push_back(0);		//adaptive filtering
+	header.push_back(0);		//no interlace
+	writeChunk(file, "IHDR", header);
+
+	//raw scanlines, each prefixed with filter type 0, top to bottom
+	std::vector<unsigned char> raw;
+	raw.reserve((width * 4 + 1) * height);
+	for (int y = height - 1; y >= 0; y--){
+		raw.push_back(0);
+		const unsigned int *src = pixels + y * width;
+		for (int x = 0; x < width; x++){
+			raw.push_back(src[x] & 0xFF);
+			raw.push_back((src[x] >> 8) & 0xFF);
+			raw.push_back((src[x] >> 16) & 0xFF);
+			raw.push_back((src[x] >> 24) & 0xFF);
+		}
+	}
+
+	//zlib stream made of stored (uncompressed) deflate blocks
+	std::vector<unsigned char> zlib;
+	zlib.push_back(0x78);
+	zlib.push_back(0x01);
+
+	size_t offset = 0;
+	do {
+		size_t length = raw.size() - offset;
+		if (length > 65535) length = 65535;
+		bool last = (offset + length == raw.size());
+
+		zlib.push_back(last ? 1 : 0);
+		zlib.push_back(length & 0xFF);
+		zlib.push_back((length >> 8) & 0xFF);
+		zlib.push_back(~length & 0xFF);
+		zlib.push_back((~length >> 8) & 0xFF);
+		zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+		offset += length;
+	} while (offset < raw.size());
+
+	unsigned int a = 1, b = 0;
+	for (size_t i = 0; i < raw.size(); i++){
+		a = (a + raw[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	putBigEndian(zlib, (b << 16) | a);
+
+	writeChunk(file, "IDAT", zlib);
+	writeChunk(file, "IEND", std::vector<unsigned char>());
+
+	fclose(file);
+	return true;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/*
+	Writes packed RGBA8 images (r in the lowest byte, row 0 at the bottom like a
+	GL framebuffer) to disk. PPM drops alpha, PNG keeps it and is stored
+	uncompressed so no zlib is needed.
+*/
+bool writePPM(const char*, int, int, const unsigned int*);
+bool writePNG(const char*, int, int, const unsigned int*);
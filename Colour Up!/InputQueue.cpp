@@ -0,0 +1,128 @@
+#include "InputQueue.h"
+#include <algorithm>
+#include <cstring>
+
+
+static void resetLatency(InputLatency &latency){
+	latency.events = 0;
+	latency.totalMs = 0;
+	latency.maxMs = 0;
+}
+
+static void addLatency(InputLatency &latency, double ms){
+	latency.events++;
+	latency.totalMs += ms;
+	if (ms > latency.maxMs){
+		latency.maxMs = ms;
+	}
+}
+
+
+InputQueue::InputQueue()
+{
+	activity = NULL;
+	memset(pressedThisStep, 0, sizeof(pressedThisStep));
+	coalesced = 0;
+	resetLatency(latency);
+	resetLatency(total);
+}
+
+
+InputQueue::~InputQueue()
+{
+}
+
+void InputQueue::push(const PlatformEvent &event){
+	flush();
+	if (waiting.empty() && events.push(event)){
+		return;
+	}
+
+	if (event.type == PlatformEvent::MOUSE_MOVE && !waiting.empty() && waiting.back().type == PlatformEvent::MOUSE_MOVE){
+		waiting.back() = event;
+		coalesced++;
+		return;
+	}
+	if (event.type == PlatformEvent::KEY_DOWN){
+		//only the key's last waiting event counts: down means this is a repeat
+		for (size_t i = waiting.size(); i-- > 0;){
+			if ((waiting[i].type == PlatformEvent::KEY_DOWN || waiting[i].type == PlatformEvent::KEY_UP) && waiting[i].key == event.key){
+				if (waiting[i].type == PlatformEvent::KEY_DOWN){
+					coalesced++;
+					return;
+				}
+				break;
+			}
+		}
+	}
+	waiting.push_back(event);
+}
+
+void InputQueue::flush(){
+	size_t moved = 0;
+	while (moved < waiting.size() && events.push(waiting[moved])){
+		moved++;
+	}
+	waiting.erase(waiting.begin(), waiting.begin() + moved);
+}
+
+void InputQueue::beginStep(Activity &target, double stepEnd, double now){
+	activity = &target;
+
+	PlatformEvent event;
+	while (events.peek(event) && event.time <= stepEnd){
+		events.pop(event);
+		apply(event);
+
+		//a timestamp from a coarser clock can land a little after now
+		double ms = std::max(0.0, (now - event.time) * 1000);
+		addLatency(latency, ms);
+		addLatency(total, ms);
+	}
+}
+
+void InputQueue::endStep(){
+	for (size_t i = 0; i < deferredReleases.size(); i++){
+		activity->keys[deferredReleases[i]] = false;
+	}
+	deferredReleases.clear();
+	memset(pressedThisStep, 0, sizeof(pressedThisStep));
+}
+
+void InputQueue::apply(const PlatformEvent &event){
+	switch (event.type){
+	case PlatformEvent::KEY_DOWN:
+		activity->keys[event.key] = true;
+		pressedThisStep[event.key] = true;
+		//down, up, down again: it stays down
+		deferredReleases.erase(std::remove(deferredReleases.begin(), deferredReleases.end(), event.key), deferredReleases.end());
+		break;
+	case PlatformEvent::KEY_UP:
+		if (pressedThisStep[event.key]){
+			deferredReleases.push_back(event.key);
+		}
+		else{
+			activity->keys[event.key] = false;
+		}
+		break;
+	case PlatformEvent::MOUSE_DOWN:
+		activity->mouseXY.x = event.x;
+		activity->mouseXY.y = event.y;
+		activity->LMBPressed = true;
+		break;
+	case PlatformEvent::MOUSE_UP:
+		activity->LMBPressed = false;
+		break;
+	case PlatformEvent::MOUSE_MOVE:
+		activity->mouseXY.x = event.x;
+		activity->mouseXY.y = event.y;
+		break;
+	default:
+		//quit and resize are the loop's business
+		break;
+	}
+}
+
+void InputQueue::resetStats(){
+	resetLatency(latency);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Platform.h"
+#include "SPSCQueue.h"
+#include "Activity.h"
+#include <vector>
+
+/*
+	Key and mouse events on their way from the platform layer to the
+	simulation, through a lock-free single producer / single consumer queue.
+
+	The platform side pushes events as it pumps them. The simulation applies
+	them one fixed step at a time: everything stamped up to the end of the
+	step being simulated goes into the active activity's keys[] and mouse
+	state just before that step's update(), later events wait for their own
+	step. A key that goes down and up within one step is only released after
+	the update, so taps shorter than a tick still reach updateInput().
+
+	Nothing is taken off the queue while the simulation is paused. What
+	doesn't fit waits on the platform side instead, with a mouse move folded
+	into the one before it and a key repeat into the press it repeats, so the
+	backlog only grows with real changes and a key up is never lost.
+*/
+
+//time from an event happening to the start of the update() that first sees it
+struct InputLatency {
+	unsigned int events;
+	double totalMs;
+	double maxMs;
+};
+
+class InputQueue
+{
+public:
+	InputQueue();
+	~InputQueue();
+
+	//platform side. push() queues behind anything still waiting, flush()
+	//moves what is waiting into the queue as the simulation makes room
+	void push(const PlatformEvent&);
+	void flush();
+
+	//simulation side, around every fixed step. stepEnd is the platform time
+	//the step simulates up to, now the platform time it is actually run at
+	void beginStep(Activity&, double stepEnd, double now);
+	void endStep();
+
+	//latency goes back to zero, total keeps counting
+	void resetStats();
+
+	InputLatency latency;
+	InputLatency total;
+	//mouse moves and key repeats folded into an earlier event while waiting
+	unsigned int coalesced;
+
+private:
+	void apply(const PlatformEvent&);
+
+	SPSCQueue<PlatformEvent, 512> events;
+	//platform side, oldest first
+	std::vector<PlatformEvent> waiting;
+
+	Activity *activity;
+	bool pressedThisStep[256];
+	std::vector<int> deferredReleases;
+};
@@ -0,0 +1,330 @@
+#ifndef AFFINE2_H__
+#define AFFINE2_H__
+
+#include <math.h>
+
+#include <Math/Vector2.h>
+#include <Math/Point2.h>
+#include <Math/Matrix4.h>
+
+
+
+/**
+Affine2 - 2D affine transformation (2x3 matrix)
+
+This is a template class, so 'Real' is the type used to store the matrix elements.
+Real would normally be float or double.
+Affine2f and Affine2d are aliases for Affine2<float> and Affine2<double> respectively.
+
+The top two rows of a Matrix4 built by its 2D constructors and transformations, without
+the z row and column: 6 Reals instead of 16, 8 multiplies to compose instead of 64.
+
+Members of matrix M can be accessed by:
+
+	M.d: an array of 6 reals, row by row
+
+	OR:
+
+	M.iM00, M.iM01, M.iM02
+
+	M.iM10, M.iM11, M.iM12
+
+iM02 and iM12 are the translation (iM03 and iM13 of the equivalent Matrix4).
+
+Composing, and transforming points and vectors, add their products in the same order
+as the Matrix4 operators, so both give exactly the same results for 2D transforms.
+Use toMatrix4() to hand one to glMultMatrix (Matrix4::d is in OpenGL's order).
+*/
+template <typename Real> class Affine2
+{
+public:
+	union
+	{
+		Real d[6];					//6 (2x3) floats
+
+		struct
+		{
+			Real iM00, iM01, iM02;
+			Real iM10, iM11, iM12;
+		};
+	};
+
+
+
+	/**
+	Default constructor - identity
+	*/
+	inline Affine2()
+	{
+		iM00 = (Real)1.0;	iM01 = (Real)0.0;	iM02 = (Real)0.0;
+		iM10 = (Real)0.0;	iM11 = (Real)1.0;	iM12 = (Real)0.0;
+	}
+
+	/**
+	Constructor - from elements
+	*/
+	inline Affine2(Real m00, Real m01, Real m02,
+				   Real m10, Real m11, Real m12)
+	{
+		iM00 = m00;		iM01 = m01;		iM02 = m02;
+		iM10 = m10;		iM11 = m11;		iM12 = m12;
+	}
+
+	/**
+	Constructor - from base vectors with translation
+
+	\param i -I'  The vector [1,0] transformed by the matrix
+	\param j -J'  The vector [0,1] transformed by the matrix
+	\param translation - translation
+
+
+	i.x		j.x		translation.x
+
+	i.y		j.y		translation.y
+	*/
+	inline Affine2(const Vector2<Real> &i, const Vector2<Real> &j, const Vector2<Real> &translation = Vector2<Real>())
+	{
+		iM00 = i.x;		iM01 = j.x;		iM02 = translation.x;
+		iM10 = i.y;		iM11 = j.y;		iM12 = translation.y;
+	}
+
+	/**
+	Constructor - from base vectors with origin
+
+	\param o - origin
+	\param i -I'  The vector [1,0] transformed by the matrix
+	\param j -J'  The vector [0,1] transformed by the matrix
+
+
+	i.x		j.x		o.x
+
+	i.y		j.y		o.y
+	*/
+	inline Affine2(const Point2<Real> &o, const Vector2<Real> &i, const Vector2<Real> &j)
+	{
+		iM00 = i.x;		iM01 = j.x;		iM02 = o.x;
+		iM10 = i.y;		iM11 = j.y;		iM12 = o.y;
+	}
+
+	/**
+	Constructor - the 2D part of a Matrix4
+
+	Anything \a m does to or with z is dropped.
+	*/
+	inline explicit Affine2(const Matrix4<Real> &m)
+	{
+		iM00 = m.iM00;	iM01 = m.iM01;	iM02 = m.iM03;
+		iM10 = m.iM10;	iM11 = m.iM11;	iM12 = m.iM13;
+	}
+
+
+
+	/**
+	Convert to a Matrix4, z left as it is
+	*/
+	inline Matrix4<Real> toMatrix4() const
+	{
+		return Matrix4<Real>(
+			iM00,		iM01,		(Real)0.0,	iM02,
+			iM10,		iM11,		(Real)0.0,	iM12,
+			(Real)0.0,	(Real)0.0,	(Real)1.0,	(Real)0.0,
+			(Real)0.0,	(Real)0.0,	(Real)0.0,	(Real)1.0 );
+	}
+
+	/**
+	The translation, where the origin ends up
+	*/
+	inline Vector2<Real> getTranslation() const
+	{
+		return Vector2<Real>( iM02, iM12 );
+	}
+
+
+
+	/**
+	Multiplication/contatenation operator: M * N (N is applied first)
+	*/
+	inline Affine2<Real> operator*(const Affine2<Real> &m) const
+	{
+		return Affine2<Real>(
+			iM00 * m.iM00	+	iM01 * m.iM10,
+			iM00 * m.iM01	+	iM01 * m.iM11,
+			iM00 * m.iM02	+	iM01 * m.iM12	+	iM02,
+
+			iM10 * m.iM00	+	iM11 * m.iM10,
+			iM10 * m.iM01	+	iM11 * m.iM11,
+			iM10 * m.iM02	+	iM11 * m.iM12	+	iM12 );
+	}
+
+	/**
+	Concatenation: M = M * N
+	*/
+	inline Affine2<Real> & operator*=(const Affine2<Real> &m)
+	{
+		*this = *this * m;
+		return *this;
+	}
+
+
+	/**
+	Compute the determinant of the linear part: |M|
+	*/
+	inline Real determinant() const
+	{
+		return iM00 * iM11  -  iM01 * iM10;
+	}
+
+	/**
+	Compute the inverse: M^-1
+	*/
+	inline Affine2<Real> inverse() const
+	{
+		Real dr = (Real)1.0 / determinant();
+		Real i00 = iM11 * dr,	i01 = -iM01 * dr;
+		Real i10 = -iM10 * dr,	i11 = iM00 * dr;
+		return Affine2<Real>(
+			i00,	i01,	-( i00 * iM02  +  i01 * iM12 ),
+			i10,	i11,	-( i10 * iM02  +  i11 * iM12 ) );
+	}
+
+
+
+	/**
+	Transformation: translation
+
+	\param t: translation
+
+
+	1		0		t.x
+
+	0		1		t.y
+	*/
+	inline static Affine2<Real> translate(const Vector2<Real> &t)
+	{
+		return translate( t.x, t.y );
+	}
+
+	/**
+	Transformation: translation
+
+	\param tx: translation X
+	\param ty: translation Y
+	*/
+	inline static Affine2<Real> translate(Real tx, Real ty)
+	{
+		return Affine2<Real>(
+			(Real)1.0,	(Real)0.0,	tx,
+			(Real)0.0,	(Real)1.0,	ty );
+	}
+
+	/**
+	Transformation: scale
+
+	\param s: scale factors
+
+
+	s.x		0		0
+
+	0		s.y		0
+	*/
+	inline static Affine2<Real> scale(const Vector2<Real> &s)
+	{
+		return scale( s.x, s.y );
+	}
+
+	/**
+	Transformation: scale
+
+	\param sx: scale X
+	\param sy: scale Y
+	*/
+	inline static Affine2<Real> scale(Real sx, Real sy)
+	{
+		return Affine2<Real>(
+			sx,			(Real)0.0,	(Real)0.0,
+			(Real)0.0,	sy,			(Real)0.0 );
+	}
+
+	/**
+	Transformation: uniform scale
+
+	\param s: scale factor
+	*/
+	inline static Affine2<Real> scale(Real s)
+	{
+		return scale( s, s );
+	}
+
+	/**
+	Transformation: rotate counter-clockwise
+
+	\param a : rotation angle (radians)
+
+
+	c		-s		0
+
+	s		c		0
+	*/
+	inline static Affine2<Real> rotate(Real a)
+	{
+		return rotate( (Real)sin( a ), (Real)cos( a ) );
+	}
+
+	/**
+	Transformation: rotate counter-clockwise
+
+	\param s : sin(rotation_angle)
+	\param c : cos(rotation_angle)
+	*/
+	inline static Affine2<Real> rotate(Real s, Real c)
+	{
+		return Affine2<Real>(
+			c,		-s,		(Real)0.0,
+			s,		c,		(Real)0.0 );
+	}
+
+	/**
+	Transformation: the orthographic window [\a left,\a right] x [\a bottom,\a top] onto
+	[0,\a width] x [0,\a height] (window to pixels)
+	*/
+	inline static Affine2<Real> window(Real left, Real right, Real bottom, Real top, Real width, Real height)
+	{
+		return scale( width / ( right - left ), height / ( top - bottom ) )  *  translate( -left, -bottom );
+	}
+};
+
+
+
+/**
+Multiply an Affine2<Real> by a Point2<Real>
+
+Applies the transformation represented by \a m to \a p
+*/
+template <typename Real> inline Point2<Real> operator*(const Affine2<Real> &m, const Point2<Real> &p)
+{
+	return Point2<Real>(
+		p.x * m.iM00  +  p.y * m.iM01  +  m.iM02,
+		p.x * m.iM10  +  p.y * m.iM11  +  m.iM12 );
+}
+
+/**
+Multiply an Affine2<Real> by a Vector2<Real>
+
+Applies the transformation represented by \a m to \a v
+
+NOTE: translations are *NOT* applied to vectors
+*/
+template <typename Real> inline Vector2<Real> operator*(const Affine2<Real> &m, const Vector2<Real> &v)
+{
+	return Vector2<Real>(
+		v.x * m.iM00  +  v.y * m.iM01,
+		v.x * m.iM10  +  v.y * m.iM11 );
+}
+
+
+
+typedef Affine2<float> Affine2f;
+typedef Affine2<double> Affine2d;
+
+
+#endif
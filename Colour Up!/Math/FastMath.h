@@ -0,0 +1,240 @@
+#ifndef FASTMATH_H__
+#define FASTMATH_H__
+
+#include <math.h>
+#include <stddef.h>
+
+#include <Math/MathConstants.h>
+#include <Math/Vector3.h>
+#include <Math/Quaternion.h>
+#include <Math/Matrix4SIMD.h>
+
+
+
+/**
+FastMath - single precision approximations of 1/sqrt, sin and cos
+
+Nothing uses these unless it asks for them: Vector3::normalise(), Quaternion::rotateAxis()
+and friends still go through libm. They are for paths that only need a few pixels' worth of
+precision (debug drawing, directions for rendering), not for the simulation.
+
+Error bounds, checked by colourup_bench --check:
+
+	rsqrt(x):			relative error under rsqrtError() for any normal, positive x
+						(SSE's rsqrtss estimate is good to 1.5 * 2^-12, one Newton step
+						squares that)
+
+	sinCos(a, s, c):	absolute error under sinCosError() for |a| <= sinCosRange()
+						(polynomials on [-pi/4, pi/4] after reducing by a multiple of pi/2;
+						the reduction loses precision beyond that range)
+
+Without SSE2, rsqrt() is 1 / sqrt() and exact to rounding.
+*/
+class FastMath
+{
+public:
+	inline static float rsqrtError()
+	{
+		return 1e-6f;
+	}
+
+	inline static float sinCosError()
+	{
+		return 5e-7f;
+	}
+
+	inline static float sinCosRange()
+	{
+		return 8192.0f;
+	}
+
+
+
+	/**
+	Approximate 1 / sqrt( \a x ), \a x > 0
+	*/
+	inline static float rsqrt(float x)
+	{
+#ifdef MATH_SIMD_SSE2
+		return _mm_cvtss_f32( rsqrt4( _mm_set_ss( x ) ) );
+#else
+		return 1.0f / sqrtf( x );
+#endif
+	}
+
+	/**
+	rsqrt() of \a count values from \a in, written to \a out (which may be \a in)
+
+	Four at a time, each giving exactly what rsqrt() would.
+	*/
+	inline static void rsqrt(const float *in, float *out, size_t count)
+	{
+		size_t i = 0;
+#ifdef MATH_SIMD_SSE2
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_ps( out + i, rsqrt4( _mm_loadu_ps( in + i ) ) );
+		}
+#endif
+		for (; i < count; i++)
+		{
+			out[i] = rsqrt( in[i] );
+		}
+	}
+
+	/**
+	\a v scaled to (approximately) length 1
+	*/
+	inline static Vector3<float> normalised(const Vector3<float> &v)
+	{
+		float oneOverLength = rsqrt( v.sqrLength() );
+		return Vector3<float>( v.x * oneOverLength, v.y * oneOverLength, v.z * oneOverLength );
+	}
+
+	/**
+	normalised() of \a count vectors from \a in, written to \a out (which may be \a in)
+	*/
+	inline static void normalise(const Vector3<float> *in, Vector3<float> *out, size_t count)
+	{
+		size_t i = 0;
+#ifdef MATH_SIMD_SSE2
+		static_assert( sizeof( Vector3<float> ) == 3 * sizeof( float ), "Vector3 has to be three packed floats" );
+		typedef SimdVec4<float> V;
+		for (; i + 4 <= count; i += 4)
+		{
+			V x, y, z;
+			SimdInterleave<float>::load3( in[i].v, x, y, z );
+			V oneOverLength = V::make( rsqrt4( ( x * x  +  y * y  +  z * z ).v ) );
+			SimdInterleave<float>::store3( out[i].v, x * oneOverLength, y * oneOverLength, z * oneOverLength );
+		}
+#endif
+		for (; i < count; i++)
+		{
+			out[i] = normalised( in[i] );
+		}
+	}
+
+	/**
+	\a q scaled to (approximately) unit norm
+	*/
+	inline static Quaternion<float> normalised(const Quaternion<float> &q)
+	{
+		float oneOverModulus = rsqrt( q.norm() );
+		return Quaternion<float>( q.x * oneOverModulus, q.y * oneOverModulus, q.z * oneOverModulus, q.w * oneOverModulus );
+	}
+
+
+
+	/**
+	Approximate sin( \a a ) and cos( \a a ) together, \a a in radians
+
+	One at a time this is about as fast as glibc's sinf and cosf; the batch version
+	below is where it pays.
+	*/
+	inline static void sinCos(float a, float &s, float &c)
+	{
+		//nearest multiple of pi/2, subtracted in three parts so the first two products are exact
+		int quadrant = (int)( a * (float)( 2.0 / M_PI )  +  ( a < 0.0f  ?  -0.5f  :  0.5f ) );
+		float q = (float)quadrant;
+		float r = ( ( a  -  q * 1.5703125f )  -  q * 4.837512969970703125e-4f )  -  q * 7.54978995489188216e-8f;
+		float r2 = r * r;
+
+		//minimax polynomials on [-pi/4, pi/4] (from Cephes' sinf and cosf)
+		float sinR = r  +  r * r2 * ( -1.6666654611e-1f  +  r2 * ( 8.3321608736e-3f  +  r2 * -1.9515295891e-4f ) );
+		float cosR = 1.0f  -  0.5f * r2  +  r2 * r2 * ( 4.166664568298827e-2f  +  r2 * ( -1.388731625493765e-3f  +  r2 * 2.443315711809948e-5f ) );
+
+		//rotate by the quadrant: odd ones swap sin and cos, then the signs go round
+		//(selects rather than a switch, the quadrant is rarely predictable)
+		bool odd = ( quadrant & 1 ) != 0;
+		float sinQ = odd  ?  cosR  :  sinR;
+		float cosQ = odd  ?  sinR  :  cosR;
+		s = ( quadrant & 2 )  ?  -sinQ  :  sinQ;
+		c = ( ( quadrant + 1 ) & 2 )  ?  -cosQ  :  cosQ;
+	}
+
+	/**
+	sinCos() of \a count angles from \a a, into \a s and \a c
+
+	Four at a time; the same polynomials and the same bound, though a lane can round
+	differently from sinCos() in the last bit.
+	*/
+	inline static void sinCos(const float *a, float *s, float *c, size_t count)
+	{
+		size_t i = 0;
+#ifdef MATH_SIMD_SSE2
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 s4, c4;
+			sinCos4( _mm_loadu_ps( a + i ), s4, c4 );
+			_mm_storeu_ps( s + i, s4 );
+			_mm_storeu_ps( c + i, c4 );
+		}
+#endif
+		for (; i < count; i++)
+		{
+			sinCos( a[i], s[i], c[i] );
+		}
+	}
+
+	/**
+	Quaternion<float>::rotateAxis(), with sinCos()
+
+	\param axis - unit vector
+	\param angle - radians
+	*/
+	inline static Quaternion<float> rotateAxis(const Vector3<float> &axis, float angle)
+	{
+		float s, c;
+		sinCos( angle * 0.5f, s, c );
+		return Quaternion<float>::rotateAxisSinCos( axis, s, c );
+	}
+
+
+
+#ifdef MATH_SIMD_SSE2
+	/**
+	Four rsqrt()s: the rsqrtps estimate r, refined by one Newton step r * (1.5 - 0.5 * x * r * r)
+	*/
+	inline static __m128 rsqrt4(__m128 x)
+	{
+		__m128 r = _mm_rsqrt_ps( x );
+		__m128 halfXrr = _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5f ), x ), _mm_mul_ps( r, r ) );
+		return _mm_mul_ps( r, _mm_sub_ps( _mm_set1_ps( 1.5f ), halfXrr ) );
+	}
+
+	/**
+	Four sinCos()s, the quadrant's swaps and sign flips done with masks
+	*/
+	inline static void sinCos4(__m128 a, __m128 &s, __m128 &c)
+	{
+		__m128i quadrant = _mm_cvtps_epi32( _mm_mul_ps( a, _mm_set1_ps( (float)( 2.0 / M_PI ) ) ) );
+		__m128 q = _mm_cvtepi32_ps( quadrant );
+		__m128 r = _mm_sub_ps( a, _mm_mul_ps( q, _mm_set1_ps( 1.5703125f ) ) );
+		r = _mm_sub_ps( r, _mm_mul_ps( q, _mm_set1_ps( 4.837512969970703125e-4f ) ) );
+		r = _mm_sub_ps( r, _mm_mul_ps( q, _mm_set1_ps( 7.54978995489188216e-8f ) ) );
+		__m128 r2 = _mm_mul_ps( r, r );
+
+		__m128 sinPoly = _mm_add_ps( _mm_set1_ps( 8.3321608736e-3f ), _mm_mul_ps( r2, _mm_set1_ps( -1.9515295891e-4f ) ) );
+		sinPoly = _mm_add_ps( _mm_set1_ps( -1.6666654611e-1f ), _mm_mul_ps( r2, sinPoly ) );
+		__m128 sinR = _mm_add_ps( r, _mm_mul_ps( _mm_mul_ps( r, r2 ), sinPoly ) );
+
+		__m128 cosPoly = _mm_add_ps( _mm_set1_ps( -1.388731625493765e-3f ), _mm_mul_ps( r2, _mm_set1_ps( 2.443315711809948e-5f ) ) );
+		cosPoly = _mm_add_ps( _mm_set1_ps( 4.166664568298827e-2f ), _mm_mul_ps( r2, cosPoly ) );
+		__m128 cosR = _mm_add_ps( _mm_sub_ps( _mm_set1_ps( 1.0f ), _mm_mul_ps( _mm_set1_ps( 0.5f ), r2 ) ),
+								  _mm_mul_ps( _mm_mul_ps( r2, r2 ), cosPoly ) );
+
+		__m128i one = _mm_set1_epi32( 1 ), two = _mm_set1_epi32( 2 );
+		__m128 odd = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( quadrant, one ), one ) );
+		__m128 sinQ = _mm_or_ps( _mm_and_ps( odd, cosR ), _mm_andnot_ps( odd, sinR ) );
+		__m128 cosQ = _mm_or_ps( _mm_and_ps( odd, sinR ), _mm_andnot_ps( odd, cosR ) );
+		//bit 1 of the quadrant (and of quadrant + 1) moved up to the sign bit
+		__m128i sinSign = _mm_slli_epi32( _mm_and_si128( quadrant, two ), 30 );
+		__m128i cosSign = _mm_slli_epi32( _mm_and_si128( _mm_add_epi32( quadrant, one ), two ), 30 );
+		s = _mm_xor_ps( sinQ, _mm_castsi128_ps( sinSign ) );
+		c = _mm_xor_ps( cosQ, _mm_castsi128_ps( cosSign ) );
+	}
+#endif
+};
+
+
+#endif
@@ -0,0 +1,315 @@
+#ifndef GEOMETRYBATCH_H__
+#define GEOMETRYBATCH_H__
+
+#include <stddef.h>
+
+#include <limits>
+
+#include <Math/Matrix4SIMD.h>
+#include <Math/Segment2.h>
+#include <Math/Triangle2.h>
+
+
+
+/**
+SegmentSpan2 - \a count 2D segments as separate arrays of end point co-ordinates
+
+Segment i runs from (ax[i], ay[i]) to (bx[i], by[i]).
+*/
+template <typename Real> class SegmentSpan2
+{
+public:
+	const Real *ax, *ay, *bx, *by;
+	size_t count;
+
+
+	inline SegmentSpan2() : ax( NULL ), ay( NULL ), bx( NULL ), by( NULL ), count( 0 )
+	{
+	}
+
+	inline SegmentSpan2(const Real *iax, const Real *iay, const Real *ibx, const Real *iby, size_t icount)
+		: ax( iax ), ay( iay ), bx( ibx ), by( iby ), count( icount )
+	{
+	}
+
+
+	/**
+	Segment \a i as a Segment2
+	*/
+	inline Segment2<Real> get(size_t i) const
+	{
+		return Segment2<Real>( Point2<Real>( ax[i], ay[i] ), Point2<Real>( bx[i], by[i] ) );
+	}
+};
+
+
+/**
+TriangleSpan2 - \a count 2D triangles as separate arrays of corner co-ordinates
+
+Triangle i has corners (ax[i], ay[i]), (bx[i], by[i]) and (cx[i], cy[i]), either winding.
+*/
+template <typename Real> class TriangleSpan2
+{
+public:
+	const Real *ax, *ay, *bx, *by, *cx, *cy;
+	size_t count;
+
+
+	inline TriangleSpan2() : ax( NULL ), ay( NULL ), bx( NULL ), by( NULL ), cx( NULL ), cy( NULL ), count( 0 )
+	{
+	}
+
+	inline TriangleSpan2(const Real *iax, const Real *iay, const Real *ibx, const Real *iby, const Real *icx, const Real *icy, size_t icount)
+		: ax( iax ), ay( iay ), bx( ibx ), by( iby ), cx( icx ), cy( icy ), count( icount )
+	{
+	}
+
+
+	/**
+	Triangle \a i as a Triangle2
+	*/
+	inline Triangle2<Real> get(size_t i) const
+	{
+		return Triangle2<Real>( Point2<Real>( ax[i], ay[i] ), Point2<Real>( bx[i], by[i] ), Point2<Real>( cx[i], cy[i] ) );
+	}
+};
+
+
+
+/**
+GeometryBatch - one segment or point tested against a whole span of segments or triangles
+
+Each query gives the answer of looping the single-pair template over the span:
+
+	nearestIntersection:	Segment2::intersect, the hit with the smallest t
+	nearestSegment:			Segment2::closestParamAndPointTo, the smallest squared distance
+	firstContaining:		Triangle2::contains, the first triangle that does
+
+Ties go to the lower index, and the arithmetic is done in the same order as the templates,
+so the batch and the loop agree exactly. Four elements at a time go through SimdVec4 (see
+Matrix4SIMD.h), the rest through the templates. Lanes count indices in Reals, so a float
+span can be up to 2^24 long.
+*/
+template <typename Real> class GeometryBatch
+{
+public:
+	/**
+	The segment in \a segments that \a line hits nearest its start (\a line.a)
+
+	\param index - which segment
+	\param t - how far along \a line, as Segment2::intersect
+	\param intersection - where
+	\return false if \a line hits none of them
+	*/
+	inline static bool nearestIntersection(const Segment2<Real> &line, const SegmentSpan2<Real> &segments, size_t &index, Real &t, Point2<Real> &intersection)
+	{
+		//t is at most 1 for a hit
+		Real bestT = (Real)2.0;
+		size_t best = segments.count;
+		size_t i = 0;
+
+#ifdef MATH_SIMD_SSE2
+		typedef SimdVec4<Real> V;
+		if ( segments.count >= 4 )
+		{
+			Vector2<Real> dir = line.getDirection();
+			V lax = V::splat( &line.a.x ), lay = V::splat( &line.a.y );
+			V dx = V::splat( &dir.x ), dy = V::splat( &dir.y );
+			V zero = V::set( 0, 0, 0, 0 ), one = V::set( 1, 1, 1, 1 ), four = V::set( 4, 4, 4, 4 );
+			Real none = (Real)segments.count;
+			V laneBestT = V::splat( &bestT ), laneBest = V::splat( &none ), indices = V::set( 0, 1, 2, 3 );
+
+			for (; i + 4 <= segments.count; i += 4)
+			{
+				V ax = V::load( segments.ax + i ), ay = V::load( segments.ay + i );
+				V bx = V::load( segments.bx + i ), by = V::load( segments.by + i );
+				V sdx = bx - ax, sdy = by - ay;
+				V nx = zero - sdy;
+
+				V nDotDirection = nx * dx  +  sdx * dy;
+				V d = ax * nx  +  ay * sdx;
+				V lt = ( d  -  ( lax * nx  +  lay * sdx ) )  /  nDotDirection;
+				V ix = lax  +  dx * lt, iy = lay  +  dy * lt;
+
+				//seg.boundsContain( intersection )
+				V pAlong = ix * sdx  +  iy * sdy;
+				V aAlong = ax * sdx  +  ay * sdy;
+				V bAlong = bx * sdx  +  by * sdy;
+				V inBounds = ( V::lessEqual( aAlong, pAlong ) & V::lessEqual( pAlong, bAlong ) )  |
+							 ( V::lessEqual( bAlong, pAlong ) & V::lessEqual( pAlong, aAlong ) );
+
+				V hit = V::notEqual( nDotDirection, zero ) & V::lessEqual( zero, lt ) & V::lessEqual( lt, one ) & inBounds;
+				V better = hit & V::lessThan( lt, laneBestT );
+				laneBestT = V::select( better, lt, laneBestT );
+				laneBest = V::select( better, indices, laneBest );
+				indices = indices + four;
+			}
+
+			reduce( laneBestT, laneBest, bestT, best );
+		}
+#endif
+
+		for (; i < segments.count; i++)
+		{
+			Real ti;
+			Point2<Real> p;
+			if ( line.intersect( segments.get( i ), ti, p )  &&  ti < bestT )
+			{
+				bestT = ti;
+				best = i;
+			}
+		}
+
+		if ( best == segments.count )
+		{
+			return false;
+		}
+		//the winner again, one at a time, for its intersection point
+		index = best;
+		line.intersect( segments.get( best ), t, intersection );
+		return true;
+	}
+
+	/**
+	The segment in \a segments nearest to \a p
+
+	\param index - which segment
+	\param t - where along it, as Segment2::closestParamAndPointTo
+	\param closest - the point on it nearest \a p
+	\return false if \a segments is empty (or every segment has zero length)
+	*/
+	inline static bool nearestSegment(const Point2<Real> &p, const SegmentSpan2<Real> &segments, size_t &index, Real &t, Point2<Real> &closest)
+	{
+		Real bestDistance = std::numeric_limits<Real>::infinity();
+		size_t best = segments.count;
+		size_t i = 0;
+
+#ifdef MATH_SIMD_SSE2
+		typedef SimdVec4<Real> V;
+		if ( segments.count >= 4 )
+		{
+			V px = V::splat( &p.x ), py = V::splat( &p.y );
+			V zero = V::set( 0, 0, 0, 0 ), one = V::set( 1, 1, 1, 1 ), four = V::set( 4, 4, 4, 4 );
+			Real none = (Real)segments.count;
+			V laneBestDistance = V::splat( &bestDistance ), laneBest = V::splat( &none ), indices = V::set( 0, 1, 2, 3 );
+
+			for (; i + 4 <= segments.count; i += 4)
+			{
+				V ax = V::load( segments.ax + i ), ay = V::load( segments.ay + i );
+				V abx = V::load( segments.bx + i ) - ax, aby = V::load( segments.by + i ) - ay;
+				V apx = px - ax, apy = py - ay;
+
+				//clamp( t, 0, 1 ) is min( max( t, 0 ), 1 ): NaN (a zero length segment) stays NaN
+				V st = ( apx * abx  +  apy * aby )  /  ( abx * abx  +  aby * aby );
+				st = V::minimum( one, V::maximum( zero, st ) );
+				V ex = px - ( ax  +  abx * st ), ey = py - ( ay  +  aby * st );
+				V distance = ex * ex  +  ey * ey;
+
+				V better = V::lessThan( distance, laneBestDistance );
+				laneBestDistance = V::select( better, distance, laneBestDistance );
+				laneBest = V::select( better, indices, laneBest );
+				indices = indices + four;
+			}
+
+			reduce( laneBestDistance, laneBest, bestDistance, best );
+		}
+#endif
+
+		for (; i < segments.count; i++)
+		{
+			Real ti;
+			Real distance = p.sqrDistanceTo( segments.get( i ).closestParamAndPointTo( p, ti ) );
+			if ( distance < bestDistance )
+			{
+				bestDistance = distance;
+				best = i;
+			}
+		}
+
+		if ( best == segments.count )
+		{
+			return false;
+		}
+		index = best;
+		closest = segments.get( best ).closestParamAndPointTo( p, t );
+		return true;
+	}
+
+	/**
+	The first triangle in \a triangles that contains \a p (edges included)
+
+	\return false if none do
+	*/
+	inline static bool firstContaining(const Point2<Real> &p, const TriangleSpan2<Real> &triangles, size_t &index)
+	{
+		size_t i = 0;
+
+#ifdef MATH_SIMD_SSE2
+		typedef SimdVec4<Real> V;
+		V px = V::splat( &p.x ), py = V::splat( &p.y );
+		V zero = V::set( 0, 0, 0, 0 );
+		for (; i + 4 <= triangles.count; i += 4)
+		{
+			V ax = V::load( triangles.ax + i ), ay = V::load( triangles.ay + i );
+			V bx = V::load( triangles.bx + i ), by = V::load( triangles.by + i );
+			V cx = V::load( triangles.cx + i ), cy = V::load( triangles.cy + i );
+
+			//Point2::areaOfTriangleTimes2 of the corners, and of each edge with p
+			V area = ( bx - ax ) * ( cy - ay )  -  ( by - ay ) * ( cx - ax );
+			V e0 = ( bx - ax ) * ( py - ay )  -  ( by - ay ) * ( px - ax );
+			V e1 = ( cx - bx ) * ( py - by )  -  ( cy - by ) * ( px - bx );
+			V e2 = ( ax - cx ) * ( py - cy )  -  ( ay - cy ) * ( px - cx );
+
+			V onOrLeft = V::lessEqual( zero, e0 ) & V::lessEqual( zero, e1 ) & V::lessEqual( zero, e2 );
+			V onOrRight = V::lessEqual( e0, zero ) & V::lessEqual( e1, zero ) & V::lessEqual( e2, zero );
+			int inside = V::select( V::lessThan( zero, area ), onOrLeft, onOrRight ).bits();
+			if ( inside != 0 )
+			{
+				index = i;
+				while ( ( inside & 1 ) == 0 )
+				{
+					inside >>= 1;
+					index++;
+				}
+				return true;
+			}
+		}
+#endif
+
+		for (; i < triangles.count; i++)
+		{
+			if ( triangles.get( i ).contains( p ) )
+			{
+				index = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+
+private:
+#ifdef MATH_SIMD_SSE2
+	//the smallest of four lanes' best values into best, ties to the lower index
+	//(a lane that found nothing still has the starting value and index count)
+	inline static void reduce(const SimdVec4<Real> &laneValues, const SimdVec4<Real> &laneIndices, Real &bestValue, size_t &best)
+	{
+		Real values[4], indices[4];
+		laneValues.store( values );
+		laneIndices.store( indices );
+		for (int lane = 0; lane < 4; lane++)
+		{
+			size_t index = (size_t)indices[lane];
+			if ( values[lane] < bestValue  ||  ( values[lane] == bestValue  &&  index < best ) )
+			{
+				bestValue = values[lane];
+				best = index;
+			}
+		}
+	}
+#endif
+};
+
+
+#endif
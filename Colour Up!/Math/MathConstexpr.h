@@ -0,0 +1,23 @@
+#ifndef MATHCONSTEXPR_H__
+#define MATHCONSTEXPR_H__
+
+
+/**
+MATH_CONSTEXPR - constexpr, where the compiler has it
+
+The value types (Vector2, Point2, Vector3, Point3, Point4) mark their constructors and
+their single-expression const operations with it, so points, vectors and tables of them
+can be built at compile time. Visual Studio 2013 has no constexpr: there it expands to
+nothing, MATH_HAS_CONSTEXPR is left undefined and the same code is built at run time.
+Anything that needs a constant expression (a static_assert, a constexpr variable) goes
+inside #ifdef MATH_HAS_CONSTEXPR.
+*/
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define MATH_CONSTEXPR
+#else
+#define MATH_CONSTEXPR constexpr
+#define MATH_HAS_CONSTEXPR
+#endif
+
+
+#endif
@@ -65,11 +65,11 @@ Members of matrix M can be accessed by:
 
 	OR:
 
-	M.iM00, M.iM01, M.iM02, M.IM03
+	M.iM00, M.iM01, M.iM02, M.iM03
 
-	M.iM10, M.iM11, M.iM12, M.IM13
+	M.iM10, M.iM11, M.iM12, M.iM13
 
-	M.iM20, M.iM21, M.iM22, M.IM23
+	M.iM20, M.iM21, M.iM22, M.iM23
 
 	M.iM30, M.iM31, M.iM32, M.IM33
 
@@ -179,7 +179,7 @@ public:
 	{
 		iM00 = i.x;				iM01 = j.x;				iM02 = k.x;				iM03 = translation.x;
 		iM10 = i.y;				iM11 = j.y;				iM12 = k.y;				iM13 = translation.y;
-		iM20 = i.z;				iM21 = j.z;				iM22 = k.z;				iM23 = translation.z
+		iM20 = i.z;				iM21 = j.z;				iM22 = k.z;				iM23 = translation.z;
 		iM30 = (Real)0.0;		iM31 = (Real)0.0;		iM32 = (Real)0.0;		iM33 = (Real)1.0;
 	}
 
@@ -204,7 +204,7 @@ public:
 	{
 		iM00 = i.x;				iM01 = j.x;				iM02 = k.x;				iM03 = o.x;
 		iM10 = i.y;				iM11 = j.y;				iM12 = k.y;				iM13 = o.y;
-		iM20 = i.z;				iM21 = j.z;				iM22 = k.z;				iM23 = o.z
+		iM20 = i.z;				iM21 = j.z;				iM22 = k.z;				iM23 = o.z;
 		iM30 = (Real)0.0;		iM31 = (Real)0.0;		iM32 = (Real)0.0;		iM33 = (Real)1.0;
 	}
 
@@ -238,7 +238,7 @@ public:
 		Vector3<Real> k = ok - o;
 		iM00 = i.x;				iM01 = j.x;				iM02 = k.x;				iM03 = o.x;
 		iM10 = i.y;				iM11 = j.y;				iM12 = k.y;				iM13 = o.y;
-		iM20 = i.z;				iM21 = j.z;				iM22 = k.z;				iM23 = o.z
+		iM20 = i.z;				iM21 = j.z;				iM22 = k.z;				iM23 = o.z;
 		iM30 = (Real)0.0;		iM31 = (Real)0.0;		iM32 = (Real)0.0;		iM33 = (Real)1.0;
 	}
 
@@ -384,6 +384,18 @@ public:
 
 
 
+	/**
+	Copy constructor - declared with the assignment operator, so a copy doesn't
+	lean on the implicit one (deprecated next to a user-declared operator=)
+	*/
+	inline Matrix4(const Matrix4<Real> &m)
+	{
+		iM00 = m.iM00;	iM01 = m.iM01;	iM02 = m.iM02;	iM03 = m.iM03;
+		iM10 = m.iM10;	iM11 = m.iM11;	iM12 = m.iM12;	iM13 = m.iM13;
+		iM20 = m.iM20;	iM21 = m.iM21;	iM22 = m.iM22;	iM23 = m.iM23;
+		iM30 = m.iM30;	iM31 = m.iM31;	iM32 = m.iM32;	iM33 = m.iM33;
+	}
+
 	/**
 	Assignment operator
 	*/
@@ -541,12 +553,23 @@ public:
 	*/
 	inline Matrix4<Real> rigidBodyInverse() const
 	{
-		return Matrix4<Real>( iM00,			iM10,		iM20,		-IM03 * iM00  +  -IM13 * iM10  +  -IM23 * iM20,
-							  iM01,			iM11,		iM21,		-IM03 * iM01  +  -IM13 * iM11  +  -IM23 * iM21,
-							  iM02,			iM12,		iM22,		-IM03 * iM02  +  -IM13 * iM12  +  -IM23 * iM22,
+		return Matrix4<Real>( iM00,			iM10,		iM20,		-iM03 * iM00  +  -iM13 * iM10  +  -iM23 * iM20,
+							  iM01,			iM11,		iM21,		-iM03 * iM01  +  -iM13 * iM11  +  -iM23 * iM21,
+							  iM02,			iM12,		iM22,		-iM03 * iM02  +  -iM13 * iM12  +  -iM23 * iM22,
 							  (Real)0.0,	(Real)0.0,	(Real)0.0,	(Real)1.0 );
 	}
 
+	/**
+	Compute the transpose: M^T
+	*/
+	inline Matrix4<Real> transpose() const
+	{
+		return Matrix4<Real>( iM00,	iM10,	iM20,	iM30,
+							  iM01,	iM11,	iM21,	iM31,
+							  iM02,	iM12,	iM22,	iM32,
+							  iM03,	iM13,	iM23,	iM33 );
+	}
+
 
 	/**
 	Weighted average of two matrices \a a and \a b, with weights \a wa and \a wb:  a * wa  +  b * wb
@@ -1842,7 +1865,7 @@ public:
 
 		if ( right.sqrLength() < SQR_EPSILON )
 		{
-			right = Vector3( 1.0, 0.0, 0.0 );
+			right = Vector3<Real>( 1.0, 0.0, 0.0 );
 		}
 
 		Vector3<Real> realUp = right.cross( lookDirection );
@@ -1866,7 +1889,7 @@ public:
 
 		if ( right.sqrLength() < SQR_EPSILON )
 		{
-			right = Vector3( 1.0, 0.0, 0.0 );
+			right = Vector3<Real>( 1.0, 0.0, 0.0 );
 		}
 
 		Vector3<Real> realUp = right.cross( lookDirection );
@@ -0,0 +1,625 @@
+#ifndef MATRIX4SIMD_H__
+#define MATRIX4SIMD_H__
+
+#include <stddef.h>
+
+#include <Math/Matrix4.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(MATH_SIMD_SSE2) && defined(__AVX2__)
+#define MATH_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+
+/**
+Matrix4Scalar - reference versions of the Matrix4 operations accelerated by Matrix4SIMD
+
+They are the plain Matrix4 template operators, one element at a time; Matrix4SIMD
+falls back to them where there is no vector unit to use, and colourup_bench --check
+compares the two.
+*/
+template <typename Real> class Matrix4Scalar
+{
+public:
+	/**
+	Name of the instruction set used
+	*/
+	inline static const char * isa()
+	{
+		return "scalar";
+	}
+
+	/**
+	Multiplication/concatenation: A * B
+	*/
+	inline static Matrix4<Real> multiply(const Matrix4<Real> &a, const Matrix4<Real> &b)
+	{
+		return a * b;
+	}
+
+	/**
+	Inverse: M^-1
+	*/
+	inline static Matrix4<Real> inverse(const Matrix4<Real> &m)
+	{
+		return m.inverse();
+	}
+
+	/**
+	Transpose: M^T
+	*/
+	inline static Matrix4<Real> transpose(const Matrix4<Real> &m)
+	{
+		return m.transpose();
+	}
+
+	/**
+	Apply \a m to \a count points from \a in, writing them to \a out (which may be \a in)
+	*/
+	inline static void transformPoints(const Matrix4<Real> &m, const Point3<Real> *in, Point3<Real> *out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			out[i] = m * in[i];
+		}
+	}
+
+	/**
+	Apply \a m to \a count vectors from \a in, writing them to \a out (which may be \a in)
+
+	NOTE: translations are *NOT* applied to vectors
+	*/
+	inline static void transformVectors(const Matrix4<Real> &m, const Vector3<Real> *in, Vector3<Real> *out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			out[i] = m * in[i];
+		}
+	}
+};
+
+
+
+#ifdef MATH_SIMD_SSE2
+
+/**
+SimdVec4 - four Reals in vector registers, just the operations the Matrix4SIMD kernels need
+
+swizzle<X,Y,Z,W>(a) is [a[X], a[Y], a[Z], a[W]], shuffle2<X,Y,Z,W>(a, b) is [a[X], a[Y], b[Z], b[W]].
+Everything is passed by reference: 32 bit MSVC can't pass aligned types by value.
+*/
+template <typename Real> struct SimdVec4;
+
+
+template <> struct SimdVec4<float>
+{
+	__m128 v;
+
+	inline static SimdVec4 make(__m128 x)
+	{
+		SimdVec4 r;
+		r.v = x;
+		return r;
+	}
+
+	inline static SimdVec4 load(const float *p)
+	{
+		return make( _mm_loadu_ps( p ) );
+	}
+
+	inline static SimdVec4 splat(const float *p)
+	{
+		return make( _mm_set1_ps( *p ) );
+	}
+
+	inline static SimdVec4 set(float x, float y, float z, float w)
+	{
+		return make( _mm_setr_ps( x, y, z, w ) );
+	}
+
+	inline void store(float *p) const
+	{
+		_mm_storeu_ps( p, v );
+	}
+
+	//x, y and z only
+	inline void store3(float *p) const
+	{
+		_mm_storel_pi( (__m64*)p, v );
+		_mm_store_ss( p + 2, _mm_movehl_ps( v, v ) );
+	}
+
+	template <int X, int Y, int Z, int W> inline static SimdVec4 swizzle(const SimdVec4 &a)
+	{
+		return make( _mm_shuffle_ps( a.v, a.v, _MM_SHUFFLE( W, Z, Y, X ) ) );
+	}
+
+	template <int X, int Y, int Z, int W> inline static SimdVec4 shuffle2(const SimdVec4 &a, const SimdVec4 &b)
+	{
+		return make( _mm_shuffle_ps( a.v, b.v, _MM_SHUFFLE( W, Z, Y, X ) ) );
+	}
+
+	inline SimdVec4 operator+(const SimdVec4 &b) const		{ return make( _mm_add_ps( v, b.v ) ); }
+	inline SimdVec4 operator-(const SimdVec4 &b) const		{ return make( _mm_sub_ps( v, b.v ) ); }
+	inline SimdVec4 operator*(const SimdVec4 &b) const		{ return make( _mm_mul_ps( v, b.v ) ); }
+	inline SimdVec4 operator/(const SimdVec4 &b) const		{ return make( _mm_div_ps( v, b.v ) ); }
+
+	//comparisons give all-ones lanes where true, for &, | and select()
+	inline static SimdVec4 lessThan(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_cmplt_ps( a.v, b.v ) ); }
+	inline static SimdVec4 lessEqual(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_cmple_ps( a.v, b.v ) ); }
+	inline static SimdVec4 notEqual(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_cmpneq_ps( a.v, b.v ) ); }
+	inline SimdVec4 operator&(const SimdVec4 &b) const		{ return make( _mm_and_ps( v, b.v ) ); }
+	inline SimdVec4 operator|(const SimdVec4 &b) const		{ return make( _mm_or_ps( v, b.v ) ); }
+
+	//mask ? a : b, lane by lane
+	inline static SimdVec4 select(const SimdVec4 &mask, const SimdVec4 &a, const SimdVec4 &b)
+	{
+		return make( _mm_or_ps( _mm_and_ps( mask.v, a.v ), _mm_andnot_ps( mask.v, b.v ) ) );
+	}
+
+	//(a > b) ? a : b and (a < b) ? a : b, so b when either is NaN (as the instructions do)
+	inline static SimdVec4 maximum(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_max_ps( a.v, b.v ) ); }
+	inline static SimdVec4 minimum(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_min_ps( a.v, b.v ) ); }
+
+	//bit i set if lane i of a mask is
+	inline int bits() const
+	{
+		return _mm_movemask_ps( v );
+	}
+};
+
+
+#ifdef MATH_SIMD_AVX2
+
+template <> struct SimdVec4<double>
+{
+	__m256d v;
+
+	inline static SimdVec4 make(__m256d x)
+	{
+		SimdVec4 r;
+		r.v = x;
+		return r;
+	}
+
+	inline static SimdVec4 load(const double *p)
+	{
+		return make( _mm256_loadu_pd( p ) );
+	}
+
+	inline static SimdVec4 splat(const double *p)
+	{
+		return make( _mm256_broadcast_sd( p ) );
+	}
+
+	inline static SimdVec4 set(double x, double y, double z, double w)
+	{
+		return make( _mm256_setr_pd( x, y, z, w ) );
+	}
+
+	inline void store(double *p) const
+	{
+		_mm256_storeu_pd( p, v );
+	}
+
+	//x, y and z only
+	inline void store3(double *p) const
+	{
+		_mm_storeu_pd( p, _mm256_castpd256_pd128( v ) );
+		_mm_store_sd( p + 2, _mm256_extractf128_pd( v, 1 ) );
+	}
+
+	template <int X, int Y, int Z, int W> inline static SimdVec4 swizzle(const SimdVec4 &a)
+	{
+		return make( _mm256_permute4x64_pd( a.v, _MM_SHUFFLE( W, Z, Y, X ) ) );
+	}
+
+	template <int X, int Y, int Z, int W> inline static SimdVec4 shuffle2(const SimdVec4 &a, const SimdVec4 &b)
+	{
+		return make( _mm256_blend_pd( _mm256_permute4x64_pd( a.v, _MM_SHUFFLE( W, Z, Y, X ) ),
+									  _mm256_permute4x64_pd( b.v, _MM_SHUFFLE( W, Z, Y, X ) ), 0xC ) );
+	}
+
+	inline SimdVec4 operator+(const SimdVec4 &b) const		{ return make( _mm256_add_pd( v, b.v ) ); }
+	inline SimdVec4 operator-(const SimdVec4 &b) const		{ return make( _mm256_sub_pd( v, b.v ) ); }
+	inline SimdVec4 operator*(const SimdVec4 &b) const		{ return make( _mm256_mul_pd( v, b.v ) ); }
+	inline SimdVec4 operator/(const SimdVec4 &b) const		{ return make( _mm256_div_pd( v, b.v ) ); }
+
+	inline static SimdVec4 lessThan(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm256_cmp_pd( a.v, b.v, _CMP_LT_OQ ) ); }
+	inline static SimdVec4 lessEqual(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm256_cmp_pd( a.v, b.v, _CMP_LE_OQ ) ); }
+	inline static SimdVec4 notEqual(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm256_cmp_pd( a.v, b.v, _CMP_NEQ_UQ ) ); }
+	inline SimdVec4 operator&(const SimdVec4 &b) const		{ return make( _mm256_and_pd( v, b.v ) ); }
+	inline SimdVec4 operator|(const SimdVec4 &b) const		{ return make( _mm256_or_pd( v, b.v ) ); }
+
+	inline static SimdVec4 select(const SimdVec4 &mask, const SimdVec4 &a, const SimdVec4 &b)
+	{
+		return make( _mm256_blendv_pd( b.v, a.v, mask.v ) );
+	}
+
+	inline static SimdVec4 maximum(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm256_max_pd( a.v, b.v ) ); }
+	inline static SimdVec4 minimum(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm256_min_pd( a.v, b.v ) ); }
+
+	inline int bits() const
+	{
+		return _mm256_movemask_pd( v );
+	}
+};
+
+#else
+
+//SSE2 only: two registers of two doubles
+template <> struct SimdVec4<double>
+{
+	__m128d lo, hi;
+
+	inline static SimdVec4 make(__m128d l, __m128d h)
+	{
+		SimdVec4 r;
+		r.lo = l;
+		r.hi = h;
+		return r;
+	}
+
+	inline static SimdVec4 load(const double *p)
+	{
+		return make( _mm_loadu_pd( p ), _mm_loadu_pd( p + 2 ) );
+	}
+
+	inline static SimdVec4 splat(const double *p)
+	{
+		__m128d x = _mm_load1_pd( p );
+		return make( x, x );
+	}
+
+	inline static SimdVec4 set(double x, double y, double z, double w)
+	{
+		return make( _mm_setr_pd( x, y ), _mm_setr_pd( z, w ) );
+	}
+
+	inline void store(double *p) const
+	{
+		_mm_storeu_pd( p, lo );
+		_mm_storeu_pd( p + 2, hi );
+	}
+
+	//x, y and z only
+	inline void store3(double *p) const
+	{
+		_mm_storeu_pd( p, lo );
+		_mm_store_sd( p + 2, hi );
+	}
+
+	//the register holding element I
+	template <int I> inline const __m128d & half() const
+	{
+		return ( I < 2 )  ?  lo  :  hi;
+	}
+
+	template <int X, int Y, int Z, int W> inline static SimdVec4 swizzle(const SimdVec4 &a)
+	{
+		return shuffle2<X, Y, Z, W>( a, a );
+	}
+
+	template <int X, int Y, int Z, int W> inline static SimdVec4 shuffle2(const SimdVec4 &a, const SimdVec4 &b)
+	{
+		return make( _mm_shuffle_pd( a.template half<X>(), a.template half<Y>(), ( X & 1 ) | ( ( Y & 1 ) << 1 ) ),
+					 _mm_shuffle_pd( b.template half<Z>(), b.template half<W>(), ( Z & 1 ) | ( ( W & 1 ) << 1 ) ) );
+	}
+
+	inline SimdVec4 operator+(const SimdVec4 &b) const		{ return make( _mm_add_pd( lo, b.lo ), _mm_add_pd( hi, b.hi ) ); }
+	inline SimdVec4 operator-(const SimdVec4 &b) const		{ return make( _mm_sub_pd( lo, b.lo ), _mm_sub_pd( hi, b.hi ) ); }
+	inline SimdVec4 operator*(const SimdVec4 &b) const		{ return make( _mm_mul_pd( lo, b.lo ), _mm_mul_pd( hi, b.hi ) ); }
+	inline SimdVec4 operator/(const SimdVec4 &b) const		{ return make( _mm_div_pd( lo, b.lo ), _mm_div_pd( hi, b.hi ) ); }
+
+	inline static SimdVec4 lessThan(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_cmplt_pd( a.lo, b.lo ), _mm_cmplt_pd( a.hi, b.hi ) ); }
+	inline static SimdVec4 lessEqual(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_cmple_pd( a.lo, b.lo ), _mm_cmple_pd( a.hi, b.hi ) ); }
+	inline static SimdVec4 notEqual(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_cmpneq_pd( a.lo, b.lo ), _mm_cmpneq_pd( a.hi, b.hi ) ); }
+	inline SimdVec4 operator&(const SimdVec4 &b) const		{ return make( _mm_and_pd( lo, b.lo ), _mm_and_pd( hi, b.hi ) ); }
+	inline SimdVec4 operator|(const SimdVec4 &b) const		{ return make( _mm_or_pd( lo, b.lo ), _mm_or_pd( hi, b.hi ) ); }
+
+	inline static SimdVec4 select(const SimdVec4 &mask, const SimdVec4 &a, const SimdVec4 &b)
+	{
+		return make( _mm_or_pd( _mm_and_pd( mask.lo, a.lo ), _mm_andnot_pd( mask.lo, b.lo ) ),
+					 _mm_or_pd( _mm_and_pd( mask.hi, a.hi ), _mm_andnot_pd( mask.hi, b.hi ) ) );
+	}
+
+	inline static SimdVec4 maximum(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_max_pd( a.lo, b.lo ), _mm_max_pd( a.hi, b.hi ) ); }
+	inline static SimdVec4 minimum(const SimdVec4 &a, const SimdVec4 &b)		{ return make( _mm_min_pd( a.lo, b.lo ), _mm_min_pd( a.hi, b.hi ) ); }
+
+	inline int bits() const
+	{
+		return _mm_movemask_pd( lo )  |  ( _mm_movemask_pd( hi ) << 2 );
+	}
+};
+
+#endif
+
+
+
+/**
+SimdInterleave - four packed Point2s/Point3s to and from one SimdVec4 per co-ordinate
+
+load2/store2 work on 8 consecutive Reals ([x0 y0 x1 y1] [x2 y2 x3 y3]), load3/store3 on 12.
+*/
+template <typename Real> struct SimdInterleave
+{
+	typedef SimdVec4<Real> V;
+
+	inline static void load2(const Real *p, V &x, V &y)
+	{
+		V v0 = V::load( p ), v1 = V::load( p + 4 );
+		x = V::template shuffle2<0, 2, 0, 2>( v0, v1 );
+		y = V::template shuffle2<1, 3, 1, 3>( v0, v1 );
+	}
+
+	inline static void store2(Real *p, const V &x, const V &y)
+	{
+		V::template swizzle<0, 2, 1, 3>( V::template shuffle2<0, 1, 0, 1>( x, y ) ).store( p );
+		V::template swizzle<0, 2, 1, 3>( V::template shuffle2<2, 3, 2, 3>( x, y ) ).store( p + 4 );
+	}
+
+	//[x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] to [x0 x1 x2 x3] [y0 y1 y2 y3] [z0 z1 z2 z3]
+	inline static void load3(const Real *p, V &x, V &y, V &z)
+	{
+		V v0 = V::load( p ), v1 = V::load( p + 4 ), v2 = V::load( p + 8 );
+		x = V::template shuffle2<0, 3, 0, 3>( v0, V::template shuffle2<2, 3, 0, 1>( v1, v2 ) );
+		y = V::template shuffle2<0, 2, 0, 2>( V::template shuffle2<1, 1, 0, 0>( v0, v1 ), V::template shuffle2<3, 3, 2, 2>( v1, v2 ) );
+		z = V::template shuffle2<0, 2, 0, 3>( V::template shuffle2<2, 2, 1, 1>( v0, v1 ), v2 );
+	}
+
+	//and back again
+	inline static void store3(Real *p, const V &x, const V &y, const V &z)
+	{
+		V::template shuffle2<0, 2, 0, 2>( V::template shuffle2<0, 0, 0, 0>( x, y ), V::template shuffle2<0, 0, 1, 1>( z, x ) ).store( p );
+		V::template shuffle2<0, 2, 0, 2>( V::template shuffle2<1, 1, 1, 1>( y, z ), V::template shuffle2<2, 2, 2, 2>( x, y ) ).store( p + 4 );
+		V::template shuffle2<0, 2, 0, 2>( V::template shuffle2<2, 2, 3, 3>( z, x ), V::template shuffle2<3, 3, 3, 3>( y, z ) ).store( p + 8 );
+	}
+};
+
+
+
+/**
+Matrix4SIMDKernels - the Matrix4SIMD operations, written once over SimdVec4
+
+A column of the matrix (4 consecutive elements of Matrix4::d) is one SimdVec4.
+
+multiply() and the transforms add their products in the same order as the
+scalar operators, so without fused multiply-add they give bit-identical results.
+inverse() is the 2x2 block method rather than cofactors, so it agrees with
+Matrix4::inverse() to rounding, not to the bit.
+*/
+template <typename Real> class Matrix4SIMDKernels
+{
+	typedef SimdVec4<Real> V;
+
+public:
+	inline static Matrix4<Real> multiply(const Matrix4<Real> &a, const Matrix4<Real> &b)
+	{
+		V a0 = V::load( a.d ), a1 = V::load( a.d + 4 ), a2 = V::load( a.d + 8 ), a3 = V::load( a.d + 12 );
+		Matrix4<Real> r;
+		for (int j = 0; j < 16; j += 4)
+		{
+			const Real *bj = b.d + j;
+			V c = a0 * V::splat( bj )  +  a1 * V::splat( bj + 1 )  +  a2 * V::splat( bj + 2 )  +  a3 * V::splat( bj + 3 );
+			c.store( r.d + j );
+		}
+		return r;
+	}
+
+	inline static Matrix4<Real> transpose(const Matrix4<Real> &m)
+	{
+		V c0 = V::load( m.d ), c1 = V::load( m.d + 4 ), c2 = V::load( m.d + 8 ), c3 = V::load( m.d + 12 );
+		V t0 = V::template shuffle2<0, 1, 0, 1>( c0, c1 );
+		V t1 = V::template shuffle2<2, 3, 2, 3>( c0, c1 );
+		V t2 = V::template shuffle2<0, 1, 0, 1>( c2, c3 );
+		V t3 = V::template shuffle2<2, 3, 2, 3>( c2, c3 );
+		Matrix4<Real> r;
+		V::template shuffle2<0, 2, 0, 2>( t0, t2 ).store( r.d );
+		V::template shuffle2<1, 3, 1, 3>( t0, t2 ).store( r.d + 4 );
+		V::template shuffle2<0, 2, 0, 2>( t1, t3 ).store( r.d + 8 );
+		V::template shuffle2<1, 3, 1, 3>( t1, t3 ).store( r.d + 12 );
+		return r;
+	}
+
+	/**
+	Block inverse: M = [A B; C D] with 2x2 blocks, each held (row by row) in one SimdVec4.
+	It is written for rows, but inverting the transpose and writing the result back the
+	same way round is the same thing, so the columns go in as they are.
+	*/
+	inline static Matrix4<Real> inverse(const Matrix4<Real> &m)
+	{
+		V r0 = V::load( m.d ), r1 = V::load( m.d + 4 ), r2 = V::load( m.d + 8 ), r3 = V::load( m.d + 12 );
+
+		V a = V::template shuffle2<0, 1, 0, 1>( r0, r1 );
+		V b = V::template shuffle2<2, 3, 2, 3>( r0, r1 );
+		V c = V::template shuffle2<0, 1, 0, 1>( r2, r3 );
+		V d = V::template shuffle2<2, 3, 2, 3>( r2, r3 );
+
+		//determinants of the blocks, [|A| |B| |C| |D|]
+		V detSub = V::template shuffle2<0, 2, 0, 2>( r0, r2 ) * V::template shuffle2<1, 3, 1, 3>( r1, r3 )  -
+				   V::template shuffle2<1, 3, 1, 3>( r0, r2 ) * V::template shuffle2<0, 2, 0, 2>( r1, r3 );
+		V detA = V::template swizzle<0, 0, 0, 0>( detSub );
+		V detB = V::template swizzle<1, 1, 1, 1>( detSub );
+		V detC = V::template swizzle<2, 2, 2, 2>( detSub );
+		V detD = V::template swizzle<3, 3, 3, 3>( detSub );
+
+		//adj(D)C and adj(A)B
+		V dc = adjMul( d, c );
+		V ab = adjMul( a, b );
+		//adjugates of the inverse's blocks, up to the 1/|M| factor
+		V x = detD * a  -  mul( b, dc );
+		V w = detA * d  -  mul( c, ab );
+		V y = detB * c  -  mulAdj( d, ab );
+		V z = detC * b  -  mulAdj( a, dc );
+
+		//|M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		V tr = ab * V::template swizzle<0, 2, 1, 3>( dc );
+		tr = tr  +  V::template swizzle<2, 3, 0, 1>( tr );
+		tr = tr  +  V::template swizzle<1, 0, 3, 2>( tr );
+		V detM = detA * detD  +  detB * detC  -  tr;
+
+		V rDetM = V::set( (Real)1.0, (Real)-1.0, (Real)-1.0, (Real)1.0 )  /  detM;
+		x = x * rDetM;
+		y = y * rDetM;
+		z = z * rDetM;
+		w = w * rDetM;
+
+		//undo the adjugates while putting the blocks back together
+		Matrix4<Real> r;
+		V::template shuffle2<3, 1, 3, 1>( x, y ).store( r.d );
+		V::template shuffle2<2, 0, 2, 0>( x, y ).store( r.d + 4 );
+		V::template shuffle2<3, 1, 3, 1>( z, w ).store( r.d + 8 );
+		V::template shuffle2<2, 0, 2, 0>( z, w ).store( r.d + 12 );
+		return r;
+	}
+
+	/**
+	Four points at a time: their twelve co-ordinates are loaded as three SimdVec4s, turned into
+	x, y and z of all four, transformed a row at a time and turned back. The odd ones at the end
+	are done one by one.
+	*/
+	inline static void transformPoints(const Matrix4<Real> &m, const Point3<Real> *in, Point3<Real> *out, size_t count)
+	{
+		static_assert( sizeof( Point3<Real> ) == 3 * sizeof( Real ), "Point3 has to be three packed Reals" );
+		const Real *src = in[0].v;
+		Real *dst = out[0].v;
+		Rows rows( m );
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			V x, y, z;
+			SimdInterleave<Real>::load3( src + i * 3, x, y, z );
+			SimdInterleave<Real>::store3( dst + i * 3,
+					  x * rows.m00  +  y * rows.m01  +  z * rows.m02  +  rows.m03,
+					  x * rows.m10  +  y * rows.m11  +  z * rows.m12  +  rows.m13,
+					  x * rows.m20  +  y * rows.m21  +  z * rows.m22  +  rows.m23 );
+		}
+
+		V c0 = V::load( m.d ), c1 = V::load( m.d + 4 ), c2 = V::load( m.d + 8 ), c3 = V::load( m.d + 12 );
+		for (; i < count; i++)
+		{
+			const Point3<Real> &p = in[i];
+			V r = c0 * V::splat( &p.x )  +  c1 * V::splat( &p.y )  +  c2 * V::splat( &p.z )  +  c3;
+			r.store3( out[i].v );
+		}
+	}
+
+	/**
+	As transformPoints(), without the translation
+	*/
+	inline static void transformVectors(const Matrix4<Real> &m, const Vector3<Real> *in, Vector3<Real> *out, size_t count)
+	{
+		static_assert( sizeof( Vector3<Real> ) == 3 * sizeof( Real ), "Vector3 has to be three packed Reals" );
+		const Real *src = in[0].v;
+		Real *dst = out[0].v;
+		Rows rows( m );
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			V x, y, z;
+			SimdInterleave<Real>::load3( src + i * 3, x, y, z );
+			SimdInterleave<Real>::store3( dst + i * 3,
+					  x * rows.m00  +  y * rows.m01  +  z * rows.m02,
+					  x * rows.m10  +  y * rows.m11  +  z * rows.m12,
+					  x * rows.m20  +  y * rows.m21  +  z * rows.m22 );
+		}
+
+		V c0 = V::load( m.d ), c1 = V::load( m.d + 4 ), c2 = V::load( m.d + 8 );
+		for (; i < count; i++)
+		{
+			const Vector3<Real> &v = in[i];
+			V r = c0 * V::splat( &v.x )  +  c1 * V::splat( &v.y )  +  c2 * V::splat( &v.z );
+			r.store3( out[i].v );
+		}
+	}
+
+private:
+	//the top three rows of a matrix, every element in all four lanes
+	struct Rows
+	{
+		V m00, m01, m02, m03;
+		V m10, m11, m12, m13;
+		V m20, m21, m22, m23;
+
+		inline Rows(const Matrix4<Real> &m)
+		{
+			m00 = V::splat( &m.iM00 );	m01 = V::splat( &m.iM01 );	m02 = V::splat( &m.iM02 );	m03 = V::splat( &m.iM03 );
+			m10 = V::splat( &m.iM10 );	m11 = V::splat( &m.iM11 );	m12 = V::splat( &m.iM12 );	m13 = V::splat( &m.iM13 );
+			m20 = V::splat( &m.iM20 );	m21 = V::splat( &m.iM21 );	m22 = V::splat( &m.iM22 );	m23 = V::splat( &m.iM23 );
+		}
+	};
+
+	//2x2 products: A B, adj(A) B and A adj(B)
+	inline static V mul(const V &a, const V &b)
+	{
+		return a * V::template swizzle<0, 3, 0, 3>( b )  +  V::template swizzle<1, 0, 3, 2>( a ) * V::template swizzle<2, 1, 2, 1>( b );
+	}
+
+	inline static V adjMul(const V &a, const V &b)
+	{
+		return V::template swizzle<3, 3, 0, 0>( a ) * b  -  V::template swizzle<1, 1, 2, 2>( a ) * V::template swizzle<2, 3, 0, 1>( b );
+	}
+
+	inline static V mulAdj(const V &a, const V &b)
+	{
+		return a * V::template swizzle<3, 0, 3, 0>( b )  -  V::template swizzle<1, 0, 3, 2>( a ) * V::template swizzle<2, 1, 2, 1>( b );
+	}
+};
+
+#endif
+
+
+
+/**
+Matrix4SIMD - Matrix4 multiply, inverse, transpose and batch transforms on the vector unit
+
+Matrix4SIMD<float> uses SSE, Matrix4SIMD<double> AVX2 when the compiler targets it
+(COLOURUP_AVX2 in the CMake build) and pairs of SSE2 registers otherwise. Anything
+else, or a build without SSE2, gets Matrix4Scalar.
+
+Matrices and points are loaded and stored unaligned: Matrix4 keeps its plain layout,
+since 32 bit MSVC can't pass over-aligned types by value and it is passed around by
+value all over the library. Unaligned access to data that happens to be aligned costs
+nothing on anything with SSE2.
+*/
+template <typename Real> class Matrix4SIMD : public Matrix4Scalar<Real>
+{
+};
+
+#ifdef MATH_SIMD_SSE2
+
+template <> class Matrix4SIMD<float> : public Matrix4SIMDKernels<float>
+{
+public:
+	inline static const char * isa()
+	{
+		return "sse2";
+	}
+};
+
+template <> class Matrix4SIMD<double> : public Matrix4SIMDKernels<double>
+{
+public:
+	inline static const char * isa()
+	{
+#ifdef MATH_SIMD_AVX2
+		return "avx2";
+#else
+		return "sse2";
+#endif
+	}
+};
+
+#endif
+
+
+
+typedef Matrix4SIMD<float> Matrix4SIMDf;
+typedef Matrix4SIMD<double> Matrix4SIMDd;
+
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef POINT2_H__
 #define POINT2_H__
 
+#include "Math/MathConstexpr.h"
 #include "Math/epsilon.h"
 
 #include "Math/Vector2.h"
@@ -57,7 +58,7 @@ public:
 	/**
 	Default constructor: initialise to origin [0,0]
 	*/
-	inline Point2() : x( 0.0 ), y( 0.0 )
+	inline MATH_CONSTEXPR Point2() : x( 0.0 ), y( 0.0 )
 	{
 	}
 
@@ -66,21 +67,21 @@ public:
 	\param ix X-co-ordinate
 	\param iy Y-co-ordinate
 	*/
-	inline Point2(Real ix, Real iy) : x( ix ), y( iy )
+	inline MATH_CONSTEXPR Point2(Real ix, Real iy) : x( ix ), y( iy )
 	{
 	}
 
 	/**
 	Constructor: convert from Point2 with different Real number type
 	*/
-	template <typename S> inline Point2(const Point2<S> &v) : x( (Real)v.x ), y( (Real)v.y )
+	template <typename S> inline MATH_CONSTEXPR Point2(const Point2<S> &v) : x( (Real)v.x ), y( (Real)v.y )
 	{
 	}
 
 	/**
 	Constructor: convert from Vector2
 	*/
-	inline Point2(const Vector2<Real> &v) : x( v.x ), y( v.y )
+	inline MATH_CONSTEXPR Point2(const Vector2<Real> &v) : x( v.x ), y( v.y )
 	{
 	}
 
@@ -90,7 +91,7 @@ public:
 	/**
 	Equality test
 	*/
-	inline bool operator==(const Point2<Real> &p) const
+	inline MATH_CONSTEXPR bool operator==(const Point2<Real> &p) const
 	{
 		return ( x == p.x )  &&  ( y == p.y );
 	}
@@ -98,7 +99,7 @@ public:
 	/**
 	Inequality test
 	*/
-	inline bool operator!=(const Point2<Real> &p) const
+	inline MATH_CONSTEXPR bool operator!=(const Point2<Real> &p) const
 	{
 		return ( x != p.x )  ||  ( y != p.y );
 	}
@@ -110,7 +111,7 @@ public:
 
 	Point2 + Vector2 -> Point2
 	*/
-	inline Point2<Real> operator+(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Point2<Real> operator+(const Vector2<Real> &v) const
 	{
 		return Point2<Real>( x + v.x,  y + v.y );
 	}
@@ -129,7 +130,7 @@ public:
 
 	Point2 - Vector2 -> Point2
 	*/
-	inline Point2<Real> operator-(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Point2<Real> operator-(const Vector2<Real> &v) const
 	{
 		return Point2<Real>( x - v.x,  y - v.y );
 	}
@@ -148,7 +149,7 @@ public:
 
 	Point2 - Point2 -> Vector2
 	*/
-	inline Vector2<Real> operator-(const Point2<Real> &v) const
+	inline MATH_CONSTEXPR Vector2<Real> operator-(const Point2<Real> &v) const
 	{
 		return Vector2<Real>( x - v.x,  y - v.y );
 	}
@@ -156,7 +157,7 @@ public:
 	/**
 	Convert to Vector2
 	*/
-	inline Vector2<Real> toVector2() const
+	inline MATH_CONSTEXPR Vector2<Real> toVector2() const
 	{
 		return Vector2<Real>( x, y );
 	}
@@ -164,7 +165,7 @@ public:
 	/**
 	Dot product - Point2d(a, b).dot(Vector2d(p, q)) = a*p + b*q
 	*/
-	inline Real dot(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Real dot(const Vector2<Real> &v) const
 	{
 		return ( x * v.x ) + ( y * v.y );
 	}
@@ -172,7 +173,7 @@ public:
 	/**
 	Square of the distance to the point \a p
 	*/
-	inline Real sqrDistanceTo(const Point2<Real> &p) const
+	inline MATH_CONSTEXPR Real sqrDistanceTo(const Point2<Real> &p) const
 	{
 		return ( *this - p ).sqrLength();
 	}
@@ -189,7 +190,7 @@ public:
 	/**
 	Double the area of the triangle defined by the points \a a, \a b, and \a c.
 	*/
-	inline static Real areaOfTriangleTimes2(const Point2<Real> &a, const Point2<Real> &b, const Point2<Real> &c)
+	inline static MATH_CONSTEXPR Real areaOfTriangleTimes2(const Point2<Real> &a, const Point2<Real> &b, const Point2<Real> &c)
 	{
 		return ( b - a ).cross( c - a );
 	}
@@ -207,7 +208,7 @@ public:
 	*/
 	inline bool isOnRight(const Point2<Real> &a, const Point2<Real> &b)
 	{
-		return areaOfTrianglex2( a, b, *this )  <  0.0;
+		return areaOfTriangleTimes2( a, b, *this )  <  0.0;
 	}
 
 	/**
@@ -218,8 +219,8 @@ public:
 		Real sqrDist = lineA.sqrDistanceTo( lineB );
 		Real tolerence = sqrDist * EPSILON;
 
-		Real pArea = Point2<Real>::areaOfTrianglex2( lineA, lineB, p );
-		Real qArea = Point2<Real>::areaOfTrianglex2( lineA, lineB, q );
+		Real pArea = Point2<Real>::areaOfTriangleTimes2( lineA, lineB, p );
+		Real qArea = Point2<Real>::areaOfTriangleTimes2( lineA, lineB, q );
 
 		if ( ( pArea * pArea )  <  tolerence  ||
 			  ( qArea * qArea )  <  tolerence )
@@ -249,7 +250,7 @@ public:
 	/**
 	Multiply by real
 	*/
-	inline static Point2<Real> mul(const Point2<Real> &p, Real s)
+	inline static MATH_CONSTEXPR Point2<Real> mul(const Point2<Real> &p, Real s)
 	{
 		return Point2<Real>( p.x * s,  p.y * s );
 	}
@@ -259,7 +260,7 @@ public:
 	/**
 	Add two points
 	*/
-	inline static Point2<Real> sum(const Point2<Real> &a, const Point2<Real> &b)
+	inline static MATH_CONSTEXPR Point2<Real> sum(const Point2<Real> &a, const Point2<Real> &b)
 	{
 		return Point2<Real>( a.x + b.x,  a.y + b.y );
 	}
@@ -286,7 +287,7 @@ public:
 	/**
 	Average of (mid-point between) two points
 	*/
-	inline static Point2<Real> average(const Point2<Real> &a, const Point2<Real> &b)
+	inline static MATH_CONSTEXPR Point2<Real> average(const Point2<Real> &a, const Point2<Real> &b)
 	{
 		return mul( sum( a, b ), (Real)0.5 );
 	}
@@ -298,7 +299,7 @@ public:
 	\param b - point B
 	\param wb - weight of point B
 	*/
-	inline static Point2<Real> weightedAverage(const Point2<Real> &a, Real wa, const Point2<Real> &b, Real wb)
+	inline static MATH_CONSTEXPR Point2<Real> weightedAverage(const Point2<Real> &a, Real wa, const Point2<Real> &b, Real wb)
 	{
 		return Point2<Real>( a.x * wa  +  b.x * wb,
 					a.y * wa  +  b.y * wb );
@@ -321,7 +322,7 @@ public:
 	
 	a + (b-a)*t
 	*/
-	inline static Point2<Real> lerp(const Point2<Real> &a, const Point2<Real> &b, Real t)
+	inline static MATH_CONSTEXPR Point2<Real> lerp(const Point2<Real> &a, const Point2<Real> &b, Real t)
 	{
 		return a  +  ( b - a ) * t;
 	}
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 
+#include "Math/MathConstexpr.h"
+
 #include "Math/Vector3.h"
 #include "Math/Point2.h"
 
@@ -59,7 +61,7 @@ public:
 	/**
 	Default constructor: initialise to origin [0,0,0]
 	*/
-	inline Point3() : x( 0.0 ), y( 0.0 ), z( 0.0 )
+	inline MATH_CONSTEXPR Point3() : x( 0.0 ), y( 0.0 ), z( 0.0 )
 	{
 	}
 
@@ -69,35 +71,35 @@ public:
 	\param iy Y-co-ordinate
 	\param iz Z-co-ordinate
 	*/
-	inline Point3(Real ix, Real iy, Real iz) : x( ix ), y( iy ), z( iz )
+	inline MATH_CONSTEXPR Point3(Real ix, Real iy, Real iz) : x( ix ), y( iy ), z( iz )
 	{
 	}
 
 	/**
 	Constructor: convert from Point3 with different Real number type
 	*/
-	template <typename S> inline Point3(const Point3<S> &p) : x( (Real)p.x ), y( (Real)p.y ), z( (Real)p.z )
+	template <typename S> inline MATH_CONSTEXPR Point3(const Point3<S> &p) : x( (Real)p.x ), y( (Real)p.y ), z( (Real)p.z )
 	{
 	}
 
 	/**
 	Constructor: convert from Point2
 	*/
-	inline Point3(const Point2<Real> &p2) : x( p2.x ), y( p2.y ), z( (Real)0.0 )
+	inline MATH_CONSTEXPR Point3(const Point2<Real> &p2) : x( p2.x ), y( p2.y ), z( (Real)0.0 )
 	{
 	}
 
 	/**
 	Constructor: convert from Point2, z-co-ordinate passed in \a iz
 	*/
-	inline Point3(const Point2<Real> &p2, Real iz) : x( p2.x ), y( p2.y ), z( iz )
+	inline MATH_CONSTEXPR Point3(const Point2<Real> &p2, Real iz) : x( p2.x ), y( p2.y ), z( iz )
 	{
 	}
 
 	/**
 	Constructor: convert from Vector3
 	*/
-	inline Point3(const Vector3<Real> &v) : x( v.x ), y( v.y ), z( v.z )
+	inline MATH_CONSTEXPR Point3(const Vector3<Real> &v) : x( v.x ), y( v.y ), z( v.z )
 	{
 	}
 
@@ -106,7 +108,7 @@ public:
 	/**
 	Equality test
 	*/
-	inline bool operator==(const Point3<Real> &p) const
+	inline MATH_CONSTEXPR bool operator==(const Point3<Real> &p) const
 	{
 		return ( x == p.x )  &&  ( y == p.y )  &&  ( z == p.z );
 	}
@@ -114,7 +116,7 @@ public:
 	/**
 	Inequality test
 	*/
-	inline bool operator!=(const Point3<Real> &p) const
+	inline MATH_CONSTEXPR bool operator!=(const Point3<Real> &p) const
 	{
 		return ( x != p.x )  ||  ( y != p.y )  ||  ( z != p.z );
 	}
@@ -125,7 +127,7 @@ public:
 
 	Point3 + Vector3 -> Point3
 	*/
-	inline Point3<Real> operator+(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Point3<Real> operator+(const Vector3<Real> &v) const
 	{
 		return Point3<Real>( x + v.x,  y + v.y,  z + v.z );
 	}
@@ -145,7 +147,7 @@ public:
 
 	Point3 - Vector3 -> Point3
 	*/
-	inline Point3<Real> operator-(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Point3<Real> operator-(const Vector3<Real> &v) const
 	{
 		return Point3<Real>( x - v.x,  y - v.y,  z - v.z );
 	}
@@ -165,7 +167,7 @@ public:
 
 	Point3 - Point3 -> Vector3
 	*/
-	inline Vector3<Real> operator-(const Point3<Real> &v) const
+	inline MATH_CONSTEXPR Vector3<Real> operator-(const Point3<Real> &v) const
 	{
 		return Vector3<Real>( x - v.x,  y - v.y,  z - v.z );
 	}
@@ -173,7 +175,7 @@ public:
 	/**
 	Convert to Vector3
 	*/
-	inline Vector3<Real> toVector3() const
+	inline MATH_CONSTEXPR Vector3<Real> toVector3() const
 	{
 		return Vector3<Real>( x, y, z );
 	}
@@ -181,7 +183,7 @@ public:
 	/**
 	Convert to Point2 - loses Z-co-ordinate
 	*/
-	inline Point2<Real> toPoint2() const
+	inline MATH_CONSTEXPR Point2<Real> toPoint2() const
 	{
 		return Point2<Real>( x, y );
 	}
@@ -215,7 +217,7 @@ public:
 	/**
 	Dot product - Point3d(a, b, c).dot(Vector3d(p, q, r)) = a*p + b*q + c*r
 	*/
-	inline Real dot(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Real dot(const Vector3<Real> &v) const
 	{
 		return ( x * v.x ) + ( y * v.y ) + ( z * v.z );
 	}
@@ -223,7 +225,7 @@ public:
 	/**
 	Square of the distance to the point \a p
 	*/
-	inline Real sqrDistanceTo(const Point3<Real> &p) const
+	inline MATH_CONSTEXPR Real sqrDistanceTo(const Point3<Real> &p) const
 	{
 		return ( *this - p ).sqrLength();
 	}
@@ -410,7 +412,7 @@ public:
 	/**
 	Multiply by real
 	*/
-	inline static Point3<Real> mul(const Point3<Real> &p, Real s)
+	inline static MATH_CONSTEXPR Point3<Real> mul(const Point3<Real> &p, Real s)
 	{
 		return Point3<Real>( p.x * s,  p.y * s,  p.z * s );
 	}
@@ -419,7 +421,7 @@ public:
 	/**
 	Add two points
 	*/
-	inline static Point3<Real> sum(const Point3<Real> &a, const Point3<Real> &b)
+	inline static MATH_CONSTEXPR Point3<Real> sum(const Point3<Real> &a, const Point3<Real> &b)
 	{
 		return Point3( a.x + b.x,  a.y + b.y,  a.z + b.z );
 	}
@@ -445,7 +447,7 @@ public:
 	/**
 	Average of (mid-point between) two points
 	*/
-	inline static Point3<Real> average(const Point3<Real> &a, const Point3<Real> &b)
+	inline static MATH_CONSTEXPR Point3<Real> average(const Point3<Real> &a, const Point3<Real> &b)
 	{
 		return mul( sum( a, b ), (Real)0.5 );
 	}
@@ -458,7 +460,7 @@ public:
 	\param b - point B
 	\param wb - weight of point B
 	*/
-	inline static Point3<Real> weightedAverage(const Point3<Real> &a, Real wa, const Point3<Real> &b, Real wb)
+	inline static MATH_CONSTEXPR Point3<Real> weightedAverage(const Point3<Real> &a, Real wa, const Point3<Real> &b, Real wb)
 	{
 		return Point3<Real>( a.x * wa  +  b.x * wb,
 							a.y * wa  +  b.y * wb,
@@ -484,7 +486,7 @@ public:
 	
 	a + (b-a)*t
 	*/
-	inline static Point3<Real> lerp(const Point3<Real> &a, const Point3<Real> &b, Real t)
+	inline static MATH_CONSTEXPR Point3<Real> lerp(const Point3<Real> &a, const Point3<Real> &b, Real t)
 	{
 		return a  +  ( b - a ) * t;
 	}
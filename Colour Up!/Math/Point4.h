@@ -6,6 +6,7 @@
 #ifndef POINT4_H__
 #define POINT4_H__
 
+#include "Math/MathConstexpr.h"
 #include "Math/Point3.h"
 
 
@@ -24,31 +25,31 @@ public:
 	};
 
 
-	inline Point4() : x( (Real)0.0 ), y( (Real)0.0 ), z( (Real)0.0 ), w( (Real)1.0 )
+	inline MATH_CONSTEXPR Point4() : x( (Real)0.0 ), y( (Real)0.0 ), z( (Real)0.0 ), w( (Real)1.0 )
 	{
 	}
 
-	inline Point4(Real ix, Real iy, Real iz)
+	inline MATH_CONSTEXPR Point4(Real ix, Real iy, Real iz)
 					  : x( ix ), y( iy ), z( iz ), w( 1.0 )
 	{
 	}
 
-	inline Point4(Real ix, Real iy, Real iz, Real iw)
+	inline MATH_CONSTEXPR Point4(Real ix, Real iy, Real iz, Real iw)
 					  : x( ix ), y( iy ), z( iz ), w( iw )
 	{
 	}
 
-	template <typename S> Point4(const Point4<S> &p)
+	template <typename S> inline MATH_CONSTEXPR Point4(const Point4<S> &p)
 		: x( (Real)p.x ), y( (Real)p.y ), z( (Real)p.z ), w( (Real)p.w )
 	{
 	}
 
-	inline Point4(const Point3<Real> &p3)
+	inline MATH_CONSTEXPR Point4(const Point3<Real> &p3)
 					  : x( p3.x ), y( p3.y ), z( p3.z ), w( (Real)1.0 )
 	{
 	}
 
-	inline Point4(const Point3<Real> &p3, Real iw)
+	inline MATH_CONSTEXPR Point4(const Point3<Real> &p3, Real iw)
 					  : x( p3.x ), y( p3.y ), z( p3.z ), w( iw )
 	{
 	}
@@ -61,12 +62,12 @@ public:
 		return Point3<Real>( x * oneOverW, y * oneOverW, z * oneOverW );
 	}
 
-	inline Point3<Real> inverseConvertToPoint3() const
+	inline MATH_CONSTEXPR Point3<Real> inverseConvertToPoint3() const
 	{
 		return Point3<Real>( x * w, y * w, z * w );
 	}
 
-	inline Point3<Real> toPoint3() const
+	inline MATH_CONSTEXPR Point3<Real> toPoint3() const
 	{
 		return Point3<Real>( x, y, z );
 	}
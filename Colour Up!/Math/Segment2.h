@@ -102,7 +102,7 @@ public:
 	inline Point2<Real> closestPointTo(const Point2<Real> &p) const
 	{
 		Real t;
-		return closestPointTo( p, t );
+		return closestParamAndPointTo( p, t );
 	}
 
 	//distance from the line to p
@@ -121,31 +121,31 @@ public:
 	//is p on the left side of the line?
 	inline bool onLeft(const Point2<Real> &p) const
 	{
-		return Point2<Real>::areaOfTrianglex2( a, b, p )  >  (Real)0.0;
+		return Point2<Real>::areaOfTriangleTimes2( a, b, p )  >  (Real)0.0;
 	}
 
 	//is p on the line or on the left side of the line?
 	inline bool onOrLeft(const Point2<Real> &p) const
 	{
-		return Point2<Real>::areaOfTrianglex2( a, b, p )  >=  (Real)0.0;
+		return Point2<Real>::areaOfTriangleTimes2( a, b, p )  >=  (Real)0.0;
 	}
 
 	//is p on the right side of the line?
 	inline bool onRight(const Point2<Real> &p) const
 	{
-		return Point2<Real>::areaOfTrianglex2( a, b, p )  <  (Real)0.0;
+		return Point2<Real>::areaOfTriangleTimes2( a, b, p )  <  (Real)0.0;
 	}
 
 	//is p on the line or on the right side of the line?
 	inline bool onOrRight(const Point2<Real> &p) const
 	{
-		return Point2<Real>::areaOfTrianglex2( a, b, p )  <=  (Real)0.0;
+		return Point2<Real>::areaOfTriangleTimes2( a, b, p )  <=  (Real)0.0;
 	}
 
 	//is p on the line?
 	inline bool on(const Point2<Real> &p) const
 	{
-		return Point2<Real>::areaOfTrianglex2( a, b, p )  ==  (Real)0.0;
+		return Point2<Real>::areaOfTriangleTimes2( a, b, p )  ==  (Real)0.0;
 	}
 
 	//does the line separate p and q
@@ -0,0 +1,488 @@
+#ifndef TRANSFORMBATCH_H__
+#define TRANSFORMBATCH_H__
+
+#include <stddef.h>
+
+#include <Math/Matrix4SIMD.h>
+#include <Math/Affine2.h>
+
+
+
+/**
+PointSpan2 - \a count 2D co-ordinates somewhere in memory
+
+Element i's x is at x[i * stride] and its y at y[i * stride], so one span type
+covers the three layouts a batch transform is likely to meet:
+
+AoS: an array of Point2s or Vector2s (aos())
+SoA: separate x and y arrays (soa())
+strided: the position inside a bigger interleaved vertex (strided())
+
+stride is counted in Reals, not bytes. Use PointSpan2<const Real> for input.
+*/
+template <typename Real> class PointSpan2
+{
+public:
+	Real *x, *y;
+	ptrdiff_t stride;
+	size_t count;
+
+
+	inline PointSpan2() : x( NULL ), y( NULL ), stride( 1 ), count( 0 )
+	{
+	}
+
+	inline PointSpan2(Real *ix, Real *iy, ptrdiff_t istride, size_t icount)
+		: x( ix ), y( iy ), stride( istride ), count( icount )
+	{
+	}
+
+	/**
+	Constructor: read-only view of a writable span
+	*/
+	template <typename S> inline PointSpan2(const PointSpan2<S> &s)
+		: x( s.x ), y( s.y ), stride( s.stride ), count( s.count )
+	{
+	}
+
+
+	/**
+	Array of Point2s or Vector2s (or anything else starting with x and y)
+	*/
+	template <typename P> inline static PointSpan2 aos(P *elements, size_t count)
+	{
+		static_assert( sizeof( P ) % sizeof( Real ) == 0, "elements have to be a whole number of Reals" );
+		return PointSpan2( &elements->x, &elements->y, sizeof( P ) / sizeof( Real ), count );
+	}
+
+	/**
+	Separate arrays of x and y co-ordinates
+	*/
+	inline static PointSpan2 soa(Real *xs, Real *ys, size_t count)
+	{
+		return PointSpan2( xs, ys, 1, count );
+	}
+
+	/**
+	x and y at \a position inside every \a stride Reals, e.g. a vertex format of [x y u v]
+	*/
+	inline static PointSpan2 strided(Real *position, ptrdiff_t stride, size_t count)
+	{
+		return PointSpan2( position, position + 1, stride, count );
+	}
+
+
+	/**
+	true if x and y are separate arrays of consecutive Reals
+	*/
+	inline bool isSoA() const
+	{
+		return stride == 1;
+	}
+
+	/**
+	true if the co-ordinates are packed [x0 y0 x1 y1 ...]
+	*/
+	inline bool isPacked() const
+	{
+		return stride == 2  &&  y == x + 1;
+	}
+};
+
+
+/**
+PointSpan3 - \a count 3D co-ordinates somewhere in memory
+
+As PointSpan2 with a z co-ordinate.
+*/
+template <typename Real> class PointSpan3
+{
+public:
+	Real *x, *y, *z;
+	ptrdiff_t stride;
+	size_t count;
+
+
+	inline PointSpan3() : x( NULL ), y( NULL ), z( NULL ), stride( 1 ), count( 0 )
+	{
+	}
+
+	inline PointSpan3(Real *ix, Real *iy, Real *iz, ptrdiff_t istride, size_t icount)
+		: x( ix ), y( iy ), z( iz ), stride( istride ), count( icount )
+	{
+	}
+
+	/**
+	Constructor: read-only view of a writable span
+	*/
+	template <typename S> inline PointSpan3(const PointSpan3<S> &s)
+		: x( s.x ), y( s.y ), z( s.z ), stride( s.stride ), count( s.count )
+	{
+	}
+
+
+	/**
+	Array of Point3s or Vector3s (or anything else starting with x, y and z)
+	*/
+	template <typename P> inline static PointSpan3 aos(P *elements, size_t count)
+	{
+		static_assert( sizeof( P ) % sizeof( Real ) == 0, "elements have to be a whole number of Reals" );
+		return PointSpan3( &elements->x, &elements->y, &elements->z, sizeof( P ) / sizeof( Real ), count );
+	}
+
+	/**
+	Separate arrays of x, y and z co-ordinates
+	*/
+	inline static PointSpan3 soa(Real *xs, Real *ys, Real *zs, size_t count)
+	{
+		return PointSpan3( xs, ys, zs, 1, count );
+	}
+
+	/**
+	x, y and z at \a position inside every \a stride Reals
+	*/
+	inline static PointSpan3 strided(Real *position, ptrdiff_t stride, size_t count)
+	{
+		return PointSpan3( position, position + 1, position + 2, stride, count );
+	}
+
+
+	/**
+	true if x, y and z are separate arrays of consecutive Reals
+	*/
+	inline bool isSoA() const
+	{
+		return stride == 1;
+	}
+
+	/**
+	true if the co-ordinates are packed [x0 y0 z0 x1 y1 z1 ...]
+	*/
+	inline bool isPacked() const
+	{
+		return stride == 3  &&  y == x + 1  &&  z == x + 2;
+	}
+};
+
+
+
+/**
+TransformBatch - apply one transformation to a whole span of points or vectors
+
+transformPoints2/transformVectors2 take an Affine2 or use the 2D part of a Matrix4 (as
+operator*(Matrix4, Point2) does), transformPoints3/transformVectors3 the 3D part. Every element gets exactly what the
+per-element operator would give it: the products are added in the same order.
+
+When both spans are SoA or packed AoS, four elements at a time go through SimdVec4
+(see Matrix4SIMD.h); any other stride is done one element at a time.
+
+\a out must have at least in.count elements, and must either be \a in or not overlap it.
+*/
+template <typename Real> class TransformBatch
+{
+	typedef PointSpan2<const Real> In2;
+	typedef PointSpan2<Real> Out2;
+	typedef PointSpan3<const Real> In3;
+	typedef PointSpan3<Real> Out3;
+
+public:
+	/**
+	Points in \a in transformed by \a m to \a out
+	*/
+	inline static void transformPoints2(const Matrix4<Real> &m, In2 in, Out2 out)
+	{
+		run2( Affine2Op( m.iM00, m.iM01, m.iM03, m.iM10, m.iM11, m.iM13 ), in, out );
+	}
+
+	/**
+	Vectors in \a in transformed by \a m to \a out
+
+	NOTE: translations are *NOT* applied to vectors
+	*/
+	inline static void transformVectors2(const Matrix4<Real> &m, In2 in, Out2 out)
+	{
+		run2( Linear2Op( m.iM00, m.iM01, m.iM10, m.iM11 ), in, out );
+	}
+
+	/**
+	Points in \a in transformed by \a m to \a out
+	*/
+	inline static void transformPoints2(const Affine2<Real> &m, In2 in, Out2 out)
+	{
+		run2( Affine2Op( m.iM00, m.iM01, m.iM02, m.iM10, m.iM11, m.iM12 ), in, out );
+	}
+
+	/**
+	Vectors in \a in transformed by \a m to \a out
+
+	NOTE: translations are *NOT* applied to vectors
+	*/
+	inline static void transformVectors2(const Affine2<Real> &m, In2 in, Out2 out)
+	{
+		run2( Linear2Op( m.iM00, m.iM01, m.iM10, m.iM11 ), in, out );
+	}
+
+	/**
+	Points in \a in transformed by \a m to \a out
+	*/
+	inline static void transformPoints3(const Matrix4<Real> &m, In3 in, Out3 out)
+	{
+		run3( Affine3Op<true>( m ), in, out );
+	}
+
+	/**
+	Vectors in \a in transformed by \a m to \a out
+
+	NOTE: translations are *NOT* applied to vectors
+	*/
+	inline static void transformVectors3(const Matrix4<Real> &m, In3 in, Out3 out)
+	{
+		run3( Affine3Op<false>( m ), in, out );
+	}
+
+
+protected:
+#ifdef MATH_SIMD_SSE2
+	typedef SimdVec4<Real> V;
+#endif
+
+	//x' = ax + by + c, y' = dx + ey + f
+	struct Affine2Op
+	{
+		Real a, b, c, d, e, f;
+#ifdef MATH_SIMD_SSE2
+		V va, vb, vc, vd, ve, vf;
+#endif
+
+		inline Affine2Op(Real ia, Real ib, Real ic, Real id, Real ie, Real iF)
+			: a( ia ), b( ib ), c( ic ), d( id ), e( ie ), f( iF )
+		{
+#ifdef MATH_SIMD_SSE2
+			va = V::splat( &a );	vb = V::splat( &b );	vc = V::splat( &c );
+			vd = V::splat( &d );	ve = V::splat( &e );	vf = V::splat( &f );
+#endif
+		}
+
+		inline void operator()(Real x, Real y, Real *ox, Real *oy) const
+		{
+			*ox = x * a  +  y * b  +  c;
+			*oy = x * d  +  y * e  +  f;
+		}
+
+#ifdef MATH_SIMD_SSE2
+		inline void operator()(const V &x, const V &y, V &ox, V &oy) const
+		{
+			ox = x * va  +  y * vb  +  vc;
+			oy = x * vd  +  y * ve  +  vf;
+		}
+#endif
+	};
+
+	//x' = ax + by, y' = dx + ey
+	struct Linear2Op
+	{
+		Real a, b, d, e;
+#ifdef MATH_SIMD_SSE2
+		V va, vb, vd, ve;
+#endif
+
+		inline Linear2Op(Real ia, Real ib, Real id, Real ie)
+			: a( ia ), b( ib ), d( id ), e( ie )
+		{
+#ifdef MATH_SIMD_SSE2
+			va = V::splat( &a );	vb = V::splat( &b );
+			vd = V::splat( &d );	ve = V::splat( &e );
+#endif
+		}
+
+		inline void operator()(Real x, Real y, Real *ox, Real *oy) const
+		{
+			*ox = x * a  +  y * b;
+			*oy = x * d  +  y * e;
+		}
+
+#ifdef MATH_SIMD_SSE2
+		inline void operator()(const V &x, const V &y, V &ox, V &oy) const
+		{
+			ox = x * va  +  y * vb;
+			oy = x * vd  +  y * ve;
+		}
+#endif
+	};
+
+	//the top three rows of a Matrix4, with or without the translation
+	template <bool Translate> struct Affine3Op
+	{
+		const Matrix4<Real> &m;
+#ifdef MATH_SIMD_SSE2
+		V m00, m01, m02, m03;
+		V m10, m11, m12, m13;
+		V m20, m21, m22, m23;
+#endif
+
+		inline Affine3Op(const Matrix4<Real> &im) : m( im )
+		{
+#ifdef MATH_SIMD_SSE2
+			m00 = V::splat( &m.iM00 );	m01 = V::splat( &m.iM01 );	m02 = V::splat( &m.iM02 );	m03 = V::splat( &m.iM03 );
+			m10 = V::splat( &m.iM10 );	m11 = V::splat( &m.iM11 );	m12 = V::splat( &m.iM12 );	m13 = V::splat( &m.iM13 );
+			m20 = V::splat( &m.iM20 );	m21 = V::splat( &m.iM21 );	m22 = V::splat( &m.iM22 );	m23 = V::splat( &m.iM23 );
+#endif
+		}
+
+		inline void operator()(Real x, Real y, Real z, Real *ox, Real *oy, Real *oz) const
+		{
+			if ( Translate )
+			{
+				*ox = x * m.iM00  +  y * m.iM01  +  z * m.iM02  +  m.iM03;
+				*oy = x * m.iM10  +  y * m.iM11  +  z * m.iM12  +  m.iM13;
+				*oz = x * m.iM20  +  y * m.iM21  +  z * m.iM22  +  m.iM23;
+			}
+			else
+			{
+				*ox = x * m.iM00  +  y * m.iM01  +  z * m.iM02;
+				*oy = x * m.iM10  +  y * m.iM11  +  z * m.iM12;
+				*oz = x * m.iM20  +  y * m.iM21  +  z * m.iM22;
+			}
+		}
+
+#ifdef MATH_SIMD_SSE2
+		inline void operator()(const V &x, const V &y, const V &z, V &ox, V &oy, V &oz) const
+		{
+			ox = x * m00  +  y * m01  +  z * m02;
+			oy = x * m10  +  y * m11  +  z * m12;
+			oz = x * m20  +  y * m21  +  z * m22;
+			if ( Translate )
+			{
+				ox = ox + m03;
+				oy = oy + m13;
+				oz = oz + m23;
+			}
+		}
+#endif
+	};
+
+
+	template <typename Op> inline static void run2(const Op &op, In2 in, Out2 out)
+	{
+		size_t i = 0;
+#ifdef MATH_SIMD_SSE2
+		if ( in.isSoA() )
+		{
+			if ( out.isSoA() )				i = simd2<true, true>( op, in, out );
+			else if ( out.isPacked() )		i = simd2<true, false>( op, in, out );
+		}
+		else if ( in.isPacked() )
+		{
+			if ( out.isSoA() )				i = simd2<false, true>( op, in, out );
+			else if ( out.isPacked() )		i = simd2<false, false>( op, in, out );
+		}
+#endif
+		for (; i < in.count; i++)
+		{
+			ptrdiff_t s = (ptrdiff_t)i * in.stride, d = (ptrdiff_t)i * out.stride;
+			op( in.x[s], in.y[s], out.x + d, out.y + d );
+		}
+	}
+
+	template <typename Op> inline static void run3(const Op &op, In3 in, Out3 out)
+	{
+		size_t i = 0;
+#ifdef MATH_SIMD_SSE2
+		if ( in.isSoA() )
+		{
+			if ( out.isSoA() )				i = simd3<true, true>( op, in, out );
+			else if ( out.isPacked() )		i = simd3<true, false>( op, in, out );
+		}
+		else if ( in.isPacked() )
+		{
+			if ( out.isSoA() )				i = simd3<false, true>( op, in, out );
+			else if ( out.isPacked() )		i = simd3<false, false>( op, in, out );
+		}
+#endif
+		for (; i < in.count; i++)
+		{
+			ptrdiff_t s = (ptrdiff_t)i * in.stride, d = (ptrdiff_t)i * out.stride;
+			op( in.x[s], in.y[s], in.z[s], out.x + d, out.y + d, out.z + d );
+		}
+	}
+
+
+#ifdef MATH_SIMD_SSE2
+	//the whole blocks of four, returns how many elements were done
+	template <bool InSoA, bool OutSoA, typename Op> inline static size_t simd2(const Op &op, In2 in, Out2 out)
+	{
+		size_t i = 0;
+		for (; i + 4 <= in.count; i += 4)
+		{
+			V x, y, ox, oy;
+			if ( InSoA )
+			{
+				x = V::load( in.x + i );
+				y = V::load( in.y + i );
+			}
+			else
+			{
+				SimdInterleave<Real>::load2( in.x + i * 2, x, y );
+			}
+
+			op( x, y, ox, oy );
+
+			if ( OutSoA )
+			{
+				ox.store( out.x + i );
+				oy.store( out.y + i );
+			}
+			else
+			{
+				SimdInterleave<Real>::store2( out.x + i * 2, ox, oy );
+			}
+		}
+		return i;
+	}
+
+	template <bool InSoA, bool OutSoA, typename Op> inline static size_t simd3(const Op &op, In3 in, Out3 out)
+	{
+		size_t i = 0;
+		for (; i + 4 <= in.count; i += 4)
+		{
+			V x, y, z, ox, oy, oz;
+			if ( InSoA )
+			{
+				x = V::load( in.x + i );
+				y = V::load( in.y + i );
+				z = V::load( in.z + i );
+			}
+			else
+			{
+				SimdInterleave<Real>::load3( in.x + i * 3, x, y, z );
+			}
+
+			op( x, y, z, ox, oy, oz );
+
+			if ( OutSoA )
+			{
+				ox.store( out.x + i );
+				oy.store( out.y + i );
+				oz.store( out.z + i );
+			}
+			else
+			{
+				SimdInterleave<Real>::store3( out.x + i * 3, ox, oy, oz );
+			}
+		}
+		return i;
+	}
+#endif
+};
+
+
+
+typedef PointSpan2<float> PointSpan2f;
+typedef PointSpan2<double> PointSpan2d;
+typedef PointSpan3<float> PointSpan3f;
+typedef PointSpan3<double> PointSpan3d;
+typedef TransformBatch<float> TransformBatchf;
+typedef TransformBatch<double> TransformBatchd;
+
+
+#endif
@@ -26,7 +26,7 @@ public:
 	}
 
 	template <typename S> inline Triangle2(const Triangle2<S> &t)
-		: a( t.a ), b( t.b. ), c( t.c )
+		: a( t.a ), b( t.b ), c( t.c )
 	{
 	}
 
@@ -50,7 +50,7 @@ public:
 
 	inline Real areaX2() const
 	{
-		return Point2<Real>::areaOfTrianglex2( a, b, c );
+		return Point2<Real>::areaOfTriangleTimes2( a, b, c );
 	}
 
 	inline Real area() const
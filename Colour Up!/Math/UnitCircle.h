@@ -0,0 +1,45 @@
+#ifndef UNITCIRCLE_H__
+#define UNITCIRCLE_H__
+
+#include <math.h>
+
+#include <Math/MathConstants.h>
+
+
+
+/**
+UnitCircle - N points evenly spaced around the unit circle, counter-clockwise from (1,0)
+
+Computed once, with libm, when the table is constructed: outlines drawn from it are the same
+as calling cos and sin for every vertex, without the 2 * N calls each time. Angles are
+worked out in degrees first when 360 divides by N, so a 5 degree step is exactly the
+i * 5 * (pi / 180) the drawing code used to pass to cos and sin.
+
+Construct one at file scope rather than as a function-local static: Visual Studio 2013
+doesn't make those thread safe.
+*/
+template <typename Real, int N> class UnitCircle
+{
+public:
+	Real cosines[N];
+	Real sines[N];
+
+
+	inline UnitCircle()
+	{
+		for (int i = 0; i < N; i++)
+		{
+			double angle = ( 360 % N == 0 )  ?  ( i * ( 360 / N ) ) * ( M_PI / 180.0 )  :  i * ( 2.0 * M_PI / N );
+			cosines[i] = (Real)cos( angle );
+			sines[i] = (Real)sin( angle );
+		}
+	}
+
+	inline static int size()
+	{
+		return N;
+	}
+};
+
+
+#endif
@@ -11,6 +11,8 @@
 #include <algorithm>
 #include <complex>
 
+#include "Math/MathConstexpr.h"
+
 
 
 /**
@@ -52,7 +54,7 @@ public:
 	
 	Creates a zero vector (0,0)
 	*/
-	inline Vector2() : x( (Real)0.0 ), y( (Real)0.0 )
+	inline MATH_CONSTEXPR Vector2() : x( (Real)0.0 ), y( (Real)0.0 )
 	{
 	}
 
@@ -62,7 +64,7 @@ public:
 	\param ix - x co-ordinate
 	\param iy - y co-ordinate
 	*/
-	inline Vector2(Real ix, Real iy) : x( ix ), y( iy )
+	inline MATH_CONSTEXPR Vector2(Real ix, Real iy) : x( ix ), y( iy )
 	{
 	}
 
@@ -70,7 +72,7 @@ public:
 	Constructor, converts from a Vector2 with a different element type e.g. converts from a Vector2 that uses floats (Vector2<float> or Vector2f)
 	to a Vector2 that uses doubles (Vector2<double> or Vector2d).
 	*/
-	template <typename S> inline Vector2(const Vector2<S> &v) : x( (Real)v.x ), y( (Real)v.y )
+	template <typename S> inline MATH_CONSTEXPR Vector2(const Vector2<S> &v) : x( (Real)v.x ), y( (Real)v.y )
 	{
 	}
 
@@ -79,7 +81,7 @@ public:
 	/**
 	Equality comparison
 	*/
-	inline bool operator==(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR bool operator==(const Vector2<Real> &v) const
 	{
 		return ( x == v.x )  &&  ( y  ==  v.y );
 	}
@@ -87,7 +89,7 @@ public:
 	/**
 	Inequality comparison
 	*/
-	inline bool operator!=(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR bool operator!=(const Vector2<Real> &v) const
 	{
 		return ( x != v.x )  ||  ( y != v.y );
 	}
@@ -96,7 +98,7 @@ public:
 	/**
 	Addition operator:  Vector2d(a, b)  +  Vector2d(p, q)  ==  Vector2d(a+b, p+q)
 	*/
-	inline Vector2<Real> operator+(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Vector2<Real> operator+(const Vector2<Real> &v) const
 	{
 		return Vector2<Real>( x + v.x,  y + v.y );
 	}
@@ -113,7 +115,7 @@ public:
 	/**
 	Subtraction operator:  Vector2d(a, b)  -  Vector2d(p, q)  =  Vector2d(a-b, p-q)
 	*/
-	inline Vector2<Real> operator-(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Vector2<Real> operator-(const Vector2<Real> &v) const
 	{
 		return Vector2<Real>( x - v.x,  y - v.y );
 	}
@@ -130,7 +132,7 @@ public:
 	/**
 	Scale (multiply) a vector by a real number:  Vector2d(x, y) * s  ==  Vector2d(x*s, y*s)
 	*/
-	inline Vector2<Real> operator*(Real s) const
+	inline MATH_CONSTEXPR Vector2<Real> operator*(Real s) const
 	{
 		return Vector2<Real>( x * s,  y * s );
 	}
@@ -147,7 +149,7 @@ public:
 	/**
 	Negation operator:   -Vector2d(x, y)  =  Vector2d(-x, -y)
 	*/
-	inline Vector2<Real> operator-() const
+	inline MATH_CONSTEXPR Vector2<Real> operator-() const
 	{
 		return Vector2<Real>( -x, -y );
 	}
@@ -156,7 +158,7 @@ public:
 	/**
 	Dot product:  Vector2d(a, b).dot(Vector2d(p, q))  ==  a*p + b*q
 	*/
-	inline Real dot(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Real dot(const Vector2<Real> &v) const
 	{
 		return ( x * v.x )  +  ( y * v.y );
 	}
@@ -164,7 +166,7 @@ public:
 	/**
 	Cross product:  Vector2d(a, b).cross(Vector2d(p, q))  =  (a*q - b*p)
 	*/
-	inline Real cross(const Vector2<Real> &v) const
+	inline MATH_CONSTEXPR Real cross(const Vector2<Real> &v) const
 	{
 		return x * v.y  -  y * v.x;
 	}
@@ -172,7 +174,7 @@ public:
 	/**
 	Square of length:  Vector2d(a,b).sqrLength()  ==  a*a + b*b  ==  |(a,b)|^2   
 	*/
-	inline Real sqrLength() const
+	inline MATH_CONSTEXPR Real sqrLength() const
 	{
 		return dot( *this );
 	}
@@ -227,7 +229,7 @@ public:
 	/**
 	Creates a vector perpendicular to \a this:  Vector2d(x, y).perpendicular()  ==  Vector2d(y, -x)
 	*/
-	inline Vector2<Real> perpendicular() const
+	inline MATH_CONSTEXPR Vector2<Real> perpendicular() const
 	{
 		return Vector2<Real>( y, -x );
 	}
@@ -241,7 +243,7 @@ public:
 	
 	v.projectOntoUnitVector(u)  ==  u * v.dot(u)
 	*/
-	inline Vector2<Real> projectOntoUnitVector(const Vector2<Real> &unitVector) const
+	inline MATH_CONSTEXPR Vector2<Real> projectOntoUnitVector(const Vector2<Real> &unitVector) const
 	{
 		return unitVector  *  dot( unitVector );
 	}
@@ -250,7 +252,7 @@ public:
 	/**
 	Creates a vector that results from rotating \a this by 90 degrees counter-clockwise
 	*/
-	inline Vector2<Real> getRotated90CCW() const
+	inline MATH_CONSTEXPR Vector2<Real> getRotated90CCW() const
 	{
 		return Vector2<Real>( -y, x );
 	}
@@ -258,7 +260,7 @@ public:
 	/**
 	Creates a vector that results from rotating \a this by 90 degrees clockwise
 	*/
-	inline Vector2<Real> getRotated90CW() const
+	inline MATH_CONSTEXPR Vector2<Real> getRotated90CW() const
 	{
 		return Vector2<Real>( y, -x );
 	}
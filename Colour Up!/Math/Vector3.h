@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <complex>
 
+#include "Math/MathConstexpr.h"
 #include "Math/Axis.h"
 #include "Math/Vector2.h"
 
@@ -64,7 +65,7 @@ public:
 	
 	Creates a zero vector (0,0,0)
 	*/
-	inline Vector3() : x( (Real)0.0 ), y( (Real)0.0 ), z( (Real)0.0 )
+	inline MATH_CONSTEXPR Vector3() : x( (Real)0.0 ), y( (Real)0.0 ), z( (Real)0.0 )
 	{
 	}
 
@@ -75,7 +76,7 @@ public:
 	\param iy - y co-ordinate
 	\param iz - z co-ordinate
 	*/
-	inline Vector3(Real ix, Real iy, Real iz) : x( ix ), y( iy ), z( iz )
+	inline MATH_CONSTEXPR Vector3(Real ix, Real iy, Real iz) : x( ix ), y( iy ), z( iz )
 	{
 	}
 
@@ -83,21 +84,21 @@ public:
 	Constructor, converts from a Vector3 with a different element type e.g. converts from a Vector3 that uses floats (Vector3<float> or Vector3f)
 	to a Vector3 that uses doubles (Vector3<double> or Vector3d).
 	*/
-	template <typename S> inline Vector3(const Vector3<S> &v) : x( (Real)v.x ), y( (Real)v.y ), y( (Real)v.z )
+	template <typename S> inline MATH_CONSTEXPR Vector3(const Vector3<S> &v) : x( (Real)v.x ), y( (Real)v.y ), z( (Real)v.z )
 	{
 	}
 
 	/**
 	Constructor that builds a Vector3 from a Vector2, with z = 0
 	*/
-	inline Vector3(const Vector2<Real> &v) : x( v.x ), y( v.y ), z( (Real)0.0 )
+	inline MATH_CONSTEXPR Vector3(const Vector2<Real> &v) : x( v.x ), y( v.y ), z( (Real)0.0 )
 	{
 	}
 
 	/**
 	Constructor that builds a Vector3 from a Vector2, with z supplied as a parameter
 	*/
-	inline Vector3(const Vector2<Real> &v, Real iz) : x( v.x ), y( v.y ), z( iz )
+	inline MATH_CONSTEXPR Vector3(const Vector2<Real> &v, Real iz) : x( v.x ), y( v.y ), z( iz )
 	{
 	}
 
@@ -157,7 +158,7 @@ public:
 	/**
 	Equality comparison
 	*/
-	inline bool operator==(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR bool operator==(const Vector3<Real> &v) const
 	{
 		return ( x == v.x )  &&  ( y  ==  v.y )  &&  ( z == v.z );
 	}
@@ -165,7 +166,7 @@ public:
 	/**
 	Inequality comparison
 	*/
-	inline bool operator!=(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR bool operator!=(const Vector3<Real> &v) const
 	{
 		return ( x != v.x )  ||  ( y != v.y )  ||  ( z != v.z );
 	}
@@ -174,7 +175,7 @@ public:
 	/**
 	Addition operator:  Vector3d(a, b, c)  +  Vector3d(p, q, r)  ==  Vector3d(a+p, b+q, c+r)
 	*/
-	inline Vector3<Real> operator+(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Vector3<Real> operator+(const Vector3<Real> &v) const
 	{
 		return Vector3<Real>( x + v.x,  y + v.y,  z + v.z );
 	}
@@ -192,7 +193,7 @@ public:
 	/**
 	Subtraction operator:  Vector3d(a, b, c)  -  Vector3d(p, q, r)  =  Vector3d(a-b, p-q, c-r)
 	*/
-	inline Vector3<Real> operator-(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Vector3<Real> operator-(const Vector3<Real> &v) const
 	{
 		return Vector3( x - v.x,  y - v.y,  z - v.z );
 	}
@@ -210,7 +211,7 @@ public:
 	/**
 	Scale (multiply) a vector by a real number:  Vector3d(x, y, z) * s  ==  Vector3d(x*s, y*s, z*s)
 	*/
-	inline Vector3<Real> operator*(Real s) const
+	inline MATH_CONSTEXPR Vector3<Real> operator*(Real s) const
 	{
 		return Vector3<Real>( x * s,  y * s,  z * s );
 	}
@@ -228,7 +229,7 @@ public:
 	/**
 	Negation operator:   -Vector3d(x, y, z)  =  Vector3d(-x, -y, -z)
 	*/
-	inline Vector3<Real> operator-() const
+	inline MATH_CONSTEXPR Vector3<Real> operator-() const
 	{
 		return Vector3<Real>( -x, -y, -z );
 	}
@@ -237,7 +238,7 @@ public:
 	/**
 	Dot product:  Vector3d(a, b, c).dot(Vector3d(p, q, r))  ==  a*p + b*q + c*r
 	*/
-	inline Real dot(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Real dot(const Vector3<Real> &v) const
 	{
 		return ( x * v.x )  +  ( y * v.y )  +  ( z * v.z );
 	}
@@ -245,7 +246,7 @@ public:
 	/**
 	Cross product:  Vector3d(a, b, c).cross(Vector3d(p, q, r)) == Vector3d(b*r - c*q,  c*p - a*r,  a*q - b*p)
 	*/
-	inline Vector3<Real> cross(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Vector3<Real> cross(const Vector3<Real> &v) const
 	{
 		return Vector3<Real>( y * v.z  -  z * v.y,
 							 z * v.x  -  x * v.z,
@@ -255,7 +256,7 @@ public:
 	/**
 	Component-wise vector multiplication:  Vector3d(a, b, c).mul(Vector3d(p, q, r))  ==  Vector3d(a*p, b*q, c*r)
 	*/
-	inline Vector3<Real> mul(const Vector3<Real> &v) const
+	inline MATH_CONSTEXPR Vector3<Real> mul(const Vector3<Real> &v) const
 	{
 		return Vector3( x * v.x,  y * v.y,  z * v.z );
 	}
@@ -263,7 +264,7 @@ public:
 	/**
 	Square of length:  Vector3d(a, b, c).sqrLength()  ==  a*a + b*b + c*c  ==  |(a,b,c)|^2   
 	*/
-	inline Real sqrLength() const
+	inline MATH_CONSTEXPR Real sqrLength() const
 	{
 		return dot( *this );
 	}
@@ -325,7 +326,7 @@ public:
 	
 	v.projectOntoUnitVector(u)  ==  u * v.dot(u)
 	*/
-	inline Vector3<Real> projectOntoUnitVector(const Vector3<Real> &unitVector) const
+	inline MATH_CONSTEXPR Vector3<Real> projectOntoUnitVector(const Vector3<Real> &unitVector) const
 	{
 		return unitVector  *  dot( unitVector );
 	}
@@ -337,7 +338,7 @@ public:
 
 	v.projectOntoPlane(unitNormal)  ==  v - v.projectOntoUnitVector(unitNormal)
 	*/
-	inline Vector3<Real> projectOntoPlane(const Vector3<Real> &unitNormal) const
+	inline MATH_CONSTEXPR Vector3<Real> projectOntoPlane(const Vector3<Real> &unitNormal) const
 	{
 		return *this  -  projectOntoUnitVector( unitNormal );
 	}
@@ -666,7 +667,7 @@ public:
 	/**
 	Convert to Vector2<Real> - z-component dropped
 	*/
-	inline Vector2<Real> toVector2() const
+	inline MATH_CONSTEXPR Vector2<Real> toVector2() const
 	{
 		return Vector2<Real>( x, y );
 	}
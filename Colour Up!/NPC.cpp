@@ -2,10 +2,10 @@
 #include "CollidableObject.h"
 #include "GameObject.h"
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "BoundingBox.h"
-#include "Math\Point2.h"
+#include "Math/Point2.h"
 #include "Maths.h"
 #include "Colour.h"
 #include <iostream>
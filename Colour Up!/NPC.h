@@ -1,6 +1,6 @@
 #pragma once
 #include "CollidableObject.h"
-#include "Math\Point2.h"
+#include "Math/Point2.h"
 class BoundingBox;
 class Player : public CollidableObject 
 {
@@ -0,0 +1,46 @@
+#include "Palette.h"
+
+
+//in Color order, as AABBGGRR
+const PackedColour Palette::packedColours[COLOR_COUNT] = {
+	0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0xFF000000u, 0xFFFFFFFFu, 0xFFFFFF00u, 0xFFFF00FFu, 0xFF00FFFFu
+};
+
+
+//a * b / 255, rounded
+static inline unsigned int mul255(unsigned int a, unsigned int b){
+	unsigned int t = a * b + 128;
+	return (t + (t >> 8)) >> 8;
+}
+
+PackedColour Palette::pack(unsigned int r, unsigned int g, unsigned int b, unsigned int a){
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+PackedColour Palette::pack(const GLfloat *rgb){
+	unsigned int channels[3];
+	for (int c = 0; c < 3; c++){
+		float value = rgb[c];
+		if (value < 0) value = 0;
+		if (value > 1) value = 1;
+		channels[c] = (unsigned int)(value * 255 + 0.5f);
+	}
+	return pack(channels[0], channels[1], channels[2], 255);
+}
+
+PackedColour Palette::premultiply(PackedColour p){
+	unsigned int a = alpha(p);
+	return pack(mul255(red(p), a), mul255(green(p), a), mul255(blue(p), a), a);
+}
+
+PackedColour Palette::premultiplied(Color c, unsigned int alpha){
+	PackedColour p = packed(c);
+	return premultiply(pack(red(p), green(p), blue(p), alpha));
+}
+
+void Palette::unpack(PackedColour p, GLfloat *rgba){
+	rgba[0] = red(p) / 255.0f;
+	rgba[1] = green(p) / 255.0f;
+	rgba[2] = blue(p) / 255.0f;
+	rgba[3] = alpha(p) / 255.0f;
+}
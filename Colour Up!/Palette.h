@@ -0,0 +1,42 @@
+#pragma once
+#include <windows.h>
+#include <GL/gl.h>
+#include "Colour.h"
+
+/*
+	The game's eight colours, packed.
+
+	A PackedColour is RGBA8 with red in the lowest byte, the layout of the
+	software framebuffer and of PNG rows, so it can be stored straight into a
+	frame without converting. Colour commands in the CommandBuffer carry one
+	of these rather than three floats.
+
+	Every entry in the table is opaque. premultiplied() gives a see-through
+	variant with rgb already scaled by alpha, for blending with
+	GL_ONE, GL_ONE_MINUS_SRC_ALPHA.
+*/
+typedef unsigned int PackedColour;
+
+class Palette
+{
+public:
+	//Color -> RGBA8, opaque
+	static PackedColour packed(Color c) { return packedColours[c]; }
+	//rgb scaled by alpha, alpha 0..255
+	static PackedColour premultiplied(Color, unsigned int alpha);
+
+	//rgb floats (clamped to 0..1) -> RGBA8, opaque
+	static PackedColour pack(const GLfloat*);
+	static PackedColour pack(unsigned int r, unsigned int g, unsigned int b, unsigned int a);
+	static PackedColour premultiply(PackedColour);
+
+	static unsigned int red(PackedColour p) { return p & 0xFF; }
+	static unsigned int green(PackedColour p) { return (p >> 8) & 0xFF; }
+	static unsigned int blue(PackedColour p) { return (p >> 16) & 0xFF; }
+	static unsigned int alpha(PackedColour p) { return p >> 24; }
+	//RGBA8 -> rgba floats
+	static void unpack(PackedColour, GLfloat*);
+
+private:
+	static const PackedColour packedColours[COLOR_COUNT];
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+	What the game loop in main.cpp needs from the operating system: a window
+	with a GL context (or none), its input as events, a clock and a swap.
+
+	Win32Platform is the Windows build, GlutPlatform the windowed Linux build
+	and HeadlessPlatform runs with no window at all, replaying a script.
+*/
+
+struct PlatformEvent {
+	enum Type {
+		QUIT,
+		KEY_DOWN, KEY_UP,		//key is a VK_ code, same as the keys[] index
+		MOUSE_DOWN, MOUSE_UP,	//left button only, x and y like MOUSE_MOVE
+		MOUSE_MOVE,				//window pixels, y up from the bottom edge
+		RESIZE,					//x and y are the new client size
+		EXPOSE					//the window's contents were lost, draw again
+	};
+
+	Type type;
+	int key;
+	int x, y;
+	//now() when it happened, as close as the platform can tell
+	double time;
+};
+
+class Platform
+{
+public:
+	virtual ~Platform(){}
+
+	//the context (if any) is current when this returns true
+	virtual bool createWindow(const char *title, int width, int height) = 0;
+	virtual void destroyWindow() = 0;
+
+	//next pending event, false once there are none left for now
+	virtual bool pollEvent(PlatformEvent&) = 0;
+	virtual void swapBuffers() = 0;
+
+	//seconds since some fixed point, only differences mean anything
+	virtual double now() = 0;
+	//coarse, can overshoot by the scheduler's granularity (see FramePacer)
+	virtual void sleep(double seconds) = 0;
+	//true when now() only moves when sleep() or swapBuffers() move it
+	virtual bool clockIsVirtual() const { return false; }
+
+	//ask for the swap to wait for vertical blank, true if it now does
+	virtual bool setVSync(bool) = 0;
+	//of the display the window is on, 0 if unknown
+	virtual double refreshRate() = 0;
+
+	//whether the GL context can be released by one thread and made current
+	//on another, which the render thread needs to lend it to the simulation
+	//while an activity loads its textures
+	virtual bool canMoveContext() const { return true; }
+	//bind the context to the calling thread, or release it from it
+	virtual void makeCurrent(bool){}
+};
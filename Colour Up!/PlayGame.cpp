@@ -17,10 +17,27 @@ PlayGame::~PlayGame()
 
 void PlayGame::init(){
 	turnOn();
+	resetState();
+
+	our_font.init("pier.otf", 22);					    //Build the freetype font
+	//initialise all keys to false
+	for (int i = 0; i < 256; i++){
+		keys[i] = false;
+	}
+
+	createLevel();
+	prepareLevel();
+	createPlayer();
+	std::cout << "BG: [C]YAN [M]AGENTA [Y]ELLOW BLACK[K]" << std::endl;
+
+}
+
+//scores, timers and flags back to the start of a run
+void PlayGame::resetState(){
 	heightScore = 0;
 	totalScore = 0;
 	pickUpScore = 0;
-	bgColor = BLACK;
+	setBGColour(BLACK);
 	timeScore = 0;
 	onMovingY = false;
 	startingPosition = Point2<float>(100, -70);
@@ -34,18 +51,20 @@ void PlayGame::init(){
 	bgChangeTimeLimit = 0.8;
 	allowedToChangeBG = true;
 	gravityModified = false;
+}
 
-
-	our_font.init("pier.otf", 22);					    //Build the freetype font
-	//initialise all keys to false
-	for (int i = 0; i < 256; i++){
-		keys[i] = false;
+//spawn the obstacle list, once it's been filled in, and build everything derived from it
+void PlayGame::prepareLevel(){
+	world.clear();
+	entities.clear();
+	for (size_t o = 0; o < obstacles.size(); o++){
+		entities.push_back(spawnObstacle(world, obstacles[o]));
 	}
 
-	createLevel();
-	createPlayer();
-	std::cout << "BG: [C]YAN [M]AGENTA [Y]ELLOW BLACK[K]" << std::endl;
-
+	staticGeometry.bake(world, entities);
+	colourLayers.assign(world, entities);
+	colourLayers.resetStats();
+	contacts.reserve(entities.size());
 }
 
 void PlayGame::playerDied(void){
@@ -55,7 +74,15 @@ void PlayGame::playerDied(void){
 	
 }
 
+//one fixed step; split in three so the sweep can time the collision pass on its own
 void PlayGame::update(const double dt){
+	beginUpdate(dt);
+	checkForCollision(dt);
+	endUpdate(dt);
+}
+
+//scores and timers, input, the obstacles' move and the player's new speed
+void PlayGame::beginUpdate(const double dt){
 	timeScore += dt * ((gravityModified) ? 10 : 2);
 	calculateScore();
 
@@ -75,7 +102,7 @@ void PlayGame::update(const double dt){
 		allowedToChangeBG = false;
 	}
 	if (timeElapsed >= bgChangeTimeLimit){
-		bgColor = BLACK;
+		setBGColour(BLACK);
 		allowedToChangeBG = true;
 	}
 
@@ -83,37 +110,54 @@ void PlayGame::update(const double dt){
 		playerDied();
 	}
 
-	updateBlending();
 	//PREDICT NEXT MOVE AND CHECK COLLISION
 	updateInput();
-	for (int o = 0; o<obstacles.size(); o++){
-
-			obstacles[o].move(dt);
-
-			
-		}
+	moveObstacles(world, dt);
+	colourLayers.update(world);
 	
 	player.getNewSpeed(dt);
-	checkForCollision(dt);
+}
+
+//what the collision pass found, the player's move and whatever the floor swallowed
+void PlayGame::endUpdate(const double dt){
+	respondToContacts();
 	player.move(dt);
 
 
-	bool remove;
-	cloudY = obstacles[obstacles.size() - 3].y + 20;
-	std::vector<CollidableObject>::iterator i = obstacles.begin();
-	while (i != obstacles.end() - 3)
-	{
-		remove = (*i).toRemove;
-		 
-		if ((remove || (*i).y <= cloudY) && !(*i).player)
+	//the rising floor swallows what it passes, picked up things go too
+	float floorY = 0;
+	world.each<Transform>(maskOf<Rise>(), [&floorY](Entity, Transform &transform){
+		floorY = transform.y;
+	});
+	cloudY = floorY + 20;
+
+	bool rebake = false;
+	bool erased = false;
+	size_t kept = 0;
+	for (size_t o = 0; o < entities.size(); o++){
+		Entity e = entities[o];
+		ComponentMask kind = world.componentsOf(e);
+		bool remove = (kind & maskOf<Pickup>()) && world.get<Pickup>(e).collected;
+
+		if ((remove || world.get<Transform>(e).y <= cloudY) && !(kind & maskOf<Permanent, Rise>()))
 		{
-			i = obstacles.erase(i);
+			rebake = rebake || (kind & maskOf<Static>());
+			erased = true;
+			world.destroy(e);
 		}
 		else
 		{
-			++i;
+			entities[kept++] = e;
 		}
 	}
+	entities.resize(kept);
+	//only happens as the floor swallows platforms, not every tick
+	if (rebake){
+		staticGeometry.bake(world, entities);
+	}
+	if (erased){
+		colourLayers.assign(world, entities);
+	}
 
 	onMovingY = false;
 
@@ -126,39 +170,68 @@ void PlayGame::update(const double dt){
 }
 
 void PlayGame::drawGrid(){
-	glPushMatrix();
-	glTranslated(-100, -100, 0);
-	glBegin(GL_LINES);
+	commandBuffer.pushMatrix();
+	commandBuffer.translate(-100, -100);
+	commandBuffer.begin(PRIM_LINES);
 	for (int i = 0; i <= screenWidth; i += 10)
 	{
-		glVertex3f((float)i, 0.0f, 0.0f);
-		glVertex3f((float)i, screenWidth, 0.0f);
-		glVertex3f(0.0f, (float)i, 0.0f);
-		glVertex3f(screenWidth, (float)i, 0.0f);
+		commandBuffer.vertex((float)i, 0.0f);
+		commandBuffer.vertex((float)i, screenWidth);
+		commandBuffer.vertex(0.0f, (float)i);
+		commandBuffer.vertex(screenWidth, (float)i);
 	}
-	glEnd();
-	glPopMatrix();
+	commandBuffer.popMatrix();
 }
 
 void PlayGame::draw(){
 	
 	displayBG();
-	glPushMatrix();
-		glLoadIdentity();
-		glTranslated(-player.x, -player.y, 0);
+	commandBuffer.pushMatrix();
+		commandBuffer.loadIdentity();
+		commandBuffer.translate(-player.x, -player.y);
 		
-		for (int o = 0; o<obstacles.size(); o++){
-			
-				obstacles[o].draw();
-			
+		//only submit what intersects the camera window
+		queryVisible(visibleSet);
+		staticGeometry.draw(camera);
+		for (size_t v = 0; v < visibleSet.size(); v++){
+			Entity e = entities[visibleSet[v]];
+			drawSprite(world.get<Transform>(e), world.get<AABB>(e), world.get<Sprite>(e));
 		}
 		player.draw();
 		//drawGrid();
-	glPopMatrix();
+	commandBuffer.popMatrix();
 	
 	print(our_font, screenWidth / 2.0, screenHeight * 9/10 , "SCORE: %d", totalScore);
-	glPopMatrix();
-	glFlush();
+}
+
+//Collect the obstacles that intersect the view rectangle around the player
+void PlayGame::queryVisible(vector<int> &visible){
+	visible.clear();
+	camera.resetStats();
+	camera.centreOn(player.x, player.y);
+
+	//bucket by bucket so same-coloured objects are submitted together, and only
+	//the ones whose bounding circle reaches the view go on to the box test;
+	//the blended layer is still drawn, its scanlines show over the matching bg
+	unsigned int streamed = 0;
+	for (int l = 0; l < LAYER_COUNT; l++){
+		colourLayers.overlapping((ColourLayer)l, camera.x, camera.y, camera.halfWidth, camera.halfHeight, 0, nearSet);
+		for (size_t n = 0; n < nearSet.size(); n++){
+			int o = nearSet[n];
+			Entity e = entities[o];
+			//baked platforms go through staticGeometry
+			if (world.has(e, maskOf<Static>())){
+				continue;
+			}
+			streamed++;
+			if (camera.isVisible(world.get<Transform>(e), world.get<AABB>(e))){
+				visible.push_back(o);
+			}
+		}
+	}
+
+	camera.submitted = visible.size();
+	camera.culled = streamed - visible.size();
 }
 
 void PlayGame::updateInput(){
@@ -241,17 +314,53 @@ void PlayGame::updateInput(){
 
 }
 
+//level sizes, and the glitch columns at the top of the tower, built at compile time where the compiler can
+static MATH_CONSTEXPR Point2f LEVEL_WALL(400, 10000);
+static MATH_CONSTEXPR Point2f LEVEL_PLATFORM_NORMAL(60, 20);
+static MATH_CONSTEXPR Point2f LEVEL_SQUARE(20, 20);
+
+struct GlitchColumn{
+	Point2f dimensions;
+	Point2f position;
+	Color colour;
+};
+
+static MATH_CONSTEXPR Point2f GLITCH_THIN(20, 320);
+static MATH_CONSTEXPR Point2f GLITCH_WIDE(80, 320);
+static MATH_CONSTEXPR Vector2f GLITCH_STEP(70, 0);
+static MATH_CONSTEXPR Point2f GLITCH_THIN_START(-90 + 10, 830);
+static MATH_CONSTEXPR Point2f GLITCH_WIDE_START(-90, 1120);
+
+static const MATH_CONSTEXPR GlitchColumn glitchColumns[] = {
+	{ GLITCH_THIN, GLITCH_THIN_START, YELLOW },
+	{ GLITCH_THIN, GLITCH_THIN_START + GLITCH_STEP, CYAN },
+	{ GLITCH_THIN, GLITCH_THIN_START + GLITCH_STEP * 2, MAGENTA },
+	{ GLITCH_THIN, GLITCH_THIN_START + GLITCH_STEP * 3, YELLOW },
+	{ GLITCH_THIN, GLITCH_THIN_START + GLITCH_STEP * 4, CYAN },
+	{ GLITCH_THIN, GLITCH_THIN_START + GLITCH_STEP * 5, MAGENTA },
+	{ GLITCH_WIDE, GLITCH_WIDE_START, YELLOW },
+	{ GLITCH_WIDE, GLITCH_WIDE_START + GLITCH_STEP, CYAN },
+	{ GLITCH_WIDE, GLITCH_WIDE_START + GLITCH_STEP * 2, MAGENTA },
+	{ GLITCH_WIDE, GLITCH_WIDE_START + GLITCH_STEP * 3, YELLOW },
+	{ GLITCH_WIDE, GLITCH_WIDE_START + GLITCH_STEP * 4, CYAN },
+	{ GLITCH_WIDE, GLITCH_WIDE_START + GLITCH_STEP * 5, MAGENTA },
+};
+
+#ifdef MATH_HAS_CONSTEXPR
+static_assert(glitchColumns[5].position == Point2f(260 + 10, 830), "glitch columns moved");
+static_assert(glitchColumns[11].position == Point2f(260, 1120), "glitch columns moved");
+#endif
+
 void PlayGame::createLevel(){
 	obstacles.clear();
 
 	//DEPENDS ON THE LEVEL I GUESS
-	bgColor = BLACK;
+	setBGColour(BLACK);
 	//FRAME
 	
-	dimensionsVertical = Point2<float>(400, 10000);
-	Point2f platformDimNormal = Point2<float>(60, 20);
-	Point2f platformDimSmall = Point2<float>(40, 20);
-	Point2f square = Point2<float>(20, 20);
+	dimensionsVertical = LEVEL_WALL;
+	const Point2f &platformDimNormal = LEVEL_PLATFORM_NORMAL;
+	const Point2f &square = LEVEL_SQUARE;
 
 	death = loadPNG("Enemy_alpha_standard.png");
 
@@ -264,7 +373,7 @@ void PlayGame::createLevel(){
 	CollidableObject floor = CollidableObject(Point2f(400, 20), Point2<float>(100, -90), CollidableObject::PLATFORM);
 	obstacles.push_back(floor);
 	CollidableObject wallLeft = CollidableObject(dimensionsVertical, Point2<float>(-300, 0), CollidableObject::PLATFORM);
-	wallLeft.player = true;
+	wallLeft.permanent = true;
 	
 	
 
@@ -274,8 +383,8 @@ void PlayGame::createLevel(){
 	obstacles.push_back(platform1);
 	CollidableObject enemy1 = CollidableObject(square, Point2<float>(0, 0), CollidableObject::ENEMY);
 	enemy1.setTexture(alphaRight);
-	enemy1.textures[0] = alphaRight;
-	enemy1.textures[1] = alphaLeft;
+	enemy1.sprite.facing[0] = alphaRight;
+	enemy1.sprite.facing[1] = alphaLeft;
 	enemy1.setSpeedMod(10);
 	enemy1.tieNPCtoPlatform(platform1);
 	obstacles.push_back(enemy1);
@@ -465,72 +574,17 @@ void PlayGame::createLevel(){
 	obstacles.push_back(platform32);
 
 
-	CollidableObject lastBit0 = CollidableObject(Point2<float>(20, 320), Point2<float>(-90 + 10, 830), CollidableObject::PLATFORM);
-	lastBit0.setColour(YELLOW);
-	lastBit0.setTexture(glitch);
-	obstacles.push_back(lastBit0);
-
-	CollidableObject lastBit1 = CollidableObject(Point2<float>(20, 320), Point2<float>(-20 + 10, 830), CollidableObject::PLATFORM);
-	lastBit1.setColour(CYAN);
-	lastBit1.setTexture(glitch);
-	obstacles.push_back(lastBit1);
-
-	CollidableObject lastBit2 = CollidableObject(Point2<float>(20, 320), Point2<float>(50 + 10, 830), CollidableObject::PLATFORM);
-	lastBit2.setColour(MAGENTA);
-	lastBit2.setTexture(glitch);
-	obstacles.push_back(lastBit2);
-
-	CollidableObject lastBit3 = CollidableObject(Point2<float>(20, 320), Point2<float>(120 + 10, 830), CollidableObject::PLATFORM);
-	lastBit3.setColour(YELLOW);
-	lastBit3.setTexture(glitch);
-	obstacles.push_back(lastBit3);
-
-	CollidableObject lastBit4 = CollidableObject(Point2<float>(20, 320), Point2<float>(190 + 10, 830), CollidableObject::PLATFORM);
-	lastBit4.setColour(CYAN);
-	lastBit4.setTexture(glitch);
-	obstacles.push_back(lastBit4);
-
-	CollidableObject lastBit5 = CollidableObject(Point2<float>(20, 320), Point2<float>(260 + 10, 830), CollidableObject::PLATFORM);
-	lastBit5.setColour(MAGENTA);
-	lastBit5.setTexture(glitch);
-	obstacles.push_back(lastBit5);
-
-
-
-
-	CollidableObject lastBit01 = CollidableObject(Point2<float>(80, 320), Point2<float>(-90, 1120), CollidableObject::PLATFORM);
-	lastBit01.setColour(YELLOW);
-	lastBit01.setTexture(glitch);
-	obstacles.push_back(lastBit01);
-
-	CollidableObject lastBit11 = CollidableObject(Point2<float>(80, 320), Point2<float>(-20, 1120), CollidableObject::PLATFORM);
-	lastBit11.setColour(CYAN);
-	lastBit11.setTexture(glitch);
-	obstacles.push_back(lastBit11);
-
-	CollidableObject lastBit21 = CollidableObject(Point2<float>(80, 320), Point2<float>(50, 1120), CollidableObject::PLATFORM);
-	lastBit21.setColour(MAGENTA);
-	lastBit21.setTexture(glitch);
-	obstacles.push_back(lastBit21);
-
-	CollidableObject lastBit31 = CollidableObject(Point2<float>(80, 320), Point2<float>(120, 1120), CollidableObject::PLATFORM);
-	lastBit31.setColour(YELLOW);
-	lastBit31.setTexture(glitch);
-	obstacles.push_back(lastBit31);
-
-	CollidableObject lastBit41 = CollidableObject(Point2<float>(80, 320), Point2<float>(190, 1120), CollidableObject::PLATFORM);
-	lastBit41.setColour(CYAN);
-	lastBit41.setTexture(glitch);
-	obstacles.push_back(lastBit41);
-
-	CollidableObject lastBit51 = CollidableObject(Point2<float>(80, 320), Point2<float>(260 , 1120), CollidableObject::PLATFORM);
-	lastBit51.setColour(MAGENTA);
-	lastBit51.setTexture(glitch);
-	obstacles.push_back(lastBit51);
+	//the striped glitch columns at the top
+	for (unsigned int i = 0; i < sizeof(glitchColumns) / sizeof(glitchColumns[0]); i++){
+		CollidableObject column = CollidableObject(glitchColumns[i].dimensions, glitchColumns[i].position, CollidableObject::PLATFORM);
+		column.setColour(glitchColumns[i].colour);
+		column.setTexture(glitch);
+		obstacles.push_back(column);
+	}
 
 
 	CollidableObject wallRight = CollidableObject(dimensionsVertical, Point2<float>(490, 0), CollidableObject::PLATFORM);
-	wallRight.player = true;
+	wallRight.permanent = true;
 	
 	hsvTex = loadPNG("hsv.png");
 	CollidableObject HSV = CollidableObject(Point2<float>(40, 40), Point2<float>(180 - 10, 520 + 420), CollidableObject::HSV);
@@ -548,6 +602,22 @@ void PlayGame::createLevel(){
 	
 }
 
+//a procedural tower instead of the hand-built one
+void PlayGame::createGeneratedLevel(unsigned int seed, int platforms){
+	TowerSettings settings(seed, platforms);
+	settings.textures.glitch = loadPNG("scanLine2.png");
+	settings.textures.enemyLeft = loadPNG("Enemy_alpha_small_left.png");
+	settings.textures.enemyRight = loadPNG("Enemy_alpha_small_right.png");
+	settings.textures.lambda = loadPNG("color_powerup_2_alpha.png");
+	settings.textures.cmyk = loadPNG("color_powerup_pixel.png");
+	settings.textures.death = loadPNG("Enemy_alpha_standard.png");
+	settings.textures.hsv = loadPNG("hsv.png");
+
+	setBGColour(BLACK);
+	TowerGenerator generator;
+	generator.generate(settings, obstacles);
+}
+
 void PlayGame::createPlayer(void){
 	player = Player(Point2<float>(20, 20), startingPosition);
 	player.textures[0] = loadPNG("char_idle_k.png");
@@ -584,8 +654,13 @@ void PlayGame::checkForCollision(const double dt){
 
 
 
-	//LOOP THROUGH ALL OBSTACLES
-	for (int i = 0; i < obstacles.size(); i++){
+	contacts.clear();
+
+	//LOOP THROUGH THE OBSTACLES NEAR THE PLAYER THAT AREN'T BLENDED INTO THE BG
+	queryCollidable(0, dt);
+	//signed: a push starts the walk again from c = -1
+	for (int c = 0; c < (int)collisionSet.size(); c++){
+		int i = collisionSet[c];
 
 		bbtemp.x = player.x;
 		bbtemp.y = player.y;
@@ -593,11 +668,12 @@ void PlayGame::checkForCollision(const double dt){
 		//TRANSLATE BY TEMP NEW SPEED
 		bbtemp.translate(player.newSpeedX, player.newSpeedY, dt);
 
-		//create an alias
-		BoundingBox &otherBB = obstacles[i].bB;
+		//the obstacle's box where it is now
+		Entity other = entities[i];
+		BoundingBox otherBB = BoundingBox(world.get<Transform>(other), world.get<AABB>(other));
 
-		//CHECK FOR COLLISION (PROVIDING THE OBSTACLE IS NOT BLENDED)
-		if (bbtemp.collide(otherBB) && !obstacles[i].blended)
+		//CHECK FOR COLLISION
+		if (bbtemp.collide(otherBB))
 		{
 
 			/*
@@ -692,43 +768,18 @@ void PlayGame::checkForCollision(const double dt){
 			*/
 
 			//MODIFY SPEED
+			float oldSpeedX = player.newSpeedX, oldSpeedY = player.newSpeedY;
 			player.modifySpeed(pushDistRight, pushDistLeft, pushDistDown, pushDistUp, dt);
-			if (player.y > obstacles[i].y && obstacles[i].platformType != CollidableObject::ENEMY  && obstacles[i].platformType != CollidableObject::ALPHAFLOOR){
-					getHeight(obstacles[i]);
-				}
-
-			switch (obstacles[i].platformType){
-			case CollidableObject::HSV:
-				win = true;
-				player.die();
-				break;
-			case CollidableObject::MOVINGY:
-					onMovingY = true;
-					break;
-			case CollidableObject::DEADLYPLATFORM:
-				player.die();
-				break;
-			case CollidableObject::ALPHAFLOOR:
-				player.die();
-			case CollidableObject::MOVINGX:
-				player.x += obstacles[i].speed;
-				break;
-			case CollidableObject::ENEMY:
-				player.die();
-				break;
-			case CollidableObject::LAMBDA:
-				pickUpScore += 100;
-				obstacles[i].stopDisplaying();
-				break;
-			case CollidableObject::CMYK:
-				
-				player.jumpStartSpeedY = player.jumpStartSpeedY * 1.5;
-				gravityModified = true;
-				obstacles[i].stopDisplaying();
-				break;
-			
-			}
 
+			//what the contact does is handled in respondToContacts
+			contacts.push(other, world.componentsOf(other));
+
+			//the push moved the box, so what's near it has to be picked out again
+			//for the obstacles still to come
+			if (player.newSpeedX != oldSpeedX || player.newSpeedY != oldSpeedY){
+				queryCollidable(i + 1, dt);
+				c = -1;
+			}
 		}
 
 		
@@ -736,21 +787,78 @@ void PlayGame::checkForCollision(const double dt){
 	}
 }
 
-void PlayGame::updateBlending(){
-	setBGColour(bgColor);
-	for (int i = 0; i < obstacles.size(); i++){
-		obstacles[i].checkBlending(bgColor);
+//Collect the obstacles from first on, in solid layers, whose bounding circle reaches
+//the player's box moved by this tick's speed (ascending, the order they're tested in)
+void PlayGame::queryCollidable(int first, const double dt){
+	BoundingBox predicted = BoundingBox(player.bB.width, player.bB.height);
+	predicted.x = player.x;
+	predicted.y = player.y;
+	predicted.translate(player.newSpeedX, player.newSpeedY, dt);
+
+	colourLayers.collidable(predicted.x, predicted.y, predicted.halfWidth, predicted.halfHeight, first, collisionSet);
+}
+
+//Apply the effects of this tick's contacts, going by what they're tagged with
+void PlayGame::respondToContacts(){
+	const vector<Entity> &hit = contacts.contacts;
+	const vector<ComponentMask> &kinds = contacts.kinds;
+
+	//HEIGHT SCORE: the last thing stood on (player.y doesn't change until player.move)
+	for (size_t c = 0; c < hit.size(); c++){
+		const Transform &other = world.get<Transform>(hit[c]);
+		if (player.y > other.y && !(kinds[c] & maskOf<NoHeight>())){
+			getHeight(other);
+		}
+	}
+
+	//GOAL
+	if (contacts.any(maskOf<Goal>())){
+		win = true;
+	}
+
+	//DEATH, only once however many deadly things were touched
+	if (contacts.any(maskOf<Deadly>())){
+		player.die();
+	}
+
+	//MOVING PLATFORMS
+	if (contacts.any(maskOf<Lift>())){
+		onMovingY = true;
+	}
+	for (size_t c = 0; c < hit.size(); c++){
+		if (kinds[c] & maskOf<Carrier>()){
+			player.x += world.get<Motion>(hit[c]).speed;
+		}
+	}
+
+	//PICKUPS, each one counted once even if it's hit again before it's erased;
+	//several power ups in one tick give a single boost
+	bool boosted = false;
+	for (size_t c = 0; c < hit.size(); c++){
+		if (!(kinds[c] & maskOf<Pickup>())){
+			continue;
+		}
+		Pickup &pickup = world.get<Pickup>(hit[c]);
+		if (!pickup.collected){
+			pickUpScore += pickup.score;
+			boosted = boosted || (kinds[c] & maskOf<PowerUp>());
+			pickup.collected = true;
+		}
+	}
+	if (boosted){
+		player.jumpStartSpeedY = player.jumpStartSpeedY * 1.5;
+		gravityModified = true;
 	}
 }
 
-void PlayGame::getHeight(CollidableObject &platform){
+void PlayGame::getHeight(const Transform &platform){
 	heightScore = platform.y + 100;
 }
 
 void PlayGame::switchBG(Color newBG){
 	if (allowedToChangeBG){
 		timeElapsed = 0;
-		bgColor = newBG;
+		setBGColour(newBG);
 		bgChanged = true;
 	}
 }
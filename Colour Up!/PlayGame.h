@@ -1,5 +1,11 @@
 #pragma once
 #include "Activity.h"
+#include "StaticGeometry.h"
+#include "ColourLayers.h"
+#include "ContactQueue.h"
+#include "TowerGenerator.h"
+#include "World.h"
+#include "Systems.h"
 
 using namespace freetype;
 class PlayGame :
@@ -12,27 +18,41 @@ public:
 	void draw();
 	void init();
 	void update(const double dt);
+	void beginUpdate(const double dt);
+	void endUpdate(const double dt);
 	void updateInput();
 	void	drawGrid();
 	void				createLevel();
+	void				createGeneratedLevel(unsigned int, int);
+	void				prepareLevel();
+	void				resetState();
 	void				createPlayer();
-	void				updateBlending();
 	void				checkForCollision(const double);
+	void				respondToContacts();
+	void				queryVisible(vector<int>&);
+	void				queryCollidable(int, const double);
 	void playerDied();
-	void getHeight(CollidableObject&);
+	void getHeight(const Transform&);
 	void switchBG(enum Color);
 	bool onMovingY;
 	void calculateScore();
 	bool				gravityModified;
 	Player				player;
-	vector<CollidableObject> obstacles;
+	vector<CollidableObject> obstacles;	//the level as built, prepareLevel spawns it into world
+	World				world;			//the obstacles while the level runs
+	vector<Entity>		entities;		//world's obstacles in level order, what the sets below index
+	vector<int>			visibleSet;		//obstacles inside the camera, rebuilt every draw
+	StaticGeometry		staticGeometry;	//platforms baked at level load
+	ColourLayers		colourLayers;	//obstacles by colour with a broad phase each, the bg colour's layer is blended away
+	vector<int>			nearSet;		//what the last colourLayers query returned
+	vector<int>			collisionSet;	//obstacles in solid layers near the player's box, rebuilt every tick
+	ContactQueue		contacts;		//what the player hit this tick
 	GLuint				characterTex, alphaLeft, alphaRight, hsvTex;
 	GLuint				death;
 	GLuint				lambdaTex;
 	GLuint				CMYKtex;
 	GLuint				glitch;
 	int					cloudY;
-	Color				bgColor; 
 	Point2f				startingPosition;
 	Point2f				dimensionsHorizontal;
 	Point2f				dimensionsVertical;
@@ -4,8 +4,8 @@
 #include "PlayState.h"
 
 #include <windows.h>		// Header file for Windows
-#include <gl\gl.h>			// Header file for the OpenGL32 Library
-#include <gl\glu.h>			// Header file for the GLu32 Library
+#include <GL/gl.h>			// Header file for the OpenGL32 Library
+#include <GL/glu.h>			// Header file for the GLu32 Library
 
 #include "Platform.h"
 #include "NonPlayerCharacter.h"
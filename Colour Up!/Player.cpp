@@ -1,11 +1,10 @@
 #include "Player.h"
-#include "CollidableObject.h"
 #include "GameObject.h"
 #include <windows.h>		// Header File For Windows
-#include <gl\gl.h>			// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "BoundingBox.h"
-#include "Math\Point2.h"
+#include "Math/Point2.h"
 #include "Maths.h"
 #include "Colour.h"
 #include <iostream>
@@ -17,17 +16,20 @@ Player::Player(void)
 	
 }
 
-void Player::toString(){
-	std::cout<<"PLAYER"<<std::endl;
-}
-
 
 Player::~Player(void)
 {
 }
 
 //Bounding Box + X and Y 
-Player::Player(Point2<float> dimensions, Point2<float> coordinates) : CollidableObject(dimensions, coordinates){
+Player::Player(Point2<float> dimensions, Point2<float> coordinates) : GameObject(coordinates){
+	this->bB = BoundingBox(dimensions.x, dimensions.y);
+	setSize(dimensions.x, dimensions.y);
+
+	//set the coordinates for the bounding box
+	this->bB.y = y;
+	this->bB.x = x;
+
 	initialise();
 	player = true;	
 }
@@ -185,14 +187,6 @@ void Player::move(double dt){
 }
 
 
-//OVERRIDEN
-bool Player::collide(CollidableObject& other){
-	
-	return this->bB.collide(other.bB);
-
-
-}
-
 void Player::resetRequests(){
 	this->moveRequestDown = false;
 	this->moveRequestUp = false;
@@ -222,7 +216,6 @@ void Player::initialise(){
 	newSpeedY = currentSpeedY  = 0.f;
 
 	jumping = false;
-	blended = false;
 
 	alive = true;
 	livesCount = 3;
@@ -1,8 +1,8 @@
 #pragma once
-#include "CollidableObject.h"
-#include "Math\Point2.h"
-class BoundingBox;
-class Player : public CollidableObject 
+#include "GameObject.h"
+#include "BoundingBox.h"
+#include "Math/Point2.h"
+class Player : public GameObject 
 {
 public:
 	enum Action{
@@ -50,6 +50,9 @@ public:
 
 	GLuint textures[6];
 	bool applyGravity;
+
+	//follows x,y; the only box that moves with its owner rather than being worked out
+	BoundingBox bB;
 	
 
 	Player(void);
@@ -64,14 +67,12 @@ public:
 	void modifySpeed(float, float, float, float, double);
 	void reset(Point2f checkpoint);
 	
-	bool collide(CollidableObject&);
 	void resetRequests();
 	void initialise();
 	void die();
 	void changeTexture(enum Action);
 	void translate(float, float, double);
 
-	void toString();
 	void switchGravity();
 };
 
@@ -0,0 +1,122 @@
+#include "RenderBackend.h"
+#include "Palette.h"
+#include <string>
+#include <sstream>
+
+
+static const char* commandNames[] = {
+	"CLEAR", "LOAD_IDENTITY", "PUSH_MATRIX", "POP_MATRIX", "TRANSLATE", "COLOUR", "DRAW", "TEXT", "BATCH"
+};
+
+static const char* primitiveNames[] = {
+	"POLYGON", "QUADS", "LINE_LOOP", "LINES"
+};
+
+
+//-----NULL-----//
+
+NullRenderBackend::NullRenderBackend(){
+	frames = commands = vertices = 0;
+}
+
+void NullRenderBackend::execute(const CommandBuffer &buffer){
+	frames++;
+	for (unsigned int i = 0; i < buffer.commands.size(); i++){
+		const RenderCommand &command = buffer.commands[i];
+		commands++;
+		if (command.type == CMD_DRAW || command.type == CMD_BATCH){
+			vertices += command.count;
+		}
+	}
+}
+
+
+//-----RECORDING-----//
+
+RecordingRenderBackend::RecordingRenderBackend(){
+	frameLimit = 0;
+}
+
+void RecordingRenderBackend::execute(const CommandBuffer &buffer){
+	if (frameLimit && frames.size() >= frameLimit){
+		frames.erase(frames.begin());
+	}
+	frames.push_back(buffer);
+}
+
+void RecordingRenderBackend::setFrameLimit(unsigned int limit){
+	frameLimit = limit;
+}
+
+static void dumpCommand(const CommandBuffer &buffer, const RenderCommand &command, std::ostream &out){
+	out << commandNames[command.type];
+
+	switch (command.type){
+	case CMD_CLEAR:
+	case CMD_COLOUR:
+	{
+		GLfloat rgba[4];
+		Palette::unpack(command.first, rgba);
+		out << " " << rgba[0] << " " << rgba[1] << " " << rgba[2];
+		break;
+	}
+	case CMD_TRANSLATE:
+		out << " " << command.f[0] << " " << command.f[1];
+		break;
+	case CMD_DRAW:
+	case CMD_BATCH:
+	{
+		out << " " << primitiveNames[command.primitive];
+		if (command.textured){
+			out << " tex=" << command.texture << ((command.textureMode == TEX_REPLACE) ? " REPLACE" : " MODULATE");
+		}
+		//a baked batch can be empty (nothing of that colour/texture in the chunk)
+		if (command.count == 0){
+			break;
+		}
+		const RenderVertex *verts = (command.type == CMD_BATCH) ? &buffer.batches[command.first]->vertices[0] : &buffer.vertices[command.first];
+		for (unsigned int v = 0; v < command.count; v++){
+			const RenderVertex &vert = verts[v];
+			out << " (" << vert.x << "," << vert.y;
+			if (command.textured){
+				out << " " << vert.u << "," << vert.v;
+			}
+			out << ")";
+		}
+		break;
+	}
+	case CMD_TEXT:
+		out << " font=" << command.texture << " " << command.f[0] << " " << command.f[1] << " \""
+			<< std::string(buffer.characters.begin() + command.first, buffer.characters.begin() + command.first + command.count) << "\"";
+		break;
+	default:
+		break;
+	}
+}
+
+void RecordingRenderBackend::dump(const CommandBuffer &buffer, std::ostream &out){
+	for (unsigned int i = 0; i < buffer.commands.size(); i++){
+		dumpCommand(buffer, buffer.commands[i], out);
+		out << std::endl;
+	}
+}
+
+//commands are compared through their dumped form so vertex and text payloads count too
+int RecordingRenderBackend::diff(const CommandBuffer &a, const CommandBuffer &b, std::ostream &out){
+	int differences = 0;
+	unsigned int count = (a.commands.size() > b.commands.size()) ? a.commands.size() : b.commands.size();
+
+	for (unsigned int i = 0; i < count; i++){
+		std::ostringstream lineA, lineB;
+		if (i < a.commands.size()) dumpCommand(a, a.commands[i], lineA);
+		if (i < b.commands.size()) dumpCommand(b, b.commands[i], lineB);
+
+		if (lineA.str() != lineB.str()){
+			differences++;
+			out << "@" << i << std::endl;
+			out << "- " << lineA.str() << std::endl;
+			out << "+ " << lineB.str() << std::endl;
+		}
+	}
+	return differences;
+}
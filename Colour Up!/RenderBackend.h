@@ -0,0 +1,55 @@
+#pragma once
+#include "RenderCommands.h"
+#include <iostream>
+#include <vector>
+
+/*
+	Consumers of a recorded CommandBuffer.
+
+	GLRenderBackend (GLRenderBackend.h) draws it with OpenGL, the two below need
+	no GL context at all so they can run on a headless box.
+*/
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend(){}
+
+	virtual void execute(const CommandBuffer&) = 0;
+};
+
+
+//Walks the frame and throws it away - measures pure submission cost
+class NullRenderBackend : public RenderBackend
+{
+public:
+	NullRenderBackend();
+
+	void execute(const CommandBuffer&);
+
+	unsigned long frames;
+	unsigned long commands;
+	unsigned long vertices;
+};
+
+
+//Keeps a copy of every frame so they can be dumped and compared
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+	RecordingRenderBackend();
+
+	void execute(const CommandBuffer&);
+
+	//0 = keep everything, otherwise only the most recent frames
+	void setFrameLimit(unsigned int);
+
+	//human readable listing, one command per line
+	static void dump(const CommandBuffer&, std::ostream&);
+	//prints the differing commands and returns how many there were
+	static int diff(const CommandBuffer&, const CommandBuffer&, std::ostream&);
+
+	std::vector<CommandBuffer> frames;
+
+private:
+	unsigned int frameLimit;
+};
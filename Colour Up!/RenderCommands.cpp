@@ -0,0 +1,128 @@
+#include "RenderCommands.h"
+#include <cstring>
+
+
+CommandBuffer commandBuffer;
+
+
+CommandBuffer::CommandBuffer()
+{
+	//enough for a frame of the hand-built level without reallocating
+	commands.reserve(1024);
+	vertices.reserve(4096);
+	characters.reserve(256);
+}
+
+
+CommandBuffer::~CommandBuffer()
+{
+}
+
+void CommandBuffer::clear(){
+	commands.clear();
+	vertices.clear();
+	characters.clear();
+	fonts.clear();
+	batches.clear();
+}
+
+void CommandBuffer::swap(CommandBuffer &other){
+	commands.swap(other.commands);
+	vertices.swap(other.vertices);
+	characters.swap(other.characters);
+	fonts.swap(other.fonts);
+	batches.swap(other.batches);
+}
+
+RenderCommand& CommandBuffer::push(CommandType type){
+	RenderCommand command;
+	memset(&command, 0, sizeof(command));
+	command.type = (unsigned char)type;
+	commands.push_back(command);
+	return commands.back();
+}
+
+void CommandBuffer::clearColour(unsigned int rgba){
+	push(CMD_CLEAR).first = rgba;
+}
+
+void CommandBuffer::loadIdentity(){
+	push(CMD_LOAD_IDENTITY);
+}
+
+void CommandBuffer::pushMatrix(){
+	push(CMD_PUSH_MATRIX);
+}
+
+void CommandBuffer::popMatrix(){
+	push(CMD_POP_MATRIX);
+}
+
+void CommandBuffer::translate(float x, float y){
+	RenderCommand &command = push(CMD_TRANSLATE);
+	command.f[0] = x;
+	command.f[1] = y;
+}
+
+void CommandBuffer::colour(unsigned int rgba){
+	push(CMD_COLOUR).first = rgba;
+}
+
+void CommandBuffer::begin(Primitive primitive){
+	RenderCommand &command = push(CMD_DRAW);
+	command.primitive = (unsigned char)primitive;
+	command.first = (unsigned int)vertices.size();
+}
+
+void CommandBuffer::begin(Primitive primitive, GLuint texture, TextureMode mode){
+	begin(primitive);
+	RenderCommand &command = commands.back();
+	command.textured = 1;
+	command.texture = texture;
+	command.textureMode = (unsigned char)mode;
+}
+
+//vertices always belong to the last CMD_DRAW
+void CommandBuffer::vertex(float x, float y){
+	vertex(x, y, 0, 0);
+}
+
+void CommandBuffer::vertex(float x, float y, float u, float v){
+	RenderVertex vert = { x, y, u, v };
+	vertices.push_back(vert);
+	commands.back().count++;
+}
+
+void CommandBuffer::batch(const SharedBatch &vertexBatch, Primitive primitive){
+	RenderCommand &command = push(CMD_BATCH);
+	command.primitive = (unsigned char)primitive;
+	command.first = (unsigned int)batches.size();
+	command.count = (unsigned int)vertexBatch->vertices.size();
+	batches.push_back(vertexBatch);
+}
+
+void CommandBuffer::batch(const SharedBatch &vertexBatch, Primitive primitive, GLuint texture, TextureMode mode){
+	batch(vertexBatch, primitive);
+	RenderCommand &command = commands.back();
+	command.textured = 1;
+	command.texture = texture;
+	command.textureMode = (unsigned char)mode;
+}
+
+void CommandBuffer::text(const freetype::font_data &font, float x, float y, const char *string){
+	unsigned int fontIndex = 0;
+	while (fontIndex < fonts.size() && fonts[fontIndex] != &font){
+		fontIndex++;
+	}
+	if (fontIndex == fonts.size()){
+		fonts.push_back(&font);
+	}
+
+	RenderCommand &command = push(CMD_TEXT);
+	command.texture = fontIndex;
+	command.f[0] = x;
+	command.f[1] = y;
+	command.first = (unsigned int)characters.size();
+	command.count = (unsigned int)strlen(string);
+	characters.insert(characters.end(), string, string + command.count);
+}
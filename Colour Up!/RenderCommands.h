@@ -0,0 +1,106 @@
+#pragma once
+#include <windows.h>
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <vector>
+#include <memory>
+
+namespace freetype { struct font_data; }
+
+/*
+	Compact command buffer that all draw code records into.
+
+	Nothing in here talks to OpenGL - a frame is recorded by the activities'
+	draw() methods and then handed to a RenderBackend (GL, null, recording...)
+	which decides what to do with it.
+*/
+
+enum CommandType{
+	CMD_CLEAR,				//clear to colour first (Palette RGBA8)
+	CMD_LOAD_IDENTITY,
+	CMD_PUSH_MATRIX,
+	CMD_POP_MATRIX,
+	CMD_TRANSLATE,			//translate by f[0], f[1]
+	CMD_COLOUR,				//current colour first (Palette RGBA8)
+	CMD_DRAW,				//primitive over vertices [first, first+count)
+	CMD_TEXT,				//font fonts[texture], at f[0], f[1], chars text[first, first+count)
+	CMD_BATCH				//like CMD_DRAW, but over the vertices of batches[first]
+};
+
+enum Primitive{
+	PRIM_POLYGON, PRIM_QUADS, PRIM_LINE_LOOP, PRIM_LINES
+};
+
+//how a texture is combined with the current colour
+enum TextureMode{
+	TEX_MODULATE, TEX_REPLACE
+};
+
+struct RenderVertex {
+	float x, y;
+	float u, v;
+};
+
+//vertices baked once and drawn many times (static level geometry)
+struct VertexBatch {
+	std::vector<RenderVertex> vertices;
+};
+
+//a recorded frame holds on to its batches, so a rebake can't free them while
+//the render thread still draws a snapshot that uses them
+typedef std::shared_ptr<const VertexBatch> SharedBatch;
+
+//32 bytes, kept POD so a whole frame copies cheaply
+struct RenderCommand {
+	unsigned char type;			//CommandType
+	unsigned char primitive;	//Primitive
+	unsigned char textureMode;	//TextureMode
+	unsigned char textured;
+	unsigned int first;
+	unsigned int count;
+	GLuint texture;				//texture name, or font index for CMD_TEXT
+	float f[4];
+};
+
+class CommandBuffer
+{
+public:
+	CommandBuffer();
+	~CommandBuffer();
+
+	//drop the recorded frame, keeping the allocations
+	void clear();
+	//trade recorded frames (and allocations) without copying
+	void swap(CommandBuffer&);
+
+	//colours are RGBA8, as Palette packs them
+	void clearColour(unsigned int);
+	void loadIdentity();
+	void pushMatrix();
+	void popMatrix();
+	void translate(float, float);
+	void colour(unsigned int);
+
+	//start a primitive, then add its vertices
+	void begin(Primitive);
+	void begin(Primitive, GLuint, TextureMode);
+	void vertex(float, float);
+	void vertex(float, float, float, float);
+
+	void text(const freetype::font_data&, float, float, const char*);
+
+	//draw a pre-built batch without copying its vertices
+	void batch(const SharedBatch&, Primitive);
+	void batch(const SharedBatch&, Primitive, GLuint, TextureMode);
+
+	std::vector<RenderCommand> commands;
+	std::vector<RenderVertex> vertices;
+	std::vector<char> characters;
+	std::vector<const freetype::font_data*> fonts;
+	std::vector<SharedBatch> batches;
+
+private:
+	RenderCommand& push(CommandType);
+};
+
+//the frame currently being recorded
+extern CommandBuffer commandBuffer;
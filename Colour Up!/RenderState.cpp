@@ -0,0 +1,180 @@
+#include "RenderState.h"
+#include "Palette.h"
+
+
+RenderState renderState;
+
+
+GLDispatch getDefaultGLDispatch(){
+	GLDispatch dispatch;
+	dispatch.enable = glEnable;
+	dispatch.disable = glDisable;
+	dispatch.bindTexture = glBindTexture;
+	dispatch.blendFunc = glBlendFunc;
+	dispatch.texEnvf = glTexEnvf;
+	dispatch.texParameteri = glTexParameteri;
+	dispatch.genTextures = glGenTextures;
+	dispatch.color4ubv = glColor4ubv;
+	return dispatch;
+}
+
+static void APIENTRY headlessCap(GLenum){}
+static void APIENTRY headlessBindTexture(GLenum, GLuint){}
+static void APIENTRY headlessBlendFunc(GLenum, GLenum){}
+static void APIENTRY headlessTexEnvf(GLenum, GLenum, GLfloat){}
+static void APIENTRY headlessTexParameteri(GLenum, GLenum, GLint){}
+static void APIENTRY headlessColor4ubv(const GLubyte*){}
+
+static GLuint headlessTextureCount = 0;
+static void APIENTRY headlessGenTextures(GLsizei n, GLuint *textures){
+	for (GLsizei i = 0; i < n; i++){
+		textures[i] = ++headlessTextureCount;
+	}
+}
+
+GLDispatch getHeadlessGLDispatch(){
+	GLDispatch dispatch;
+	dispatch.enable = headlessCap;
+	dispatch.disable = headlessCap;
+	dispatch.bindTexture = headlessBindTexture;
+	dispatch.blendFunc = headlessBlendFunc;
+	dispatch.texEnvf = headlessTexEnvf;
+	dispatch.texParameteri = headlessTexParameteri;
+	dispatch.genTextures = headlessGenTextures;
+	dispatch.color4ubv = headlessColor4ubv;
+	return dispatch;
+}
+
+RenderState::RenderState()
+{
+	gl = getDefaultGLDispatch();
+	eliding = true;
+	frame.submitted = frame.elided = 0;
+	lastFrame = frame;
+	invalidate();
+}
+
+
+RenderState::~RenderState()
+{
+}
+
+void RenderState::setDispatch(const GLDispatch &dispatch){
+	gl = dispatch;
+	invalidate();
+}
+
+void RenderState::setElision(bool on){
+	eliding = on;
+}
+
+//count the call and tell the caller whether it has to reach GL
+bool RenderState::changed(bool differs){
+	frame.submitted++;
+	if (!eliding){
+		return true;
+	}
+	if (!differs){
+		frame.elided++;
+	}
+	return differs;
+}
+
+void RenderState::enable(GLenum cap){
+	std::map<GLenum, bool>::iterator known = caps.find(cap);
+	if (changed(known == caps.end() || !known->second)){
+		caps[cap] = true;
+		gl.enable(cap);
+	}
+}
+
+void RenderState::disable(GLenum cap){
+	std::map<GLenum, bool>::iterator known = caps.find(cap);
+	if (changed(known == caps.end() || known->second)){
+		caps[cap] = false;
+		gl.disable(cap);
+	}
+}
+
+void RenderState::bindTexture(GLuint texture){
+	if (changed(!textureKnown || boundTexture != texture)){
+		textureKnown = true;
+		boundTexture = texture;
+		gl.bindTexture(GL_TEXTURE_2D, texture);
+	}
+}
+
+void RenderState::blendFunc(GLenum src, GLenum dst){
+	if (changed(!blendKnown || blendSrc != src || blendDst != dst)){
+		blendKnown = true;
+		blendSrc = src;
+		blendDst = dst;
+		gl.blendFunc(src, dst);
+	}
+}
+
+void RenderState::texEnvMode(GLenum mode){
+	if (changed(!envKnown || envMode != mode)){
+		envKnown = true;
+		envMode = mode;
+		gl.texEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, (GLfloat)mode);
+	}
+}
+
+//wrap modes belong to the texture object, so they are remembered per bound texture
+void RenderState::texWrap(GLint s, GLint t){
+	if (!textureKnown){
+		frame.submitted += 2;
+		gl.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, s);
+		gl.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, t);
+		return;
+	}
+
+	std::map<GLuint, TextureWrap>::iterator known = wrapModes.find(boundTexture);
+	bool haveWrap = known != wrapModes.end();
+
+	if (changed(!haveWrap || known->second.s != s)){
+		gl.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, s);
+	}
+	if (changed(!haveWrap || known->second.t != t)){
+		gl.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, t);
+	}
+
+	TextureWrap wrap = { s, t };
+	wrapModes[boundTexture] = wrap;
+}
+
+void RenderState::colour(unsigned int rgba){
+	if (changed(!colourKnown || currentColour != rgba)){
+		colourKnown = true;
+		currentColour = rgba;
+		GLubyte bytes[4] = {
+			(GLubyte)Palette::red(rgba), (GLubyte)Palette::green(rgba),
+			(GLubyte)Palette::blue(rgba), (GLubyte)Palette::alpha(rgba)
+		};
+		gl.color4ubv(bytes);
+	}
+}
+
+//not state, but texture names have to come from the same place as the binds
+void RenderState::genTextures(GLsizei n, GLuint *textures){
+	gl.genTextures(n, textures);
+}
+
+void RenderState::invalidate(){
+	caps.clear();
+	wrapModes.clear();
+	textureKnown = false;
+	blendKnown = false;
+	envKnown = false;
+	colourKnown = false;
+}
+
+void RenderState::invalidateTexture(){
+	textureKnown = false;
+}
+
+void RenderState::beginFrame(){
+	lastFrame = frame;
+	frame.submitted = frame.elided = 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <windows.h>
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <map>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+/*
+	Thin state-tracking layer over the fixed-function GL state touched every frame.
+	It shadows the bound texture, the GL_TEXTURE_2D / GL_BLEND enable bits, the blend
+	function, the texture environment mode, the per-texture wrap modes and the
+	current colour, and drops any call that would not change what GL already has.
+
+	All GL entry points go through a GLDispatch table so a mock backend can be
+	plugged in to count (or check) the calls that actually reach the driver.
+*/
+
+//table of the GL entry points used by RenderState
+struct GLDispatch {
+	void (APIENTRY *enable)(GLenum cap);
+	void (APIENTRY *disable)(GLenum cap);
+	void (APIENTRY *bindTexture)(GLenum target, GLuint texture);
+	void (APIENTRY *blendFunc)(GLenum sfactor, GLenum dfactor);
+	void (APIENTRY *texEnvf)(GLenum target, GLenum pname, GLfloat param);
+	void (APIENTRY *texParameteri)(GLenum target, GLenum pname, GLint param);
+	void (APIENTRY *genTextures)(GLsizei n, GLuint *textures);
+	void (APIENTRY *color4ubv)(const GLubyte *v);
+};
+
+//the real opengl32 functions
+GLDispatch getDefaultGLDispatch();
+//for running without a context: state calls do nothing and texture names
+//are handed out in order, so TextureStore still gets a unique key per image
+GLDispatch getHeadlessGLDispatch();
+
+//calls submitted to the cache vs. calls dropped because they were redundant
+struct RenderStats {
+	unsigned int submitted;
+	unsigned int elided;
+};
+
+class RenderState
+{
+public:
+	RenderState();
+	~RenderState();
+
+	void setDispatch(const GLDispatch&);
+	//off passes every call through (still counted), to compare against
+	void setElision(bool);
+
+	void enable(GLenum);
+	void disable(GLenum);
+	void bindTexture(GLuint);
+	void blendFunc(GLenum, GLenum);
+	void texEnvMode(GLenum);
+	void texWrap(GLint, GLint);
+	//RGBA8, as Palette packs them
+	void colour(unsigned int);
+	void genTextures(GLsizei, GLuint*);
+
+	//forget everything we know (GL state was changed behind our back)
+	void invalidate();
+	void invalidateTexture();
+
+	//start counting a new frame, the previous frame's counters go to lastFrame
+	void beginFrame();
+
+	RenderStats frame;
+	RenderStats lastFrame;
+
+private:
+	struct TextureWrap {
+		GLint s, t;
+	};
+
+	bool changed(bool);
+
+	GLDispatch gl;
+	bool eliding;
+
+	std::map<GLenum, bool> caps;
+	bool textureKnown;
+	GLuint boundTexture;
+	bool blendKnown;
+	GLenum blendSrc, blendDst;
+	bool envKnown;
+	GLenum envMode;
+	std::map<GLuint, TextureWrap> wrapModes;
+	bool colourKnown;
+	unsigned int currentColour;
+};
+
+//the state cache every draw call goes through
+extern RenderState renderState;
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+
+/*
+	Fixed size ring buffer for exactly one producer thread and one consumer
+	thread, no locks. The producer only writes tail and the consumer only
+	writes head; each publishes with a release store and reads the other's
+	index with an acquire load, so a slot's contents are visible before the
+	index that hands it over.
+
+	Capacity has to be a power of two. One slot is always left empty to tell
+	full from empty, so Capacity - 1 items fit.
+*/
+template <typename T, unsigned int Capacity>
+class SPSCQueue
+{
+public:
+	SPSCQueue() : head(0), tail(0) {}
+
+	//producer side, false when full (the item is not queued)
+	bool push(const T &item){
+		unsigned int t = tail.load(std::memory_order_relaxed);
+		unsigned int next = (t + 1) & (Capacity - 1);
+		if (next == head.load(std::memory_order_acquire)){
+			return false;
+		}
+		items[t] = item;
+		tail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	//consumer side: look at the oldest item without taking it
+	bool peek(T &item) const {
+		unsigned int h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)){
+			return false;
+		}
+		item = items[h];
+		return true;
+	}
+
+	//consumer side
+	bool pop(T &item){
+		if (!peek(item)){
+			return false;
+		}
+		head.store((head.load(std::memory_order_relaxed) + 1) & (Capacity - 1), std::memory_order_release);
+		return true;
+	}
+
+	//either side, only a snapshot
+	bool empty() const {
+		return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+	}
+
+private:
+	static_assert((Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity has to be a power of two");
+
+	T items[Capacity];
+	//padded onto separate cache lines so the two threads don't share one
+	//(VS2013 has no alignas)
+	char padHead[64];
+	std::atomic<unsigned int> head;
+	char padTail[64];
+	std::atomic<unsigned int> tail;
+};
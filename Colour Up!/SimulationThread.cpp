@@ -0,0 +1,226 @@
+#include "SimulationThread.h"
+#include "Game.h"
+#include <chrono>
+
+typedef std::chrono::steady_clock	CostClock;
+
+static double elapsedUs(CostClock::time_point from, CostClock::time_point to){
+	return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+static unsigned int packSize(int width, int height){
+	return ((unsigned int)width << 16) | ((unsigned int)height & 0xffff);
+}
+
+
+SimulationThread::SimulationThread(Platform &platform, InputQueue &input)
+	: platform(platform), input(input)
+{
+	ticks = published = overwritten = 0;
+	updateTotal = recordTotal = 0;
+	work.reset();
+	periodWork.reset();
+	lastWork.reset();
+	lastLatency = input.latency;
+
+	//steps are caught up by the clock, sleeping is all the accuracy needed
+	pacer.setTargetRate(FPS);
+	pacer.spinMargin = 0;
+
+	stopping = false;
+	paused = false;
+	done = false;
+	requestedSize = 0;
+	contextWanted = false;
+	contextLent = false;
+}
+
+
+SimulationThread::~SimulationThread()
+{
+	stop();
+}
+
+void SimulationThread::start(){
+	requestedSize = packSize(screenWidth, screenHeight);
+	thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop(){
+	{
+		std::lock_guard<std::mutex> lock(loanLock);
+		stopping = true;
+	}
+	loanChanged.notify_all();
+	if (thread.joinable()){
+		thread.join();
+	}
+}
+
+void SimulationThread::resize(int width, int height){
+	requestedSize = packSize(width, height);
+}
+
+void SimulationThread::setPaused(bool pause){
+	paused = pause;
+}
+
+bool SimulationThread::finished() const {
+	return done;
+}
+
+bool SimulationThread::wantsContext() const {
+	return contextWanted;
+}
+
+void SimulationThread::lendContext(){
+	std::unique_lock<std::mutex> lock(loanLock);
+	contextLent = true;
+	loanChanged.notify_all();
+	while (contextLent && !stopping){
+		loanChanged.wait(lock);
+	}
+}
+
+//false if the thread is being stopped instead
+bool SimulationThread::borrowContext(){
+	std::unique_lock<std::mutex> lock(loanLock);
+	contextWanted = true;
+	while (!contextLent && !stopping){
+		loanChanged.wait(lock);
+	}
+	if (!contextLent){
+		contextWanted = false;
+		return false;
+	}
+	platform.makeCurrent(true);
+	return true;
+}
+
+void SimulationThread::returnContext(){
+	platform.makeCurrent(false);
+	{
+		std::lock_guard<std::mutex> lock(loanLock);
+		contextWanted = false;
+		contextLent = false;
+	}
+	loanChanged.notify_all();
+}
+
+void SimulationThread::run(){
+	double lastTime = platform.now();
+	double timeSinceLastUpdate = 0.0;
+	double periodStart = lastTime;
+	double stepTime = lastTime;
+	unsigned int appliedSize = requestedSize;
+	Activity *lastRecorded = NULL;
+
+	while (!stopping)
+	{
+		CostClock::time_point loopStart = CostClock::now();
+
+		unsigned int size = requestedSize;
+		bool resized = (size != appliedSize);
+		if (resized){
+			resizeView(size >> 16, size & 0xffff);
+			appliedSize = size;
+		}
+
+		double now = platform.now();
+		double elapsed = now - lastTime;
+		lastTime = now;
+
+		bool stepped = false;
+		if (!paused){
+			timeSinceLastUpdate += elapsed;
+
+			while (timeSinceLastUpdate > TIME_PER_FRAME && !stopping) {
+				//ActivityManager::update() only switches activities, and so
+				//loads, once the active one has turned itself off
+				Activity *activity = activityManager.getActiveState();
+				bool loading = !activity->isOn();
+				if (loading && activityManager.activeState == ActivityManager::END && !activity->restart){
+					//the end screen closed: the render thread quits, where the
+					//serial loop's std::exit() would pull the window from under it
+					done = true;
+					break;
+				}
+				if (loading && !borrowContext()){
+					break;
+				}
+
+				timeSinceLastUpdate -= TIME_PER_FRAME;
+				stepTime = now - timeSinceLastUpdate;
+
+				CostClock::time_point start = CostClock::now();
+				input.beginStep(*activity, stepTime, now);
+				update(TIME_PER_FRAME);
+				input.endStep();
+				updateTotal += elapsedUs(start, CostClock::now());
+				ticks++;
+				stepped = true;
+
+				if (loading){
+					//whatever was recorded before may point at rebuilt fonts: the
+					//render thread is still waiting for the context, so it can't
+					//take the one left in the middle before it is dropped
+					frames.discard();
+					returnContext();
+					lastRecorded = NULL;
+				}
+			}
+		}
+		if (done){
+			break;
+		}
+
+		Activity *activity = activityManager.getActiveState();
+		bool recording = resized || activity != lastRecorded || (stepped && activity->isAnimated());
+		if (recording){
+			record(*activity, stepTime);
+			lastRecorded = activity;
+		}
+
+		if (stepped || recording){
+			double ms = elapsedUs(loopStart, CostClock::now()) / 1000;
+			work.add(ms, TIME_PER_FRAME * 1000);
+			periodWork.add(ms, TIME_PER_FRAME * 1000);
+		}
+		if (now - periodStart >= 1){
+			lastWork = periodWork;
+			lastLatency = input.latency;
+			periodWork.reset();
+			input.resetStats();
+			periodStart = now;
+		}
+
+		pacer.wait(platform, false);
+		pacer.frameDone(platform);
+	}
+}
+
+void SimulationThread::record(Activity &activity, double time){
+	CostClock::time_point start = CostClock::now();
+
+	FrameSnapshot &frame = frames.writeSlot();
+	commandBuffer.clear();
+	activity.draw();
+	//the global buffer takes the slot's old allocations in exchange
+	frame.commands.swap(commandBuffer);
+
+	frame.width = screenWidth;
+	frame.height = screenHeight;
+	frame.halfWidth = viewHalfWidth;
+	frame.halfHeight = viewHalfHeight;
+	frame.time = time;
+	frame.drawn = activity.camera.submitted;
+	frame.culled = activity.camera.culled;
+	frame.work = lastWork;
+	frame.latency = lastLatency;
+
+	if (frames.publish()){
+		overwritten++;
+	}
+	published++;
+	recordTotal += elapsedUs(start, CostClock::now());
+}
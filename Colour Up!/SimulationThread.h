@@ -0,0 +1,104 @@
+#pragma once
+#include "Platform.h"
+#include "InputQueue.h"
+#include "FramePacer.h"
+#include "RenderCommands.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/*
+	Runs the fixed steps on a thread of their own, so a slow draw or a stall
+	in the driver no longer holds up the simulation.
+
+	After the steps of each loop the active activity's draw() is recorded
+	into a FrameSnapshot and published through a TripleBuffer. The render
+	thread (main.cpp) takes the latest one whenever it is ready to draw and
+	never touches the game itself. A recorded CommandBuffer already holds
+	everything a frame shows (positions, texture names, colours, the score
+	as text), so a snapshot is that plus what it was recorded for. Still
+	screens (Activity::isAnimated) are only republished when they change.
+
+	Loading is the one part of a step that needs GL: switching activities
+	uploads textures and builds fonts in init(). Before a step that will
+	switch, the simulation asks for the context and the render thread
+	releases it and waits until it comes back, so the two never use GL, the
+	state cache, the texture store or the fonts and batches a snapshot
+	points to at the same time.
+*/
+
+//one recorded frame, not changed again once published
+struct FrameSnapshot {
+	CommandBuffer commands;
+	//the viewport and projection it was recorded (and culled) for
+	int width, height;
+	float halfWidth, halfHeight;
+	//platform time the last step it shows simulated up to
+	double time;
+	//the camera's counts while recording
+	unsigned int drawn, culled;
+	//the simulation thread's last whole second
+	FrameStats work;
+	InputLatency latency;
+};
+
+class SimulationThread
+{
+public:
+	SimulationThread(Platform&, InputQueue&);
+	~SimulationThread();
+
+	//the window and the first activity have to be set up already
+	void start();
+	//ask the thread to finish and wait for it
+	void stop();
+
+	//render thread side
+	void resize(int, int);
+	void setPaused(bool);
+	//the end screen was closed without a restart
+	bool finished() const;
+	//true while the simulation waits to borrow the GL context
+	bool wantsContext() const;
+	//call with the context released, returns once it's been given back
+	void lendContext();
+
+	TripleBuffer<FrameSnapshot> frames;
+
+	//the simulation's own, read them after stop()
+	long long ticks;
+	long long published;
+	long long overwritten;		//replaced before the render thread took them
+	double updateTotal;			//us
+	double recordTotal;			//us
+	FrameStats work;			//ms per loop that stepped or recorded
+
+private:
+	void run();
+	void record(Activity&, double);
+	bool borrowContext();
+	void returnContext();
+
+	Platform &platform;
+	InputQueue &input;
+	//holds the loop to the step rate, sleeping only
+	FramePacer pacer;
+	std::thread thread;
+
+	std::atomic<bool> stopping;
+	std::atomic<bool> paused;
+	std::atomic<bool> done;
+	std::atomic<unsigned int> requestedSize;	//width << 16 | height
+
+	//the context loan, rare enough for a lock
+	std::mutex loanLock;
+	std::condition_variable loanChanged;
+	std::atomic<bool> contextWanted;
+	bool contextLent;
+
+	FrameStats periodWork;
+	FrameStats lastWork;
+	InputLatency lastLatency;
+};
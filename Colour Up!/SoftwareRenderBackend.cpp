@@ -0,0 +1,396 @@
+#include "SoftwareRenderBackend.h"
+#include "ImageWriter.h"
+#include "Palette.h"
+#include "FreeType.h"
+#include "Math/TransformBatch.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+
+//-----SPAN FUNCTIONS-----//
+//The scalar and SSE2 paths do exactly the same integer maths so frames
+//come out bit-identical whichever one runs. simd false keeps to the scalar
+//loops even when SSE2 is compiled in.
+
+static inline unsigned int div255(unsigned int t){
+	t += 128;
+	return (t + (t >> 8)) >> 8;
+}
+
+static inline unsigned int channel(unsigned int pixel, int c){
+	return (pixel >> (c * 8)) & 0xFF;
+}
+
+//texel * colour, per channel
+static inline unsigned int modulate(unsigned int texel, unsigned int colour){
+	unsigned int out = 0;
+	for (int c = 0; c < 4; c++){
+		out |= div255(channel(texel, c) * channel(colour, c)) << (c * 8);
+	}
+	return out;
+}
+
+//src * srcAlpha + dst * (1 - srcAlpha), alpha included like glBlendFunc does
+static inline unsigned int blend(unsigned int src, unsigned int dst){
+	unsigned int a = src >> 24;
+	unsigned int out = 0;
+	for (int c = 0; c < 4; c++){
+		out |= div255(channel(src, c) * a + channel(dst, c) * (255 - a)) << (c * 8);
+	}
+	return out;
+}
+
+static inline unsigned int sample(const TextureImage *texture, float u, float v){
+	//a texture that failed to load is 0x0: opaque white, so MODULATE leaves the colour
+	if (texture->width == 0 || texture->height == 0){
+		return 0xFFFFFFFF;
+	}
+	int x = (int)floorf(u * texture->width) % texture->width;
+	int y = (int)floorf(v * texture->height) % texture->height;
+	if (x < 0) x += texture->width;
+	if (y < 0) y += texture->height;
+	return texture->pixels[y * texture->width + x];
+}
+
+static void fillSpan(unsigned int *row, int x0, int x1, unsigned int colour, bool simd){
+	int x = x0;
+#ifdef RASTER_SSE2
+	__m128i fill = _mm_set1_epi32((int)colour);
+	for (; simd && x + 4 <= x1; x += 4){
+		_mm_storeu_si128((__m128i*)(row + x), fill);
+	}
+#endif
+	for (; x < x1; x++){
+		row[x] = colour;
+	}
+}
+
+#ifdef RASTER_SSE2
+static inline __m128i div255x8(__m128i t){
+	t = _mm_add_epi16(t, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+//two pixels widened to 16 bit lanes
+static inline __m128i blendx2(__m128i src, __m128i dst, __m128i colour, bool replace){
+	if (!replace){
+		src = div255x8(_mm_mullo_epi16(src, colour));
+	}
+	__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	__m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+	return div255x8(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse)));
+}
+#endif
+
+static void texturedSpan(unsigned int *row, int x0, int x1, float u, float v, float dudx, float dvdx,
+						 const TextureImage *texture, unsigned int colour, bool replace, bool simd){
+	int x = x0;
+#ifdef RASTER_SSE2
+	__m128i zero = _mm_setzero_si128();
+	__m128i colour16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)colour), zero);
+	for (; simd && x + 4 <= x1; x += 4){
+		unsigned int texels[4];
+		for (int k = 0; k < 4; k++){
+			texels[k] = sample(texture, u, v);
+			u += dudx;
+			v += dvdx;
+		}
+		__m128i src = _mm_loadu_si128((const __m128i*)texels);
+		__m128i dst = _mm_loadu_si128((const __m128i*)(row + x));
+		__m128i lo = blendx2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), colour16, replace);
+		__m128i hi = blendx2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), colour16, replace);
+		_mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; x < x1; x++){
+		unsigned int texel = sample(texture, u, v);
+		if (!replace){
+			texel = modulate(texel, colour);
+		}
+		row[x] = blend(texel, row[x]);
+		u += dudx;
+		v += dvdx;
+	}
+}
+
+
+//-----BACKEND-----//
+
+SoftwareRenderBackend::SoftwareRenderBackend(int w, int h)
+{
+	width = w;
+	height = h;
+	framebuffer.assign(w * h, 0xFF000000u);
+	setOrtho(0, (float)w, 0, (float)h);
+	packedColour = Palette::packed(WHITE);
+	simd = true;
+}
+
+
+SoftwareRenderBackend::~SoftwareRenderBackend()
+{
+}
+
+void SoftwareRenderBackend::resize(int w, int h){
+	width = w;
+	height = h;
+	framebuffer.assign(w * h, 0xFF000000u);
+	setOrtho(orthoLeft, orthoRight, orthoBottom, orthoTop);
+}
+
+//same arguments as the gluOrtho2D call in reshape()
+void SoftwareRenderBackend::setOrtho(float left, float right, float bottom, float top){
+	orthoLeft = left;
+	orthoRight = right;
+	orthoBottom = bottom;
+	orthoTop = top;
+	projection = Affine2f::window(left, right, bottom, top, (float)width, (float)height);
+	toPixels = projection * modelview;
+}
+
+//u and v are copied as they are, x and y go through toPixels
+void SoftwareRenderBackend::toScreen(const RenderVertex *in, ScreenVertex *out, unsigned int count) const {
+	static_assert(sizeof(RenderVertex) == sizeof(ScreenVertex), "ScreenVertex has RenderVertex's layout");
+	if (in != (const RenderVertex*)out){
+		memcpy(out, in, count * sizeof(RenderVertex));
+	}
+	TransformBatchf::transformPoints2(toPixels,
+		PointSpan2<const float>::aos(in, count), PointSpan2f::aos(out, count));
+}
+
+void SoftwareRenderBackend::execute(const CommandBuffer &buffer){
+	matrixStack.clear();
+	modelview = Affine2f();
+	toPixels = projection;
+
+	std::vector<ScreenVertex> screen;
+
+	for (unsigned int i = 0; i < buffer.commands.size(); i++){
+		const RenderCommand &command = buffer.commands[i];
+
+		switch (command.type){
+		case CMD_CLEAR:
+			clear(command.first);
+			break;
+		case CMD_LOAD_IDENTITY:
+			modelview = Affine2f();
+			toPixels = projection;
+			break;
+		case CMD_PUSH_MATRIX:
+			matrixStack.push_back(modelview);
+			break;
+		case CMD_POP_MATRIX:
+			//an unbalanced pop is a no-op, like the GL stack underflow error
+			if (!matrixStack.empty()){
+				modelview = matrixStack.back();
+				matrixStack.pop_back();
+				toPixels = projection * modelview;
+			}
+			break;
+		case CMD_TRANSLATE:
+			modelview *= Affine2f::translate(command.f[0], command.f[1]);
+			toPixels = projection * modelview;
+			break;
+		case CMD_COLOUR:
+			packedColour = command.first;
+			break;
+		case CMD_DRAW:
+		case CMD_BATCH:
+		{
+			if (command.count == 0){
+				break;
+			}
+			const RenderVertex *verts = (command.type == CMD_BATCH) ? &buffer.batches[command.first]->vertices[0] : &buffer.vertices[command.first];
+			screen.resize(command.count);
+			toScreen(verts, &screen[0], command.count);
+
+			const TextureImage *texture = (command.textured) ? textureStore.find(command.texture) : NULL;
+			bool replace = command.textureMode == TEX_REPLACE;
+
+			switch (command.primitive){
+			case PRIM_POLYGON:
+				drawPolygon(&screen[0], command.count, texture, command.textured != 0, replace);
+				break;
+			case PRIM_QUADS:
+				for (unsigned int q = 0; q + 4 <= command.count; q += 4){
+					drawPolygon(&screen[q], 4, texture, command.textured != 0, replace);
+				}
+				break;
+			case PRIM_LINE_LOOP:
+				for (unsigned int v = 0; v < command.count; v++){
+					drawLine(screen[v], screen[(v + 1) % command.count]);
+				}
+				break;
+			case PRIM_LINES:
+				for (unsigned int v = 0; v + 2 <= command.count; v += 2){
+					drawLine(screen[v], screen[v + 1]);
+				}
+				break;
+			}
+			break;
+		}
+		case CMD_TEXT:
+			drawText(buffer, command);
+			break;
+		}
+	}
+}
+
+void SoftwareRenderBackend::clear(unsigned int packed){
+	fillSpan(&framebuffer[0], 0, width * height, packed, simd);
+}
+
+//Scanline conversion of a convex polygon, sampling at pixel centres.
+//Texture coordinates are interpolated as a plane through the first three
+//vertices, which is exact for the rectangles and glyph quads the game draws.
+void SoftwareRenderBackend::drawPolygon(const ScreenVertex *verts, int count, const TextureImage *texture, bool textured, bool replace){
+	if (count < 3){
+		return;
+	}
+
+	float minY = verts[0].y, maxY = verts[0].y;
+	for (int i = 1; i < count; i++){
+		if (verts[i].y < minY) minY = verts[i].y;
+		if (verts[i].y > maxY) maxY = verts[i].y;
+	}
+
+	float dudx = 0, dudy = 0, dvdx = 0, dvdy = 0;
+	if (texture){
+		const ScreenVertex &a = verts[0], &b = verts[1], &c = verts[2];
+		float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+		if (area == 0){
+			return;
+		}
+		dudx = ((b.u - a.u) * (c.y - a.y) - (c.u - a.u) * (b.y - a.y)) / area;
+		dudy = ((c.u - a.u) * (b.x - a.x) - (b.u - a.u) * (c.x - a.x)) / area;
+		dvdx = ((b.v - a.v) * (c.y - a.y) - (c.v - a.v) * (b.y - a.y)) / area;
+		dvdy = ((c.v - a.v) * (b.x - a.x) - (b.v - a.v) * (c.x - a.x)) / area;
+	}
+
+	//textured without a texture behaves like GL with an incomplete texture: plain colour
+	bool flat = !textured || !texture;
+
+	int firstRow = (int)ceilf(minY - 0.5f);
+	int lastRow = (int)ceilf(maxY - 0.5f);
+	if (firstRow < 0) firstRow = 0;
+	if (lastRow > height) lastRow = height;
+
+	for (int y = firstRow; y < lastRow; y++){
+		float centreY = y + 0.5f;
+		float left = 0, right = 0;
+		int crossings = 0;
+
+		for (int i = 0; i < count; i++){
+			const ScreenVertex &a = verts[i];
+			const ScreenVertex &b = verts[(i + 1) % count];
+			float top = (a.y < b.y) ? a.y : b.y;
+			float bottom = (a.y < b.y) ? b.y : a.y;
+			if (centreY < top || centreY >= bottom){
+				continue;
+			}
+			float x = a.x + (centreY - a.y) * (b.x - a.x) / (b.y - a.y);
+			if (crossings == 0){
+				left = right = x;
+			}
+			else{
+				if (x < left) left = x;
+				if (x > right) right = x;
+			}
+			crossings++;
+		}
+		if (crossings < 2){
+			continue;
+		}
+
+		int x0 = (int)ceilf(left - 0.5f);
+		int x1 = (int)ceilf(right - 0.5f);
+		if (x0 < 0) x0 = 0;
+		if (x1 > width) x1 = width;
+		if (x0 >= x1){
+			continue;
+		}
+
+		unsigned int *row = &framebuffer[y * width];
+		if (flat){
+			fillSpan(row, x0, x1, packedColour, simd);
+		}
+		else{
+			float u = verts[0].u + dudx * (x0 + 0.5f - verts[0].x) + dudy * (centreY - verts[0].y);
+			float v = verts[0].v + dvdx * (x0 + 0.5f - verts[0].x) + dvdy * (centreY - verts[0].y);
+			texturedSpan(row, x0, x1, u, v, dudx, dvdx, texture, packedColour, replace, simd);
+		}
+	}
+}
+
+//one pixel wide DDA line in the current colour
+void SoftwareRenderBackend::drawLine(const ScreenVertex &a, const ScreenVertex &b){
+	float dx = b.x - a.x;
+	float dy = b.y - a.y;
+	float length = (fabsf(dx) > fabsf(dy)) ? fabsf(dx) : fabsf(dy);
+	int steps = (int)ceilf(length);
+	if (steps == 0) steps = 1;
+
+	for (int i = 0; i <= steps; i++){
+		int x = (int)floorf(a.x + dx * i / steps);
+		int y = (int)floorf(a.y + dy * i / steps);
+		if (x >= 0 && x < width && y >= 0 && y < height){
+			framebuffer[y * width + x] = packedColour;
+		}
+	}
+}
+
+//the same layout freetype::drawText builds with display lists, as glyph quads
+//in window coordinates
+void SoftwareRenderBackend::drawText(const CommandBuffer &buffer, const RenderCommand &command){
+	const freetype::font_data &font = *buffer.fonts[command.texture];
+	float lineHeight = font.h / .63f;
+
+	//window coordinates are pixels, only the modelview applies
+	Affine2f savedToPixels = toPixels;
+	toPixels = modelview;
+
+	float penX = command.f[0];
+	float penY = command.f[1];
+	for (unsigned int i = command.first; i < command.first + command.count; i++){
+		unsigned char ch = buffer.characters[i];
+		if (ch == '\n'){
+			penX = command.f[0];
+			penY -= lineHeight;
+			continue;
+		}
+		if (ch >= 128){
+			continue;
+		}
+
+		const freetype::glyph_metrics &glyph = font.glyphs[ch];
+		float x = penX + glyph.left;
+		float y = penY + glyph.top - glyph.rows;
+
+		RenderVertex quad[4] = {
+			{ x, y + glyph.rows, 0, 0 },
+			{ x, y, 0, glyph.t },
+			{ x + glyph.width, y, glyph.s, glyph.t },
+			{ x + glyph.width, y + glyph.rows, glyph.s, 0 }
+		};
+		ScreenVertex screen[4];
+		toScreen(quad, screen, 4);
+		drawPolygon(screen, 4, textureStore.find(font.textures[ch]), true, false);
+
+		penX += glyph.advance;
+	}
+
+	toPixels = savedToPixels;
+}
+
+bool SoftwareRenderBackend::savePPM(const char *path) const {
+	return writePPM(path, width, height, &framebuffer[0]);
+}
+
+bool SoftwareRenderBackend::savePNG(const char *path) const {
+	return writePNG(path, width, height, &framebuffer[0]);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "RenderBackend.h"
+#include "TextureStore.h"
+#include "Math/Affine2.h"
+#include <vector>
+
+/*
+	CPU rasteriser for the handful of primitives the game records:
+	flat and textured convex polygons, line loops / lines and glyph quads.
+
+	The projection is the same orthographic window reshape() gives gluOrtho2D,
+	kept with the modelview stack as Affine2s; the game only translates.
+	Spans are filled four pixels at a time with SSE2 when it is available.
+*/
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+	SoftwareRenderBackend(int, int);
+	~SoftwareRenderBackend();
+
+	void execute(const CommandBuffer&);
+
+	void resize(int, int);
+	void setOrtho(float, float, float, float);
+
+	bool savePPM(const char*) const;
+	bool savePNG(const char*) const;
+
+	int width, height;
+	//RGBA8, r in the lowest byte, row 0 at the bottom
+	std::vector<unsigned int> framebuffer;
+	//false for the scalar spans even with SSE2 there, to compare the two
+	bool simd;
+
+private:
+	struct ScreenVertex {
+		float x, y;
+		float u, v;
+	};
+
+	void toScreen(const RenderVertex*, ScreenVertex*, unsigned int) const;
+
+	void clear(unsigned int);
+	void drawPolygon(const ScreenVertex*, int, const TextureImage*, bool, bool);
+	void drawLine(const ScreenVertex&, const ScreenVertex&);
+	void drawText(const CommandBuffer&, const RenderCommand&);
+
+	float orthoLeft, orthoRight, orthoBottom, orthoTop;
+	//window to pixels
+	Affine2f projection;
+
+	Affine2f modelview;
+	std::vector<Affine2f> matrixStack;
+	//projection * modelview, what vertices go through
+	Affine2f toPixels;
+
+	//the current colour, already in the framebuffer's format
+	unsigned int packedColour;
+};
@@ -35,9 +35,13 @@ void StartGame::update(const double dt){
 
 void StartGame::draw(){
 	displayBG();
-	glLoadIdentity();
+	commandBuffer.loadIdentity();
 		startScreen.draw();
-	glFlush();
+}
+
+//a still image
+bool StartGame::isAnimated(){
+	return false;
 }
 
 void StartGame::updateInput(){
@@ -11,6 +11,7 @@ public:
 	void init();
 	void update(const double dt);
 	void updateInput();
+	bool isAnimated();
 
 
 	GameObject startScreen;
@@ -0,0 +1,117 @@
+#include "StaticGeometry.h"
+#include "Palette.h"
+#include <cmath>
+
+
+StaticGeometry::StaticGeometry()
+{
+	//roughly a third of the default view, so culling still bites
+	chunkHeight = 200;
+	drawn = culled = 0;
+}
+
+
+StaticGeometry::~StaticGeometry()
+{
+}
+
+void StaticGeometry::clear(){
+	chunks.clear();
+}
+
+void StaticGeometry::bake(const World &world, const std::vector<Entity> &entities){
+	clear();
+
+	float lowest = 0;
+	bool any = false;
+	for (size_t o = 0; o < entities.size(); o++){
+		if (world.has(entities[o], maskOf<Static>()) && (!any || world.get<Transform>(entities[o]).y < lowest)){
+			lowest = world.get<Transform>(entities[o]).y;
+			any = true;
+		}
+	}
+
+	//in the order given, which decides the order batches and quads are drawn in
+	for (size_t o = 0; o < entities.size(); o++){
+		Entity e = entities[o];
+		if (!world.has(e, maskOf<Static>())){
+			continue;
+		}
+		const Transform &transform = world.get<Transform>(e);
+		const AABB &box = world.get<AABB>(e);
+		const Sprite &sprite = world.get<Sprite>(e);
+
+		//lowest is the bottom obstacle's y, so this is never negative
+		size_t index = (size_t)floor((transform.y - lowest) / chunkHeight);
+		if (index >= chunks.size()){
+			chunks.resize(index + 1);
+		}
+		StaticChunk &chunk = chunks[index];
+
+		float hw = box.halfWidth, hh = box.halfHeight;
+		if (chunk.batches.empty()){
+			chunk.minX = transform.x - hw;
+			chunk.maxX = transform.x + hw;
+			chunk.minY = transform.y - hh;
+			chunk.maxY = transform.y + hh;
+		}
+		else{
+			chunk.minX = fmin(chunk.minX, transform.x - hw);
+			chunk.maxX = fmax(chunk.maxX, transform.x + hw);
+			chunk.minY = fmin(chunk.minY, transform.y - hh);
+			chunk.maxY = fmax(chunk.maxY, transform.y + hh);
+		}
+
+		//same state as drawSprite sets up for an obstacle
+		TextureMode mode = TEX_MODULATE;
+		GLuint texture = (sprite.textured) ? sprite.texture : 0;
+
+		size_t b = 0;
+		while (b < chunk.batches.size()
+			&& !(chunk.batches[b].color == sprite.color && chunk.batches[b].textured == sprite.textured
+			&& chunk.batches[b].texture == texture && chunk.batches[b].mode == mode)){
+			b++;
+		}
+		if (b == chunk.batches.size()){
+			StaticBatch batch;
+			batch.color = sprite.color;
+			batch.textured = sprite.textured;
+			batch.texture = texture;
+			batch.mode = mode;
+			batch.quads = std::make_shared<VertexBatch>();
+			chunk.batches.push_back(batch);
+		}
+
+		RenderVertex quad[4];
+		spriteQuad(box, transform.x, transform.y, quad);
+		chunk.batches[b].quads->vertices.insert(chunk.batches[b].quads->vertices.end(), quad, quad + 4);
+	}
+}
+
+void StaticGeometry::draw(const Camera &camera){
+	drawn = culled = 0;
+
+	for (size_t c = 0; c < chunks.size(); c++){
+		const StaticChunk &chunk = chunks[c];
+		if (chunk.batches.empty()){
+			continue;
+		}
+		if (!camera.isVisible((chunk.minX + chunk.maxX) / 2, (chunk.minY + chunk.maxY) / 2,
+			(chunk.maxX - chunk.minX) / 2, (chunk.maxY - chunk.minY) / 2)){
+			culled++;
+			continue;
+		}
+		drawn++;
+
+		for (size_t b = 0; b < chunk.batches.size(); b++){
+			const StaticBatch &batch = chunk.batches[b];
+			commandBuffer.colour(Palette::packed(batch.color));
+			if (batch.textured){
+				commandBuffer.batch(batch.quads, PRIM_QUADS, batch.texture, batch.mode);
+			}
+			else{
+				commandBuffer.batch(batch.quads, PRIM_QUADS);
+			}
+		}
+	}
+}
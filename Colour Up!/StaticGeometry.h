@@ -0,0 +1,55 @@
+#pragma once
+#include "World.h"
+#include "RenderCommands.h"
+#include "Camera.h"
+#include <vector>
+
+/*
+	Level geometry that never moves, baked once into vertex batches.
+
+	Entities tagged Static are grouped into horizontal bands
+	(chunks) up the tower, and inside a chunk into one batch per texture + colour.
+	Drawing a chunk is then one colour and one CMD_BATCH per group instead of a
+	push / translate / colour / draw / pop per platform.
+
+	Anything that moves or can be picked up keeps being drawn one by one.
+
+	A baked batch is never changed again. bake() builds new ones and recorded
+	frames keep sharing the old ones until they are done with them.
+*/
+
+struct StaticBatch {
+	Color color;
+	bool textured;
+	GLuint texture;
+	TextureMode mode;
+	std::shared_ptr<VertexBatch> quads;
+};
+
+struct StaticChunk {
+	//bounds of everything baked into the chunk
+	float minX, maxX, minY, maxY;
+	std::vector<StaticBatch> batches;
+};
+
+class StaticGeometry
+{
+public:
+	StaticGeometry();
+	~StaticGeometry();
+
+	//bake the Static ones of the entities, in the order given
+	void bake(const World&, const std::vector<Entity>&);
+	void clear();
+
+	//record the chunks that intersect the camera
+	void draw(const Camera&);
+
+	//height of a chunk in world units
+	float chunkHeight;
+	std::vector<StaticChunk> chunks;
+
+	//chunks drawn / culled during the last draw
+	unsigned int drawn;
+	unsigned int culled;
+};
@@ -0,0 +1,57 @@
+#include "Systems.h"
+
+
+static const ComponentMask OBSTACLE = maskOf<Transform, AABB, Sprite>();
+
+//in PlatformType order
+static const ComponentMask platformKinds[CollidableObject::PLATFORM_TYPE_COUNT] = {
+	OBSTACLE | maskOf<Static>(),											//PLATFORM
+	OBSTACLE | maskOf<Static, Deadly>(),									//DEADLYPLATFORM
+	OBSTACLE | maskOf<Motion, SlideX, Carrier>(),							//MOVINGX
+	OBSTACLE | maskOf<Motion, SlideY, Lift>(),								//MOVINGY
+	OBSTACLE | maskOf<Motion, Patrol>() | maskOf<Deadly, NoHeight>(),		//ENEMY
+	OBSTACLE | maskOf<Pickup>(),											//LAMBDA
+	OBSTACLE | maskOf<Pickup, PowerUp>(),									//CMYK
+	OBSTACLE | maskOf<Motion, Rise>() | maskOf<Deadly, NoHeight>(),			//ALPHAFLOOR
+	OBSTACLE | maskOf<Goal, Deadly>()										//HSV
+};
+
+ComponentMask platformKind(CollidableObject::PlatformType type){
+	return platformKinds[type];
+}
+
+Entity spawnObstacle(World &world, const CollidableObject &object){
+	ComponentMask mask = platformKind(object.platformType);
+	//the walls are plain platforms that never get erased, and are never baked
+	if (object.permanent){
+		mask = (mask & ~maskOf<Static>()) | maskOf<Permanent>();
+	}
+
+	Entity e = world.create(mask);
+	world.get<Transform>(e) = object.transform;
+	world.get<AABB>(e) = object.box;
+	world.get<Sprite>(e) = object.sprite;
+	if (mask & maskOf<Motion>()){
+		world.get<Motion>(e) = object.motion;
+	}
+	if (mask & maskOf<Pickup>()){
+		world.get<Pickup>(e) = object.pickup;
+	}
+	return e;
+}
+
+template<class Kind> static void moveKind(World &world, double dt){
+	world.eachChunk<Transform, Motion, Sprite>(maskOf<Kind>(),
+		[dt](int count, Entity*, Transform *transforms, Motion *motions, Sprite *sprites){
+		for (int i = 0; i < count; i++){
+			step(Kind(), transforms[i], motions[i], sprites[i], dt);
+		}
+	});
+}
+
+void moveObstacles(World &world, double dt){
+	moveKind<SlideX>(world, dt);
+	moveKind<SlideY>(world, dt);
+	moveKind<Patrol>(world, dt);
+	moveKind<Rise>(world, dt);
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "World.h"
+#include "CollidableObject.h"
+
+/*
+	What the platform types are made of, and the systems that don't need
+	PlayGame's state.
+
+	A platform type is a row in one table: the components it stores and the
+	tags that say what touching it does. Systems only ever look at components
+	and tags, never at the type, so a new type is a new row, plus a tag and
+	the code for it if it does something nothing else does.
+*/
+
+//components + tags for a platform type
+ComponentMask platformKind(CollidableObject::PlatformType);
+
+//an entity for a level obstacle, its components copied over
+Entity spawnObstacle(World&, const CollidableObject&);
+
+//one step for everything that has a Motion, a run of each kind at a time
+void moveObstacles(World&, double dt);
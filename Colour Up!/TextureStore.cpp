@@ -0,0 +1,82 @@
+#include "TextureStore.h"
+#include <cstddef>
+
+#ifndef GL_BGR
+#define GL_BGR	0x80E0
+#endif
+#ifndef GL_BGRA
+#define GL_BGRA	0x80E1
+#endif
+
+
+TextureStore textureStore;
+
+
+TextureStore::TextureStore()
+{
+}
+
+
+TextureStore::~TextureStore()
+{
+}
+
+static unsigned int packRGBA(unsigned int r, unsigned int g, unsigned int b, unsigned int a){
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+void TextureStore::add(GLuint name, int width, int height, GLenum format, const void *data){
+	TextureImage &image = images[name];
+	image.width = width;
+	image.height = height;
+	image.pixels.resize(width * height);
+
+	const unsigned char *src = (const unsigned char*)data;
+	for (int i = 0; i < width * height; i++){
+		unsigned int pixel;
+		switch (format){
+		case GL_RGBA:
+			pixel = packRGBA(src[0], src[1], src[2], src[3]);
+			src += 4;
+			break;
+		case GL_BGRA:
+			pixel = packRGBA(src[2], src[1], src[0], src[3]);
+			src += 4;
+			break;
+		case GL_RGB:
+			pixel = packRGBA(src[0], src[1], src[2], 255);
+			src += 3;
+			break;
+		case GL_BGR:
+			pixel = packRGBA(src[2], src[1], src[0], 255);
+			src += 3;
+			break;
+		case GL_LUMINANCE_ALPHA:
+			pixel = packRGBA(src[0], src[0], src[0], src[1]);
+			src += 2;
+			break;
+		case GL_LUMINANCE:
+			pixel = packRGBA(src[0], src[0], src[0], 255);
+			src += 1;
+			break;
+		case GL_ALPHA:
+		default:
+			pixel = packRGBA(255, 255, 255, src[0]);
+			src += 1;
+			break;
+		}
+		image.pixels[i] = pixel;
+	}
+}
+
+const TextureImage* TextureStore::find(GLuint name) const {
+	std::map<GLuint, TextureImage>::const_iterator image = images.find(name);
+	if (image == images.end()){
+		return NULL;
+	}
+	return &image->second;
+}
+
+void TextureStore::remove(GLuint name){
+	images.erase(name);
+}
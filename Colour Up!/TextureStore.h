@@ -0,0 +1,35 @@
+#pragma once
+#include <windows.h>
+#include <GL/gl.h>			// Header File For The OpenGL32 Library
+#include <map>
+#include <vector>
+
+/*
+	CPU-side copies of the textures uploaded to GL, keyed by their GL name.
+	Backends that do not replay the frame through OpenGL (the software
+	rasteriser) sample from these instead of the driver's copy.
+
+	Pixels are kept as RGBA8 packed into 32 bits (r in the lowest byte) with
+	row 0 at t = 0, the same orientation glTexImage2D was given.
+*/
+struct TextureImage {
+	int width, height;
+	std::vector<unsigned int> pixels;
+};
+
+class TextureStore
+{
+public:
+	TextureStore();
+	~TextureStore();
+
+	//convert and keep a copy of an 8 bit per channel image
+	void add(GLuint, int, int, GLenum, const void*);
+	const TextureImage* find(GLuint) const;
+	void remove(GLuint);
+
+private:
+	std::map<GLuint, TextureImage> images;
+};
+
+extern TextureStore textureStore;
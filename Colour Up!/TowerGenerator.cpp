@@ -0,0 +1,284 @@
+#include "TowerGenerator.h"
+#include "Player.h"
+#include <algorithm>
+#include <cmath>
+
+
+//inside faces of the walls createLevel puts up at x = -300 and x = 490 (400 wide)
+static const float MIN_X = -100;
+static const float MAX_X = 290;
+static const double TICK = 1.0 / 60;
+
+//everywhere a solid can be: moving platforms go 40 right / up of where they start
+struct Extent {
+	float minX, maxX, minY, maxY;
+};
+
+//a solid from the last few steps, which later ones must stay out of
+struct Placed {
+	size_t index;		//in the obstacles
+	Extent extent;
+	float spotX;		//where the path put it, one end of a MOVINGX's sweep
+	bool gate;
+};
+
+static Extent extentOf(const CollidableObject &object){
+	float sweepX = (object.platformType == CollidableObject::MOVINGX) ? 40.f : 0.f;
+	float sweepY = (object.platformType == CollidableObject::MOVINGY) ? 40.f : 0.f;
+	Extent extent = {
+		object.transform.x - object.box.halfWidth, object.transform.x + object.box.halfWidth + sweepX,
+		object.transform.y - object.box.halfHeight, object.transform.y + object.box.halfHeight + sweepY
+	};
+	return extent;
+}
+
+//sharing an edge is fine
+static bool overlap(const Extent &a, const Extent &b){
+	return a.minX < b.maxX && b.minX < a.maxX && a.minY < b.maxY && b.minY < a.maxY;
+}
+
+static bool hitsAny(const std::vector<Placed> &placed, const Extent &extent){
+	for (size_t p = 0; p < placed.size(); p++){
+		if (overlap(placed[p].extent, extent)){
+			return true;
+		}
+	}
+	return false;
+}
+
+
+TowerSettings::TowerSettings()
+{
+	seed = 1;
+	platforms = 100;
+	textures.glitch = textures.enemyLeft = textures.enemyRight = 0;
+	textures.lambda = textures.cmyk = textures.death = textures.hsv = 0;
+}
+
+TowerSettings::TowerSettings(unsigned int seed, int platforms)
+{
+	*this = TowerSettings();
+	this->seed = seed;
+	this->platforms = platforms;
+}
+
+
+TowerGenerator::TowerGenerator()
+{
+	state = 1;
+	start = Point2f(100, -70);
+
+	//simulate a standing jump the way Player::getNewSpeed integrates it
+	Player probe(Point2f(20, 20), start);
+	float speedY = probe.jumpStartSpeedY + probe.gravity;
+	float height = 0, apex = 0;
+	int airborne = 0;
+	while (height >= 0){
+		height += speedY * TICK;
+		speedY += probe.gravity;
+		if (height > apex) apex = height;
+		airborne++;
+	}
+
+	//leave a margin, landings from below have to clear the platform's top edge
+	maxRise = apex * 0.7f;
+	maxGap = probe.maxSpeedX * (float)(airborne * TICK) * 0.5f;
+}
+
+
+TowerGenerator::~TowerGenerator()
+{
+}
+
+//xorshift32, the same sequence on every compiler unlike rand()
+unsigned int TowerGenerator::next(){
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+float TowerGenerator::range(float low, float high){
+	return low + (high - low) * (next() & 0xFFFFFF) / (float)0x1000000;
+}
+
+bool TowerGenerator::chance(float probability){
+	return range(0, 1) < probability;
+}
+
+void TowerGenerator::generate(const TowerSettings &settings, std::vector<CollidableObject> &obstacles){
+	typedef CollidableObject CO;
+	const TowerTextures &tex = settings.textures;
+	static const Color gateColours[3] = { CYAN, MAGENTA, YELLOW };
+
+	state = settings.seed ? settings.seed : 1;
+	obstacles.clear();
+	obstacles.reserve(settings.platforms * 2 + 8);
+
+	Point2f square(20, 20);
+
+	CO floor = CO(Point2f(400, 20), Point2f(start.x, start.y - 20), CO::PLATFORM);
+	obstacles.push_back(floor);
+
+	//the path starts from the player's feet, not the whole floor
+	float x = start.x;
+	float top = floor.transform.y + floor.box.halfHeight;
+	float width = 20;
+	//after a gate the path has to carry on away from it
+	float forcedDirection = 0;
+
+	//path platforms climb at least maxRise / 2 a step, so only the solids of the
+	//last few steps can be in the way of a new one
+	std::vector<Placed> recent;
+	Placed floorPlaced = { 0, extentOf(floor), floor.transform.x, false };
+	recent.push_back(floorPlaced);
+	std::vector<size_t> dropped;
+
+	for (int p = 0; p < settings.platforms; p++){
+		float newWidth = (chance(0.3f)) ? 40.f : (chance(0.8f)) ? 60.f : 100.f;
+
+		//next platform top within a jump of this one, always clear of it sideways
+		//so the player never has to jump up through it
+		float rise = range(maxRise * 0.5f, maxRise);
+		float gap = range(10, maxGap);
+		float direction = (chance(0.5f)) ? 1.f : -1.f;
+		if (forcedDirection != 0){
+			direction = forcedDirection;
+			forcedDirection = 0;
+		}
+		float roomRight = MAX_X - (x + width / 2) - newWidth;
+		float roomLeft = (x - width / 2) - MIN_X - newWidth;
+		float room = (direction > 0) ? roomRight : roomLeft;
+		//one side always has room, the field is wider than two platforms and a gap
+		if (room < 10){
+			direction = -direction;
+			room = (direction > 0) ? roomRight : roomLeft;
+		}
+		if (gap > room) gap = room;
+		float newX = x + direction * ((width + newWidth) / 2 + gap);
+
+		float newTop = top + rise;
+		CO platform = CO(Point2f(newWidth, 20), Point2f(newX, newTop - 10), CO::PLATFORM);
+
+		//the path comes first: a moving platform that sweeps into the new one
+		//stops at the spot the path used, a gate in its way goes
+		Extent spot = extentOf(platform);
+		for (size_t r = 0; r < recent.size(); r++){
+			if (!overlap(recent[r].extent, spot)){
+				continue;
+			}
+			if (recent[r].gate){
+				dropped.push_back(recent[r].index);
+				recent.erase(recent.begin() + r--);
+			}
+			else{
+				CO &placed = obstacles[recent[r].index];
+				placed = CO(Point2f(placed.box.halfWidth * 2, placed.box.halfHeight * 2), Point2f(recent[r].spotX, placed.transform.y), CO::PLATFORM);
+				recent[r].extent = extentOf(placed);
+			}
+		}
+
+		//moving platforms start moving right / up and come back, 40 units either way,
+		//so one end of the sweep is always the spot worked out above
+		float roll = range(0, 1);
+		if (roll < 0.08f){
+			float originX = (newX < (MIN_X + MAX_X) / 2) ? newX : newX - 40;
+			platform = CO(Point2f(newWidth, 20), Point2f(originX, newTop - 10), CO::MOVINGX);
+			platform.setMotionDuration(2);
+			platform.setSpeedMod(20);
+		}
+		else if (roll < 0.15f){
+			platform = CO(Point2f(newWidth, 20), Point2f(newX, newTop - 10), CO::MOVINGY);
+			platform.setMotionDuration(2);
+			platform.setSpeedMod(20);
+		}
+		//one that would sweep into something doesn't move at all
+		if (platform.platformType != CO::PLATFORM && hitsAny(recent, extentOf(platform))){
+			platform = CO(Point2f(newWidth, 20), Point2f(newX, newTop - 10), CO::PLATFORM);
+		}
+		Placed placedPlatform = { obstacles.size(), extentOf(platform), newX, false };
+		recent.push_back(placedPlatform);
+		obstacles.push_back(platform);
+
+		//enemies patrol the wide platforms, like platform8 in createLevel
+		if (platform.platformType == CO::PLATFORM && newWidth >= 100 && chance(0.3f)){
+			CO enemy = CO(square, Point2f(0, 0), CO::ENEMY);
+			enemy.setTexture(tex.enemyRight);
+			enemy.sprite.facing[0] = tex.enemyRight;
+			enemy.sprite.facing[1] = tex.enemyLeft;
+			enemy.setSpeedMod(10);
+			enemy.tieNPCtoPlatform(platform);
+			obstacles.push_back(enemy);
+		}
+		//pickups sit on the path, they never block it
+		else if (platform.platformType == CO::PLATFORM && chance(0.1f)){
+			bool isLambda = chance(0.7f);
+			CO pickup = CO(square, Point2f(0, 0), (isLambda) ? CO::LAMBDA : CO::CMYK);
+			pickup.setTexture((isLambda) ? tex.lambda : tex.cmyk);
+			pickup.tieNPCtoPlatform(platform);
+			obstacles.push_back(pickup);
+		}
+
+		//colour gate between the two platforms when there's room for one, tall
+		//enough not to be jumped over; the next step must have room to go on past it
+		float edgeGap = fabs(newX - x) - (width + newWidth) / 2;
+		float onwards = (newX > x) ? MAX_X - (newX + newWidth / 2) - 100 : (newX - newWidth / 2) - MIN_X - 100;
+		//(and clear of anything that moves through the gap)
+		if (platform.platformType != CO::MOVINGX && edgeGap >= 30 && onwards >= 10 && chance(0.15f)){
+			float side = (newX > x) ? 1.f : -1.f;
+			float gapMiddle = ((x + side * width / 2) + (newX - side * newWidth / 2)) / 2;
+			CO gate = CO(Point2f(10, 100), Point2f(gapMiddle, top + 50), CO::PLATFORM);
+			if (!hitsAny(recent, extentOf(gate))){
+				forcedDirection = side;
+				gate.setColour(gateColours[next() % 3]);
+				gate.setTexture(tex.glitch);
+				Placed placedGate = { obstacles.size(), extentOf(gate), gapMiddle, true };
+				recent.push_back(placedGate);
+				obstacles.push_back(gate);
+			}
+		}
+
+		x = newX;
+		top = newTop;
+		width = newWidth;
+
+		//nothing from the next step on reaches below the top just reached
+		for (size_t r = 0; r < recent.size(); r++){
+			if (recent[r].extent.maxY <= top){
+				recent.erase(recent.begin() + r--);
+			}
+		}
+	}
+
+	//take out the gates the path went through, in one pass
+	if (!dropped.empty()){
+		std::sort(dropped.begin(), dropped.end());
+		size_t write = dropped[0], d = 0;
+		for (size_t read = dropped[0]; read < obstacles.size(); read++){
+			if (d < dropped.size() && dropped[d] == read){
+				d++;
+				continue;
+			}
+			obstacles[write++] = obstacles[read];
+		}
+		obstacles.resize(write);
+	}
+
+	CO goal = CO(Point2f(40, 40), Point2f(x, top + 20), CO::HSV);
+	goal.setTexture(tex.hsv);
+	obstacles.push_back(goal);
+
+	//same tail as createLevel: ALPHAFLOOR, wallRight, wallLeft
+	float height = top - start.y + 2000;
+	CO floorDEATH = CO(Point2f(400, 400), Point2f(100, -600), CO::ALPHAFLOOR);
+	floorDEATH.setTexture(tex.death);
+	floorDEATH.setSpeedMod(15);
+	obstacles.push_back(floorDEATH);
+
+	CO wallRight = CO(Point2f(400, height), Point2f(490, start.y + height / 2 - 1000), CO::PLATFORM);
+	wallRight.permanent = true;
+	obstacles.push_back(wallRight);
+	CO wallLeft = CO(Point2f(400, height), Point2f(-300, start.y + height / 2 - 1000), CO::PLATFORM);
+	wallLeft.permanent = true;
+	obstacles.push_back(wallLeft);
+}
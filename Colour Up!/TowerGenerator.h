@@ -0,0 +1,61 @@
+#pragma once
+#include "CollidableObject.h"
+#include <vector>
+
+/*
+	Seeded procedural towers, for levels far bigger than the hand-built one.
+
+	The generator walks a path up the tower one platform at a time. Each step
+	stays inside what the player can actually jump (worked out from the Player
+	constants below), so every tower can be climbed from the starting floor to
+	the HSV goal. Around the path it scatters moving platforms, enemies on side
+	ledges, pickups and colour gates that need the matching bg to pass. None of
+	the solid ones overlap anywhere along their sweep: a moving platform that
+	would run into something is left standing, and a gate a later step of the
+	path comes back through is taken out.
+
+	The obstacle vector ends the same way createLevel's does: ALPHAFLOOR, then
+	the right and left walls, which PlayGame::update relies on.
+*/
+
+struct TowerTextures {
+	GLuint glitch;
+	GLuint enemyLeft, enemyRight;
+	GLuint lambda;
+	GLuint cmyk;
+	GLuint death;
+	GLuint hsv;
+};
+
+struct TowerSettings {
+	unsigned int seed;
+	int platforms;				//platforms on the climbing path
+	TowerTextures textures;		//all 0 when running without GL
+
+	TowerSettings();
+	TowerSettings(unsigned int, int);
+};
+
+class TowerGenerator
+{
+public:
+	TowerGenerator();
+	~TowerGenerator();
+
+	//replaces the contents of the vector
+	void generate(const TowerSettings&, std::vector<CollidableObject>&);
+
+	//highest rise and widest gap (edge to edge) a single jump is allowed
+	float maxRise;
+	float maxGap;
+
+	//where createPlayer puts the player, the tower starts just under it
+	Point2f start;
+
+private:
+	unsigned int next();
+	float range(float, float);
+	bool chance(float);
+
+	unsigned int state;
+};
@@ -0,0 +1,115 @@
+#include "TowerSweep.h"
+#include "PlayGame.h"
+#include "TowerGenerator.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+typedef std::chrono::high_resolution_clock SweepClock;
+
+static double elapsedUs(SweepClock::time_point from, SweepClock::time_point to){
+	return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+
+static void startGame(PlayGame &game){
+	game.turnOn();
+	game.resetState();
+	for (int i = 0; i < 256; i++){
+		game.keys[i] = false;
+	}
+}
+
+//no textures, so no createPlayer
+static void placePlayer(PlayGame &game){
+	game.player = Player(Point2<float>(20, 20), game.startingPosition);
+}
+
+void loadTower(PlayGame &game, unsigned int seed, int platforms){
+	startGame(game);
+	TowerGenerator generator;
+	generator.generate(TowerSettings(seed, platforms), game.obstacles);
+	game.prepareLevel();
+	placePlayer(game);
+}
+
+TowerSample measureTower(unsigned int seed, int platforms, int ticks){
+	const double dt = 1.0 / 60;
+	TowerSample sample;
+	sample.platforms = platforms;
+	sample.ticks = ticks;
+
+	PlayGame game;
+	startGame(game);
+
+	SweepClock::time_point t0 = SweepClock::now();
+	TowerGenerator generator;
+	generator.generate(TowerSettings(seed, platforms), game.obstacles);
+	SweepClock::time_point t1 = SweepClock::now();
+	game.prepareLevel();
+	SweepClock::time_point t2 = SweepClock::now();
+
+	sample.obstacles = game.obstacles.size();
+	sample.generateMs = elapsedUs(t0, t1) / 1000;
+	sample.prepareMs = elapsedUs(t1, t2) / 1000;
+
+	placePlayer(game);
+
+	double tickTotal = 0, collisionTotal = 0, drawTotal = 0;
+	double visible = 0, culled = 0, chunksDrawn = 0;
+	for (int t = 0; t < ticks; t++){
+		//PlayGame::update in its three parts, so the collision pass timed is
+		//the tick's own and the circle stats count one query pass per tick
+		SweepClock::time_point start = SweepClock::now();
+		game.beginUpdate(dt);
+		SweepClock::time_point collided = SweepClock::now();
+		game.checkForCollision(dt);
+		SweepClock::time_point end = SweepClock::now();
+		collisionTotal += elapsedUs(collided, end);
+		game.endUpdate(dt);
+		tickTotal += elapsedUs(start, SweepClock::now());
+
+		commandBuffer.clear();
+		start = SweepClock::now();
+		game.draw();
+		end = SweepClock::now();
+		drawTotal += elapsedUs(start, end);
+		visible += game.camera.submitted;
+		culled += game.camera.culled;
+		chunksDrawn += game.staticGeometry.drawn;
+	}
+	commandBuffer.clear();
+
+	sample.tickUs = tickTotal / ticks;
+	sample.collisionUs = collisionTotal / ticks;
+	sample.prunedPercent = game.colourLayers.pruneRate() * 100;
+	sample.drawUs = drawTotal / ticks;
+	sample.visible = visible / ticks;
+	sample.culled = culled / ticks;
+	sample.chunksDrawn = chunksDrawn / ticks;
+	sample.chunks = game.staticGeometry.chunks.size();
+	return sample;
+}
+
+void runTowerSweep(std::ostream &out, unsigned int seed){
+	out << std::setw(10) << "platforms" << std::setw(10) << "objects"
+		<< std::setw(12) << "gen ms" << std::setw(12) << "bake ms"
+		<< std::setw(12) << "tick us" << std::setw(14) << "collision us" << std::setw(10) << "pruned %"
+		<< std::setw(10) << "visible" << std::setw(10) << "culled" << std::setw(16) << "chunks drawn"
+		<< std::setw(12) << "draw us" << std::endl;
+
+	for (int platforms = 100; platforms <= 1000000; platforms *= 10){
+		//keep each size to a few seconds
+		int ticks = (platforms >= 1000000) ? 30 : (platforms >= 100000) ? 120 : 600;
+		TowerSample sample = measureTower(seed, platforms, ticks);
+		std::ostringstream chunksDrawn;
+		chunksDrawn << std::fixed << std::setprecision(1) << sample.chunksDrawn << " of " << sample.chunks;
+
+		out << std::fixed << std::setprecision(2)
+			<< std::setw(10) << sample.platforms << std::setw(10) << sample.obstacles
+			<< std::setw(12) << sample.generateMs << std::setw(12) << sample.prepareMs
+			<< std::setw(12) << sample.tickUs << std::setw(14) << sample.collisionUs << std::setw(10) << sample.prunedPercent
+			<< std::setw(10) << sample.visible << std::setw(10) << sample.culled
+			<< std::setw(16) << chunksDrawn.str() << std::setw(12) << sample.drawUs << std::endl;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <ostream>
+
+/*
+	Scaling sweep over generated towers.
+
+	For each size the tower is generated and baked, then PlayGame::update is
+	stepped at the game's fixed 60Hz with nobody at the keys. The whole tick
+	and, inside it, the tick's own collision pass are timed, and every tick
+	PlayGame::draw records a frame so the culling can be seen to hold up as
+	the tower grows. No window or GL context is needed.
+*/
+
+struct TowerSample {
+	int platforms;
+	int obstacles;
+	int ticks;
+	double generateMs;		//TowerGenerator::generate
+	double prepareMs;		//PlayGame::prepareLevel (bake, colour layers)
+	double tickUs;			//mean PlayGame::update
+	double collisionUs;		//mean PlayGame::checkForCollision
+	double prunedPercent;	//circles PlayGame::colourLayers rejected, of those tested
+	double drawUs;			//mean PlayGame::draw, recording only
+	//per frame, averaged: moving / pickup objects drawn and culled by the
+	//camera, and the static chunks drawn out of all of them
+	double visible;
+	double culled;
+	double chunksDrawn;
+	int chunks;
+};
+
+class PlayGame;
+
+//a generated tower in a fresh game, ready to update or draw (no textures needed)
+void loadTower(PlayGame&, unsigned int seed, int platforms);
+
+TowerSample measureTower(unsigned int seed, int platforms, int ticks);
+
+//N = 10^2 .. 10^6, one line per size
+void runTowerSweep(std::ostream&, unsigned int seed);
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+
+/*
+	Hands the latest of a stream of values from one producer thread to one
+	consumer thread, no locks and neither side ever waits for the other.
+
+	There are three slots: the producer fills its back slot, the consumer
+	reads its front slot and the third is in the middle. publish() swaps the
+	back slot with the middle one, take() swaps the middle one with the front
+	one if something was published since the last take. Both swaps are one
+	atomic exchange of the middle index (with a "fresh" bit on top), acquire
+	and release, so a slot's contents are visible before the index that hands
+	it over. A value published twice before it is taken is simply replaced,
+	the consumer only ever sees the most recent one.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() : middle(1), back(0), front(2) {}
+
+	//producer side: the slot to fill, it stays the producer's until publish()
+	T& writeSlot(){
+		return slots[back];
+	}
+
+	//producer side, true if the consumer never took the value this replaces
+	bool publish(){
+		unsigned int previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+		back = previous & INDEX;
+		return (previous & FRESH) != 0;
+	}
+
+	//producer side: take back a published value the consumer hasn't taken yet,
+	//for when it has gone stale. Harmless if it was taken in the meantime.
+	void discard(){
+		middle.fetch_and(INDEX, std::memory_order_relaxed);
+	}
+
+	//consumer side, true if readSlot() now holds a newer value
+	bool take(){
+		if (!(middle.load(std::memory_order_relaxed) & FRESH)){
+			return false;
+		}
+		front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+		return true;
+	}
+
+	//consumer side: the value from the last successful take()
+	const T& readSlot() const {
+		return slots[front];
+	}
+
+private:
+	enum { INDEX = 3, FRESH = 4 };
+
+	T slots[3];
+	//see SPSCQueue.h, VS2013 has no alignas
+	char padMiddle[64];
+	std::atomic<unsigned int> middle;
+	char padBack[64];
+	unsigned int back;			//producer's own
+	char padFront[64];
+	unsigned int front;			//consumer's own
+};
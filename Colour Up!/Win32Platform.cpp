@@ -0,0 +1,337 @@
+#include "Win32Platform.h"
+#include <mmsystem.h>
+#pragma comment(lib, "winmm.lib")
+
+typedef BOOL (WINAPI *SwapIntervalProc)(int);
+
+
+//WndProc has no way to reach the instance that created the window
+static Win32Platform *activePlatform = NULL;
+
+
+Win32Platform::Win32Platform()
+{
+	hDC = NULL;
+	hRC = NULL;
+	hWnd = NULL;
+	hInstance = NULL;
+	clientHeight = 0;
+	timerRaised = false;
+	QueryPerformanceFrequency(&frequency);
+}
+
+
+Win32Platform::~Win32Platform()
+{
+}
+
+bool Win32Platform::pollEvent(PlatformEvent &event){
+	MSG msg;
+	while (events.empty() && PeekMessage(&msg,NULL,0,0,PM_REMOVE))	// Is There A Message Waiting?
+	{
+		if (msg.message==WM_QUIT)				// Have We Received A Quit Message?
+		{
+			push(PlatformEvent::QUIT, 0, 0, 0);
+		}
+		else									// If Not, Deal With Window Messages
+		{
+			TranslateMessage(&msg);				// Translate The Message
+			DispatchMessage(&msg);				// Dispatch The Message (WndProc queues the input)
+		}
+	}
+
+	if (events.empty()){
+		return false;
+	}
+	event = events.front();
+	events.pop_front();
+	return true;
+}
+
+void Win32Platform::swapBuffers(){
+	SwapBuffers(hDC);				// Swap Buffers (Double Buffering)
+}
+
+double Win32Platform::now(){
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return counter.QuadPart / (double)frequency.QuadPart;
+}
+
+void Win32Platform::sleep(double seconds){
+	if (seconds >= 0.001){
+		Sleep((DWORD)(seconds * 1000));
+	}
+}
+
+bool Win32Platform::setVSync(bool on){
+	SwapIntervalProc swapInterval = (SwapIntervalProc)wglGetProcAddress("wglSwapIntervalEXT");
+	if (!swapInterval){
+		return false;
+	}
+	return swapInterval((on) ? 1 : 0) && on;
+}
+
+double Win32Platform::refreshRate(){
+	int rate = GetDeviceCaps(hDC, VREFRESH);
+	//0 and 1 mean "the hardware default", i.e. unknown
+	return (rate > 1) ? rate : 0;
+}
+
+//a WGL context is current on at most one thread at a time
+void Win32Platform::makeCurrent(bool current){
+	if (current){
+		wglMakeCurrent(hDC, hRC);
+	}
+	else{
+		wglMakeCurrent(NULL, NULL);
+	}
+}
+
+void Win32Platform::push(PlatformEvent::Type type, int key, int x, int y){
+	PlatformEvent event;
+	event.type = type;
+	event.key = key;
+	event.x = x;
+	event.y = y;
+	event.time = now();
+	//input messages carry when they were posted (GetTickCount milliseconds),
+	//which can be most of a frame before the pump gets to them
+	if (type != PlatformEvent::QUIT && type != PlatformEvent::RESIZE && type != PlatformEvent::EXPOSE){
+		DWORD age = GetTickCount() - (DWORD)GetMessageTime();
+		if (age < 1000){
+			event.time -= age / 1000.0;
+		}
+	}
+	events.push_back(event);
+}
+
+//WIN32 Processes function - turns the messages the game cares about into events
+LRESULT CALLBACK Win32Platform::WndProc(	HWND	hWnd,			// Handle For This Window
+							UINT	uMsg,			// Message For This Window
+							WPARAM	wParam,			// Additional Message Information
+							LPARAM	lParam)			// Additional Message Information
+{
+	Win32Platform *platform = activePlatform;
+	switch (uMsg)									// Check For Windows Messages
+	{
+		case WM_CLOSE:								// Did We Receive A Close Message?
+		{
+			PostQuitMessage(0);						// Send A Quit Message
+			return 0;								// Jump Back
+		}
+		break;
+
+		case WM_SIZE:								// Resize The OpenGL Window
+		{
+			platform->clientHeight = HIWORD(lParam);
+			platform->push(PlatformEvent::RESIZE, 0, LOWORD(lParam), HIWORD(lParam));  // LoWord=Width, HiWord=Height
+			return 0;								// Jump Back
+		}
+		break;
+
+		case WM_PAINT:								// Covered Or Restored, GL Has To Draw Again
+			platform->push(PlatformEvent::EXPOSE, 0, 0, 0);
+		break;								// DefWindowProc Validates It
+
+		case WM_LBUTTONDOWN:
+			platform->push(PlatformEvent::MOUSE_DOWN, 0, LOWORD(lParam), platform->clientHeight - HIWORD(lParam));
+		break;
+
+		case WM_LBUTTONUP:
+			platform->push(PlatformEvent::MOUSE_UP, 0, LOWORD(lParam), platform->clientHeight - HIWORD(lParam));
+		break;
+
+		case WM_MOUSEMOVE:
+			platform->push(PlatformEvent::MOUSE_MOVE, 0, LOWORD(lParam), platform->clientHeight - HIWORD(lParam));
+		break;
+
+		case WM_KEYDOWN:							// Is A Key Being Held Down?
+		{
+			if (wParam < 256)
+				platform->push(PlatformEvent::KEY_DOWN, (int)wParam, 0, 0);
+			return 0;								// Jump Back
+		}
+		break;
+		case WM_KEYUP:								// Has A Key Been Released?
+		{
+			if (wParam < 256)
+				platform->push(PlatformEvent::KEY_UP, (int)wParam, 0, 0);
+			return 0;								// Jump Back
+		}
+		break;
+	}
+
+	// Pass All Unhandled Messages To DefWindowProc
+	return DefWindowProc(hWnd,uMsg,wParam,lParam);
+}
+
+void Win32Platform::destroyWindow()				// Properly Kill The Window
+{
+	if (timerRaised)
+	{
+		timeEndPeriod(1);
+		timerRaised = false;
+	}
+
+	if (hRC)											// Do We Have A Rendering Context?
+	{
+		if (!wglMakeCurrent(NULL,NULL))					// Are We Able To Release The DC And RC Contexts?
+		{
+			MessageBox(NULL,"Release Of DC And RC Failed.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		}
+
+		if (!wglDeleteContext(hRC))						// Are We Able To Delete The RC?
+		{
+			MessageBox(NULL,"Release Rendering Context Failed.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		}
+		hRC=NULL;										// Set RC To NULL
+	}
+
+	if (hDC && !ReleaseDC(hWnd,hDC))					// Are We Able To Release The DC
+	{
+		MessageBox(NULL,"Release Device Context Failed.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		hDC=NULL;										// Set DC To NULL
+	}
+
+	if (hWnd && !DestroyWindow(hWnd))					// Are We Able To Destroy The Window?
+	{
+		MessageBox(NULL,"Could Not Release hWnd.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		hWnd=NULL;										// Set hWnd To NULL
+	}
+
+	if (!UnregisterClass("OpenGL",hInstance))			// Are We Able To Unregister Class
+	{
+		MessageBox(NULL,"Could Not Unregister Class.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		hInstance=NULL;									// Set hInstance To NULL
+	}
+}
+
+/*	This Code Creates Our OpenGL Window.  Parameters Are:					*
+ *	title			- Title To Appear At The Top Of The Window				*
+ *	width			- Width Of The GL Window Or Fullscreen Mode				*
+ *	height			- Height Of The GL Window Or Fullscreen Mode			*/
+ 
+
+bool Win32Platform::createWindow(const char* title, int width, int height)
+{
+	GLuint		PixelFormat;			// Holds The Results After Searching For A Match
+	WNDCLASS	wc;						// Windows Class Structure
+	DWORD		dwExStyle;				// Window Extended Style
+	DWORD		dwStyle;				// Window Style
+	RECT		WindowRect;				// Grabs Rectangle Upper Left / Lower Right Values
+	WindowRect.left=(long)0;			// Set Left Value To 0
+	WindowRect.right=(long)width;		// Set Right Value To Requested Width
+	WindowRect.top=(long)0;				// Set Top Value To 0
+	WindowRect.bottom=(long)height;		// Set Bottom Value To Requested Height
+
+	activePlatform		= this;									// WndProc queues its events here
+	clientHeight		= height;
+	hInstance			= GetModuleHandle(NULL);				// Grab An Instance For Our Window
+	wc.style			= CS_HREDRAW | CS_VREDRAW | CS_OWNDC;	// Redraw On Size, And Own DC For Window.
+	wc.lpfnWndProc		= (WNDPROC) Win32Platform::WndProc;					// WndProc Handles Messages
+	wc.cbClsExtra		= 0;									// No Extra Window Data
+	wc.cbWndExtra		= 0;									// No Extra Window Data
+	wc.hInstance		= hInstance;							// Set The Instance
+	wc.hIcon			= LoadIcon(NULL, IDI_WINLOGO);			// Load The Default Icon
+	wc.hCursor			= LoadCursor(NULL, IDC_ARROW);			// Load The Arrow Pointer
+	wc.hbrBackground	= NULL;									// No Background Required For GL
+	wc.lpszMenuName		= NULL;									// We Don't Want A Menu
+	wc.lpszClassName	= "OpenGL";								// Set The Class Name
+
+	if (!RegisterClass(&wc))									// Attempt To Register The Window Class
+	{
+		MessageBox(NULL,"Failed To Register The Window Class.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;											// Return FALSE
+	}
+	
+	dwExStyle=WS_EX_APPWINDOW | WS_EX_WINDOWEDGE;			// Window Extended Style
+	dwStyle=WS_OVERLAPPEDWINDOW;							// Windows Style
+	
+	AdjustWindowRectEx(&WindowRect, dwStyle, FALSE, dwExStyle);		// Adjust Window To True Requested Size
+
+	// Create The Window
+	if (!(hWnd=CreateWindowEx(	dwExStyle,							// Extended Style For The Window
+								"OpenGL",							// Class Name
+								title,								// Window Title
+								dwStyle |							// Defined Window Style
+								WS_CLIPSIBLINGS |					// Required Window Style
+								WS_CLIPCHILDREN,					// Required Window Style
+								900, 0,								// Window Position
+								WindowRect.right-WindowRect.left,	// Calculate Window Width
+								WindowRect.bottom-WindowRect.top,	// Calculate Window Height
+								NULL,								// No Parent Window
+								NULL,								// No Menu
+								hInstance,							// Instance
+								NULL)))								// Dont Pass Anything To WM_CREATE
+	{
+		destroyWindow();								// Reset The Display
+		MessageBox(NULL,"Window Creation Error.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;								// Return FALSE
+	}
+
+	static	PIXELFORMATDESCRIPTOR pfd=				// pfd Tells Windows How We Want Things To Be
+	{
+		sizeof(PIXELFORMATDESCRIPTOR),				// Size Of This Pixel Format Descriptor
+		1,											// Version Number
+		PFD_DRAW_TO_WINDOW |						// Format Must Support Window
+		PFD_SUPPORT_OPENGL |						// Format Must Support OpenGL
+		PFD_DOUBLEBUFFER,							// Must Support Double Buffering
+		PFD_TYPE_RGBA,								// Request An RGBA Format
+		24,										// Select Our Color Depth
+		0, 0, 0, 0, 0, 0,							// Color Bits Ignored
+		0,											// No Alpha Buffer
+		0,											// Shift Bit Ignored
+		0,											// No Accumulation Buffer
+		0, 0, 0, 0,									// Accumulation Bits Ignored
+		24,											// 24Bit Z-Buffer (Depth Buffer)  
+		0,											// No Stencil Buffer
+		0,											// No Auxiliary Buffer
+		PFD_MAIN_PLANE,								// Main Drawing Layer
+		0,											// Reserved
+		0, 0, 0										// Layer Masks Ignored
+	};
+	
+	if (!(hDC=GetDC(hWnd)))							// Did We Get A Device Context?
+	{
+		destroyWindow();								// Reset The Display
+		MessageBox(NULL,"Can't Create A GL Device Context.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;								// Return FALSE
+	}
+
+	if (!(PixelFormat=ChoosePixelFormat(hDC,&pfd)))	// Did Windows Find A Matching Pixel Format?
+	{
+		destroyWindow();								// Reset The Display
+		MessageBox(NULL,"Can't Find A Suitable PixelFormat.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;								// Return FALSE
+	}
+
+	if(!SetPixelFormat(hDC,PixelFormat,&pfd))		// Are We Able To Set The Pixel Format?
+	{
+		destroyWindow();								// Reset The Display
+		MessageBox(NULL,"Can't Set The PixelFormat.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;								// Return FALSE
+	}
+
+	if (!(hRC=wglCreateContext(hDC)))				// Are We Able To Get A Rendering Context?
+	{
+		destroyWindow();								// Reset The Display
+		MessageBox(NULL,"Can't Create A GL Rendering Context.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;								// Return FALSE
+	}
+
+	if(!wglMakeCurrent(hDC,hRC))					// Try To Activate The Rendering Context
+	{
+		destroyWindow();								// Reset The Display
+		MessageBox(NULL,"Can't Activate The GL Rendering Context.","ERROR",MB_OK|MB_ICONEXCLAMATION);
+		return false;								// Return FALSE
+	}
+
+	timerRaised = (timeBeginPeriod(1) == TIMERR_NOERROR);	// 1ms Sleep() Granularity For The Frame Pacing
+
+	ShowWindow(hWnd,SW_SHOW);						// Show The Window
+	SetForegroundWindow(hWnd);						// Slightly Higher Priority
+	SetFocus(hWnd);									// Sets Keyboard Focus To The Window
+	return true;									// Success
+}
+
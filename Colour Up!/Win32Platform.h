@@ -0,0 +1,45 @@
+#pragma once
+#include <windows.h>				// Header File For Windows
+#include <GL/gl.h>					// Header File For The OpenGL32 Library
+#include <deque>
+#include "Platform.h"
+
+/*
+	The window, WGL context and message pump that used to live in main.cpp.
+	WndProc no longer touches the game: it queues PlatformEvents, which
+	pollEvent hands out after pumping the pending messages.
+*/
+class Win32Platform : public Platform
+{
+public:
+	Win32Platform();
+	~Win32Platform();
+
+	bool createWindow(const char*, int, int);
+	void destroyWindow();
+
+	bool pollEvent(PlatformEvent&);
+	void swapBuffers();
+	//QueryPerformanceCounter, clock() only ticks every 15ms or so
+	double now();
+	//Sleep() with the timer resolution raised to 1ms while the window is up
+	void sleep(double);
+	//WGL_EXT_swap_control
+	bool setVSync(bool);
+	double refreshRate();
+	void makeCurrent(bool);
+
+private:
+	static LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
+	void push(PlatformEvent::Type, int, int, int);
+
+	HDC			hDC;			// Private GDI Device Context
+	HGLRC		hRC;			// Permanent Rendering Context
+	HWND		hWnd;			// Holds Our Window Handle
+	HINSTANCE	hInstance;		// Holds The Instance Of The Application
+	int			clientHeight;	// mouse y is flipped against it
+	bool		timerRaised;	// timeBeginPeriod(1) needs a matching timeEndPeriod
+
+	std::deque<PlatformEvent> events;
+	LARGE_INTEGER frequency;
+};
@@ -0,0 +1,222 @@
+#include "World.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+
+//in ComponentType order
+static const size_t componentSizes[STORED_COMPONENT_COUNT] = {
+	sizeof(Transform), sizeof(AABB), sizeof(Sprite), sizeof(Motion), sizeof(Pickup)
+};
+
+//no aligned new before C++17, so chunks come from the platform's aligned malloc
+static unsigned char *alignedAlloc(size_t bytes, size_t alignment){
+	void *block = 0;
+#ifdef _MSC_VER
+	block = _aligned_malloc(bytes, alignment);
+#else
+	if (posix_memalign(&block, alignment, bytes) != 0){
+		block = 0;
+	}
+#endif
+	if (!block){
+		throw std::bad_alloc();
+	}
+	return (unsigned char*)block;
+}
+
+static void alignedFree(void *block){
+#ifdef _MSC_VER
+	_aligned_free(block);
+#else
+	free(block);
+#endif
+}
+
+static size_t roundUp(size_t bytes, size_t to){
+	return (bytes + to - 1) / to * to;
+}
+
+
+//-----ARCHETYPE-----//
+
+//entity ids, then each stored component's array on a cache line of its own
+Archetype::Archetype(ComponentMask mask) : mask(mask){
+	size_t perEntity = sizeof(Entity);
+	size_t arrays = 1;
+	for (int t = 0; t < STORED_COMPONENT_COUNT; t++){
+		offsets[t] = 0;
+		if (stores(t)){
+			perEntity += componentSizes[t];
+			arrays++;
+		}
+	}
+
+	//leave room for every array to be padded out to the next line
+	capacity = (int)((World::CHUNK_BYTES - arrays * World::CACHE_LINE) / perEntity);
+
+	size_t offset = roundUp(capacity * sizeof(Entity), World::CACHE_LINE);
+	for (int t = 0; t < STORED_COMPONENT_COUNT; t++){
+		if (stores(t)){
+			offsets[t] = offset;
+			offset = roundUp(offset + capacity * componentSizes[t], World::CACHE_LINE);
+		}
+	}
+}
+
+Archetype::Archetype(const Archetype &other) : mask(other.mask), capacity(other.capacity){
+	for (int t = 0; t < STORED_COMPONENT_COUNT; t++){
+		offsets[t] = other.offsets[t];
+	}
+	//no destructor runs if this throws, so the chunks copied so far are freed here
+	chunks.reserve(other.chunks.size());
+	try{
+		for (size_t c = 0; c < other.chunks.size(); c++){
+			Chunk copy;
+			copy.data = alignedAlloc(World::CHUNK_BYTES, World::CACHE_LINE);
+			copy.count = other.chunks[c].count;
+			memcpy(copy.data, other.chunks[c].data, World::CHUNK_BYTES);
+			chunks.push_back(copy);
+		}
+	}
+	catch (...){
+		for (size_t c = 0; c < chunks.size(); c++){
+			alignedFree(chunks[c].data);
+		}
+		throw;
+	}
+}
+
+Archetype::~Archetype(){
+	for (size_t c = 0; c < chunks.size(); c++){
+		alignedFree(chunks[c].data);
+	}
+}
+
+void Archetype::allocate(Chunk *&chunk, int &row){
+	if (chunks.empty() || chunks.back().count == capacity){
+		Chunk fresh;
+		fresh.data = alignedAlloc(World::CHUNK_BYTES, World::CACHE_LINE);
+		fresh.count = 0;
+		chunks.push_back(fresh);
+	}
+	chunk = &chunks.back();
+	row = chunk->count++;
+}
+
+
+//-----WORLD-----//
+
+World::World(){
+	live = 0;
+}
+
+//as with Archetype, the archetypes copied before one that throws are deleted here
+World::World(const World &other) : records(other.records), live(other.live){
+	archetypes.reserve(other.archetypes.size());
+	try{
+		for (size_t a = 0; a < other.archetypes.size(); a++){
+			archetypes.push_back(new Archetype(*other.archetypes[a]));
+		}
+	}
+	catch (...){
+		for (size_t a = 0; a < archetypes.size(); a++){
+			delete archetypes[a];
+		}
+		throw;
+	}
+}
+
+//copied aside and swapped in, so a copy that throws leaves this world as it was
+World &World::operator=(const World &other){
+	if (this != &other){
+		World copy(other);
+		archetypes.swap(copy.archetypes);
+		records.swap(copy.records);
+		std::swap(live, copy.live);
+	}
+	return *this;
+}
+
+World::~World(){
+	clear();
+}
+
+int World::archetypeFor(ComponentMask mask){
+	for (size_t a = 0; a < archetypes.size(); a++){
+		if (archetypes[a]->mask == mask){
+			return (int)a;
+		}
+	}
+	archetypes.push_back(new Archetype(mask));
+	return (int)archetypes.size() - 1;
+}
+
+Entity World::create(ComponentMask mask){
+	Record record;
+	record.archetype = archetypeFor(mask);
+	Archetype &archetype = *archetypes[record.archetype];
+
+	Chunk *chunk;
+	archetype.allocate(chunk, record.row);
+	record.chunk = (int)archetype.chunks.size() - 1;
+
+	Entity e = (Entity)records.size();
+	records.push_back(record);
+	live++;
+
+	archetype.entities(*chunk)[record.row] = e;
+	for (int t = 0; t < STORED_COMPONENT_COUNT; t++){
+		if (archetype.stores(t)){
+			memset(chunk->data + archetype.offsets[t] + record.row * componentSizes[t], 0, componentSizes[t]);
+		}
+	}
+	return e;
+}
+
+//the archetype's last entity fills the hole; a dead or unknown id does nothing,
+//rather than moving some other entity into a slot that isn't its own
+void World::destroy(Entity e){
+	if (!alive(e)){
+		return;
+	}
+	Record &record = records[e];
+	Archetype &archetype = *archetypes[record.archetype];
+	Chunk &hole = archetype.chunks[record.chunk];
+	Chunk &last = archetype.chunks.back();
+	int lastRow = last.count - 1;
+
+	if (&hole != &last || record.row != lastRow){
+		Entity moved = archetype.entities(last)[lastRow];
+		archetype.entities(hole)[record.row] = moved;
+		for (int t = 0; t < STORED_COMPONENT_COUNT; t++){
+			if (archetype.stores(t)){
+				memcpy(hole.data + archetype.offsets[t] + record.row * componentSizes[t],
+					last.data + archetype.offsets[t] + lastRow * componentSizes[t], componentSizes[t]);
+			}
+		}
+		records[moved].chunk = record.chunk;
+		records[moved].row = record.row;
+	}
+
+	last.count--;
+	if (last.count == 0){
+		alignedFree(last.data);
+		archetype.chunks.pop_back();
+	}
+	record.archetype = -1;
+	live--;
+}
+
+void World::clear(){
+	for (size_t a = 0; a < archetypes.size(); a++){
+		delete archetypes[a];
+	}
+	archetypes.clear();
+	records.clear();
+	live = 0;
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include "Components.h"
+#include <vector>
+#include <cstddef>
+
+/*
+	Entities and their components, stored by archetype.
+
+	An archetype is one combination of components and tags. Its entities live
+	in fixed size chunks, and inside a chunk every stored component is an array
+	of its own starting on a cache line. A system that wants Transform and
+	Motion walks those two arrays and never pulls the sprites into the cache.
+	Tags take no space; they only decide which archetype an entity is in, so
+	a query for SlideX visits just the chunks of things that slide.
+
+	Entity ids are handed out in creation order and not reused until clear().
+	destroy() moves the last entity of the archetype into the hole, so the
+	order inside an archetype isn't kept. Anything that depends on creation
+	order (collisions resolve by it) keeps its own list of ids.
+*/
+
+typedef unsigned int Entity;
+typedef unsigned int ComponentMask;
+
+//a bit each in a ComponentMask; the stored ones first, in componentSizes order
+enum ComponentType{
+	COMPONENT_TRANSFORM, COMPONENT_AABB, COMPONENT_SPRITE, COMPONENT_MOTION, COMPONENT_PICKUP,
+	STORED_COMPONENT_COUNT,
+	TAG_SLIDEX = STORED_COMPONENT_COUNT, TAG_SLIDEY, TAG_PATROL, TAG_RISE,
+	TAG_STATIC, TAG_PERMANENT, TAG_DEADLY, TAG_GOAL, TAG_CARRIER, TAG_LIFT, TAG_POWERUP, TAG_NOHEIGHT,
+	COMPONENT_TYPE_COUNT
+};
+
+//component struct -> ComponentType
+template<class T> struct ComponentOf;
+
+#define WORLD_COMPONENT(T, ID) template<> struct ComponentOf<T> { enum { type = ID }; };
+WORLD_COMPONENT(Transform, COMPONENT_TRANSFORM)
+WORLD_COMPONENT(AABB, COMPONENT_AABB)
+WORLD_COMPONENT(Sprite, COMPONENT_SPRITE)
+WORLD_COMPONENT(Motion, COMPONENT_MOTION)
+WORLD_COMPONENT(Pickup, COMPONENT_PICKUP)
+WORLD_COMPONENT(SlideX, TAG_SLIDEX)
+WORLD_COMPONENT(SlideY, TAG_SLIDEY)
+WORLD_COMPONENT(Patrol, TAG_PATROL)
+WORLD_COMPONENT(Rise, TAG_RISE)
+WORLD_COMPONENT(Static, TAG_STATIC)
+WORLD_COMPONENT(Permanent, TAG_PERMANENT)
+WORLD_COMPONENT(Deadly, TAG_DEADLY)
+WORLD_COMPONENT(Goal, TAG_GOAL)
+WORLD_COMPONENT(Carrier, TAG_CARRIER)
+WORLD_COMPONENT(Lift, TAG_LIFT)
+WORLD_COMPONENT(PowerUp, TAG_POWERUP)
+WORLD_COMPONENT(NoHeight, TAG_NOHEIGHT)
+#undef WORLD_COMPONENT
+
+template<class T> inline ComponentMask maskOf(){ return 1u << ComponentOf<T>::type; }
+template<class A, class B> inline ComponentMask maskOf(){ return maskOf<A>() | maskOf<B>(); }
+template<class A, class B, class C> inline ComponentMask maskOf(){ return maskOf<A>() | maskOf<B>() | maskOf<C>(); }
+
+//one block of an archetype's entities
+struct Chunk {
+	unsigned char *data;	//World::CHUNK_BYTES, cache line aligned
+	int count;
+};
+
+class Archetype
+{
+public:
+	Archetype(ComponentMask);
+	//chunks and all
+	Archetype(const Archetype&);
+	~Archetype();
+
+	ComponentMask mask;
+	//entities a chunk has room for
+	int capacity;
+	//where each stored component's array starts in a chunk (the entity ids are at 0)
+	size_t offsets[STORED_COMPONENT_COUNT];
+	std::vector<Chunk> chunks;
+
+	bool stores(int type) const { return (mask & (1u << type)) != 0; }
+
+	Entity *entities(const Chunk &chunk) const { return (Entity*)chunk.data; }
+	template<class T> T *array(const Chunk &chunk) const {
+		static_assert((int)ComponentOf<T>::type < (int)STORED_COMPONENT_COUNT, "tags have no storage");
+		return (T*)(chunk.data + offsets[ComponentOf<T>::type]);
+	}
+
+	//a free row, adding a chunk when the last one is full
+	void allocate(Chunk *&chunk, int &row);
+
+private:
+	Archetype &operator=(const Archetype&);
+};
+
+class World
+{
+public:
+	enum { CHUNK_BYTES = 16 * 1024, CACHE_LINE = 64 };
+
+	World();
+	//copies every archetype's chunks; if a copy throws nothing is leaked, and
+	//an assignment leaves the world as it was
+	World(const World&);
+	World &operator=(const World&);
+	~World();
+
+	//a new entity in the archetype for the mask, every component zeroed
+	Entity create(ComponentMask);
+	//does nothing for an entity that isn't alive
+	void destroy(Entity);
+	//every entity and chunk gone, ids start from 0 again
+	void clear();
+
+	bool alive(Entity e) const { return e < records.size() && records[e].archetype >= 0; }
+	ComponentMask componentsOf(Entity e) const { return archetypes[records[e].archetype]->mask; }
+	bool has(Entity e, ComponentMask wanted) const { return (componentsOf(e) & wanted) == wanted; }
+	int size() const { return live; }
+
+	template<class T> T &get(Entity e){
+		const Record &r = records[e];
+		Archetype &a = *archetypes[r.archetype];
+		return a.array<T>(a.chunks[r.chunk])[r.row];
+	}
+	template<class T> const T &get(Entity e) const {
+		const Record &r = records[e];
+		const Archetype &a = *archetypes[r.archetype];
+		return a.array<T>(a.chunks[r.chunk])[r.row];
+	}
+
+	//-----QUERIES-----//
+	//fn(count, entities, A*, ...) once per chunk of every archetype holding the
+	//components and all of with, so the loop inside runs over plain arrays
+
+	template<class A, class F> void eachChunk(ComponentMask with, F fn){
+		ComponentMask wanted = with | maskOf<A>();
+		for (size_t a = 0; a < archetypes.size(); a++){
+			Archetype &archetype = *archetypes[a];
+			if ((archetype.mask & wanted) != wanted) continue;
+			for (size_t c = 0; c < archetype.chunks.size(); c++){
+				Chunk &chunk = archetype.chunks[c];
+				fn(chunk.count, archetype.entities(chunk), archetype.array<A>(chunk));
+			}
+		}
+	}
+
+	template<class A, class B, class F> void eachChunk(ComponentMask with, F fn){
+		ComponentMask wanted = with | maskOf<A, B>();
+		for (size_t a = 0; a < archetypes.size(); a++){
+			Archetype &archetype = *archetypes[a];
+			if ((archetype.mask & wanted) != wanted) continue;
+			for (size_t c = 0; c < archetype.chunks.size(); c++){
+				Chunk &chunk = archetype.chunks[c];
+				fn(chunk.count, archetype.entities(chunk), archetype.array<A>(chunk), archetype.array<B>(chunk));
+			}
+		}
+	}
+
+	template<class A, class B, class C, class F> void eachChunk(ComponentMask with, F fn){
+		ComponentMask wanted = with | maskOf<A, B, C>();
+		for (size_t a = 0; a < archetypes.size(); a++){
+			Archetype &archetype = *archetypes[a];
+			if ((archetype.mask & wanted) != wanted) continue;
+			for (size_t c = 0; c < archetype.chunks.size(); c++){
+				Chunk &chunk = archetype.chunks[c];
+				fn(chunk.count, archetype.entities(chunk), archetype.array<A>(chunk), archetype.array<B>(chunk), archetype.array<C>(chunk));
+			}
+		}
+	}
+
+	//fn(entity, A&, ...) per entity, in archetype order
+	template<class A, class F> void each(ComponentMask with, F fn){
+		eachChunk<A>(with, [&fn](int count, Entity *entities, A *a){
+			for (int i = 0; i < count; i++) fn(entities[i], a[i]);
+		});
+	}
+
+	template<class A, class B, class F> void each(ComponentMask with, F fn){
+		eachChunk<A, B>(with, [&fn](int count, Entity *entities, A *a, B *b){
+			for (int i = 0; i < count; i++) fn(entities[i], a[i], b[i]);
+		});
+	}
+
+	std::vector<Archetype*> archetypes;
+
+private:
+	struct Record {
+		int archetype;		//-1 once destroyed
+		int chunk;
+		int row;
+	};
+	std::vector<Record> records;
+	int live;
+
+	int archetypeFor(ComponentMask);
+};
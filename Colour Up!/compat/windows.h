@@ -0,0 +1,17 @@
+#pragma once
+
+/*
+	Stand-in for <windows.h> on platforms that don't have it.
+
+	Only the include directory of non-Windows builds points here. Most files
+	include windows.h because the Win32 GL headers need it; the only names the
+	game code actually uses from it are the virtual key codes below.
+*/
+
+//same values as winuser.h, the keys[] arrays are indexed by them
+#define VK_RETURN	0x0D
+#define VK_ESCAPE	0x1B
+#define VK_LEFT		0x25
+#define VK_UP		0x26
+#define VK_RIGHT	0x27
+#define VK_DOWN		0x28
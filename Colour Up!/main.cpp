@@ -1,450 +1,579 @@
 
-#include "KeyboardDefinitions.h";	// Header File for Keyboard Definitions
+#include "KeyboardDefinitions.h"	// Header File for Keyboard Definitions
 #include <windows.h>				// Header File For Windows
-#include "Image_Loading/nvImage.h"
-#include <gl\gl.h>					// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
-#include "GameObject.h"
-#include "BoundingBox.h"
-#include "CollidableObject.h"
-#include "Math/Point2.h"
-#include "Math/Point4.h"
-#include "Player.h"
-#include "console.h"				//Header File for Console	
-#include "Colour.h"
-#include "Clock.h"
-#include <vector>
-#include "ActivityManager.h"
-#include "StartGame.h"
-#include "PlayGame.h"
-#include "EndGame.h"
-
-
-//*****************FUNCTIONS****************//
-void				init();
-void				reshape(int width, int height);
-void				initialiseGame();
+#include <GL/gl.h>					// Header File For The OpenGL32 Library
+#include <GL/glu.h>
+#ifdef _WIN32
+#include "console.h"				//Header File for Console
+#include "Win32Platform.h"
+#include <direct.h>
+#define chdir _chdir
+#define getcwd _getcwd
+#else
+#include <unistd.h>
+#endif
+#ifdef COLOURUP_GLUT
+#include "GlutPlatform.h"
+#endif
+#include "HeadlessPlatform.h"
+#include "InputQueue.h"
+#include "FramePacer.h"
+#include "SimulationThread.h"
+#include "Game.h"
+#include "RenderState.h"
+#include "SoftwareRenderBackend.h"
+#include "TowerSweep.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifndef COLOURUP_DATA_DIR
+#define COLOURUP_DATA_DIR "."
+#endif
+
+#if defined(_WIN32) || defined(COLOURUP_GLUT)
+#define HAVE_WINDOW
+#endif
+
+/*
+	usage: colourup [--headless] [--realtime] [--frames <n>] [--script <file>]
+	                [--fps <n>] [--vsync] [--serial] [--size <w> <h>]
+	                [--png <file>] [--data <dir>] [--sweep]
+
+	--headless runs without a window or GL context (the only mode when the
+	build has no windowed platform): input comes from --script, see
+	HeadlessPlatform.h, or by default space is held for the first frames to
+	get past the start screen. --frames stops the run (default 600 headless),
+	--png saves the last frame through the software rasteriser. --data is
+	where textures and fonts are loaded from. --sweep prints the generated
+	tower scaling table and exits.
+
+	--fps is the frame rate the loop is paced to (default 60, 0 = as fast as
+	it goes), --vsync asks the swap to wait for vertical blank. Headless runs
+	keep virtual time unless --realtime is given, which really sleeps and so
+	shows how closely the pacing holds the rate. A virtual, uncapped run has
+	its swaps paced by the virtual display.
+
+	The simulation runs on its own thread (SimulationThread.h) and this one
+	only pumps events and draws the latest snapshot. --serial keeps both on
+	one thread, the way the game always ran; so do virtual clocks, which
+	only the loop moves, and platforms that can't move their context.
+*/
+
 
 //******************VARIABLES****************//
-int					screenWidth=1000;
-int					screenHeight=1000;
-int					displaySize = 300;
+//what the loop itself reacts to (escape, return), the activities keep their own
 bool keys[256];
-ActivityManager			activityManager;
-
-
-//OTHER 
-const int			FPS = 60;
-const double		TIME_PER_FRAME = 1.f / FPS;
-Point2f				startingPosition = Point2<float>(40, 10);
-Point2f				dimensionsHorizontal;
-Point2f				dimensionsVertical;
 
+#ifdef _WIN32
 ConsoleWindow		console;
-StartGame			startScreen;
-PlayGame			game;
-EndGame				endScreen;
+#endif
 
+//key and mouse events between the platform and the fixed steps
+static InputQueue				input;
 
+//sleeps the loop down to the target frame rate
+static FramePacer				pacer;
+//the window has to be drawn even if the activity isn't animated
+static bool						redrawNeeded = true;
 
+//set when the frames go to the software rasteriser instead of GL
+static SoftwareRenderBackend*	softwareBackend = NULL;
 
+//set while the game runs on its own thread, which then owns the view size
+static SimulationThread*		simulation = NULL;
 
-void init(void)
-{
+typedef std::chrono::steady_clock	CostClock;
 
-	activityManager.getActiveState()->init();
-	
-	
-	
-	
+static double elapsedUs(CostClock::time_point from, CostClock::time_point to){
+	return std::chrono::duration<double, std::micro>(to - from).count();
 }
 
-void display(void)
-{
-	activityManager.getActiveState()->draw();
-}
-
-void update(const double dt){
-
-	activityManager.update();
-	activityManager.getActiveState()->screenHeight = screenHeight;
-	activityManager.getActiveState()->screenWidth = screenWidth;
-	activityManager.getActiveState()->update(dt);
 
+//GL projection and the rasteriser's copy of it
+static void project(int width, int height, float halfWidth, float halfHeight){
+	setProjection(width, height, halfWidth, halfHeight);
+	if (softwareBackend){
+		softwareBackend->resize(width, height);
+		softwareBackend->setOrtho(-halfWidth, halfWidth, -halfHeight, halfHeight);
+	}
 }
 
-void initialiseGame(){
-	startScreen = StartGame();
-	game = PlayGame();
-	endScreen = EndGame();
-	activityManager.add(&startScreen);
-	activityManager.add(&game);
-	activityManager.add(&endScreen);
-	
-	
+//window size changed
+static void resize(int width, int height){
+	if (width <= 0 || height <= 0){
+		return;		//minimised
+	}
+	if (simulation){
+		//projected when the first snapshot recorded at the new size arrives
+		simulation->resize(width, height);
+		return;
+	}
+	resizeView(width, height);
+	project(width, height, viewHalfWidth, viewHalfHeight);
 }
 
-
-
-void reshape(int w, int h)
-{	
-	activityManager.getActiveState()->screenHeight = w;
-	activityManager.getActiveState()->screenWidth = h;
-	screenWidth=w;
-	screenHeight=h;
-		
-	int size = 0;
-	int wStart = 0;
-	int hStart = 0;
-	if (w>h){
-		size = h;
-		wStart = wStart + (w-h)/2;
+//quit and resize are dealt with straight away, input waits for its step
+static bool handleEvent(const PlatformEvent &event){
+	switch (event.type){
+	case PlatformEvent::QUIT:
+		return false;
+	case PlatformEvent::RESIZE:
+		resize(event.x, event.y);
+		redrawNeeded = true;
+		return true;
+	case PlatformEvent::EXPOSE:
+		redrawNeeded = true;
+		return true;
+	case PlatformEvent::KEY_DOWN:
+		keys[event.key] = true;
+		break;
+	case PlatformEvent::KEY_UP:
+		keys[event.key] = false;
+		break;
+	default:
+		break;
 	}
-	else{
-		size = w;
-		hStart = hStart + (h - w)/2;
-	}
-
-	//glViewport(wStart,hStart,(GLsizei) size, (GLsizei) size);
-	
-
-	glViewport(0,0,(GLsizei) w, (GLsizei) h);
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
-	
-	//specifying the coordinate system 
-	//-50 to 50 in the x axis
-	//-50 to 50 in the y axis
-	//gluOrtho2D(-200, 200, -200, 200);
-	
-	double aspectRatio = w/(double)h;
-	gluOrtho2D(-displaySize, displaySize, -displaySize/aspectRatio, displaySize/aspectRatio); 
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+	input.push(event);
+	return true;
 }
 
+static void printFrames(const char *label, const FrameStats &stats){
+	if (stats.frames > 0){
+		std::cout << label << stats.meanMs() << " ms avg, " << stats.stdDevMs() << " ms std dev, "
+				  << stats.minMs << "-" << stats.maxMs << " ms, " << stats.late << " late, "
+				  << stats.utilisation() * 100 << "% CPU" << std::endl;
+	}
+}
 
-#pragma region WIN32
-
-//WIN32 functions
-LRESULT	CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);	// Declaration For WndProc
-void KillGLWindow();									// releases and destroys the window
-bool CreateGLWindow(char* title, int width, int height); //creates the window
-int WINAPI WinMain(	HINSTANCE, HINSTANCE, LPSTR, int);  // Win32 main function
-
-//win32 global variabless
-HDC			hDC=NULL;		// Private GDI Device Context
-HGLRC		hRC=NULL;		// Permanent Rendering Context
-HWND		hWnd=NULL;		// Holds Our Window Handle
-HINSTANCE	hInstance;		// Holds The Instance Of The Application
-
+//how long each loop of one thread took, rather than the time between loops
+static void printWork(const char *label, const FrameStats &stats){
+	if (stats.frames > 0){
+		std::cout << label << stats.meanMs() << " ms avg, " << stats.stdDevMs() << " ms std dev, "
+				  << stats.maxMs << " ms max over " << stats.frames << " loops" << std::endl;
+	}
+}
 
-/******************* WIN32 FUNCTIONS ***************************/
-int WINAPI WinMain(	HINSTANCE	hInstance,			// Instance
-					HINSTANCE	hPrevInstance,		// Previous Instance
-					LPSTR		lpCmdLine,			// Command Line Parameters
-					int			nCmdShow)			// Window Show State
-{
-	MSG		msg;									// Windows Message Structure
-	bool	done=false;								// Bool Variable To Exit Loop
+static void printLatency(const char *label, const InputLatency &latency){
+	if (latency.events > 0){
+		std::cout << label << latency.totalMs / latency.events << " ms avg, "
+				  << latency.maxMs << " ms max over " << latency.events << " events" << std::endl;
+	}
+}
 
-	initialiseGame();
-	console.Open();
 
-	// Create Our OpenGL Window
-	if (!CreateGLWindow("OpenGL Win32 Example",screenWidth,screenHeight))
-	{
-		return 0;									// Quit If Window Was Not Created
-	}
+//*******************************************GAME LOOP***********************************************************//
 
-	Clock clock;
+//update, draw and swap one after the other
+static void runSerial(Platform &platform){
+	double lastTime = platform.now();
 	double timeSinceLastUpdate = 0.0;
-
-	Clock fpsCounterClock;
 	double fpsCounterTime = 0.0;
-	int fpsCounter = 0;
 
-	clock.start();
-	fpsCounterClock.start();
+	//what the work itself costs, whatever clock the platform keeps
+	long long ticks = 0, frames = 0, skipped = 0;
+	double updateTotal = 0, displayTotal = 0;
+	Activity *lastDrawn = NULL;
 
-	//*******************************************GAME LOOP***********************************************************//
-
-	while(!done)									// Loop That Runs While done=FALSE
+	bool done = false;
+	while (!done)
 	{
-		if (PeekMessage(&msg,NULL,0,0,PM_REMOVE))	// Is There A Message Waiting?
-		{
-			if (msg.message==WM_QUIT)				// Have We Received A Quit Message?
-			{
-				done=true;							// If So done=TRUE
-			}
-			else									// If Not, Deal With Window Messages
-			{
-				TranslateMessage(&msg);				// Translate The Message
-				DispatchMessage(&msg);				// Dispatch The Message
+		PlatformEvent event;
+		while (platform.pollEvent(event)){
+			if (!handleEvent(event)){
+				done = true;
 			}
 		}
-		else										// If There Are No Messages
-		{
-			if(keys[VK_ESCAPE])
-				done = true;
+		//whatever waited for the simulation to make room
+		input.flush();
+		if (done || keys[VK_ESCAPE]){
+			break;
+		}
 
-	
-			if (!keys[VK_RETURN]){
+		double now = platform.now();
+		double elapsed = now - lastTime;
+		lastTime = now;
 
-				fpsCounterTime += fpsCounterClock.restart();
+		//holding return pauses the simulation
+		if (!keys[VK_RETURN]){
+			fpsCounterTime += elapsed;
+			timeSinceLastUpdate += elapsed;
 
-				timeSinceLastUpdate += clock.restart();	
+			while (timeSinceLastUpdate > TIME_PER_FRAME) {
+				timeSinceLastUpdate -= TIME_PER_FRAME;
+				//the step simulates up to this point on the platform clock
+				double stepEnd = now - timeSinceLastUpdate;
 
-				while (timeSinceLastUpdate > TIME_PER_FRAME) {
-						
-						fpsCounter++;
-						timeSinceLastUpdate -= TIME_PER_FRAME;
+				CostClock::time_point start = CostClock::now();
+				input.beginStep(*activityManager.getActiveState(), stepEnd, now);
 				update(TIME_PER_FRAME);
-				}
-
-				
-				if (fpsCounterTime > 1){
-					fpsCounterTime = 0;
-					fpsCounter = 0;
-				}
-				
+				input.endStep();
+				updateTotal += elapsedUs(start, CostClock::now());
+				ticks++;
 			}
+
+			if (fpsCounterTime > 1){
+				std::cout << "GL state calls: " << renderState.lastFrame.submitted
+						  << " submitted, " << renderState.lastFrame.elided << " elided" << std::endl;
+				std::cout << "Objects: " << activityManager.getActiveState()->camera.submitted
+						  << " drawn, " << activityManager.getActiveState()->camera.culled << " culled" << std::endl;
+				printLatency("Input latency: ", input.latency);
+				printFrames("Frame times: ", pacer.period);
+				input.resetStats();
+				pacer.resetStats();
+				fpsCounterTime = 0;
+			}
+		}
+
+		//still screens are drawn once, then only when the window needs it
+		Activity *activity = activityManager.getActiveState();
+		bool drawing = redrawNeeded || activity != lastDrawn || activity->isAnimated();
+		if (drawing){
+			CostClock::time_point start = CostClock::now();
 			display();					// Draw The Scene
+			displayTotal += elapsedUs(start, CostClock::now());
+			frames++;
+			redrawNeeded = false;
+			lastDrawn = activity;
+		}
+		else{
+			skipped++;
+		}
 
-			SwapBuffers(hDC);				// Swap Buffers (Double Buffering)
+		pacer.wait(platform, drawing);
+		if (drawing){
+			platform.swapBuffers();
 		}
+		pacer.frameDone(platform);
 	}
 
+	std::cout << "ticks: " << ticks << ", frames: " << frames << std::endl;
+	if (ticks > 0){
+		std::cout << "update: " << updateTotal / ticks << " us/tick" << std::endl;
+	}
+	if (frames > 0){
+		std::cout << "display: " << displayTotal / frames << " us/frame" << std::endl;
+	}
+	if (skipped > 0){
+		std::cout << "redraws skipped: " << skipped << std::endl;
+	}
+	printFrames("frame times: ", pacer.total);
+	printLatency("input to simulation: ", input.total);
+}
 
 
-	console.Close();
 
-	// Shutdown
-	KillGLWindow();									// Kill The Window
-	return (int)(msg.wParam);						// Exit The Program
-}
+//this thread pumps events, draws the simulation's latest snapshot and swaps
+static void runThreaded(Platform &platform){
+	SimulationThread thread(platform, input);
+	simulation = &thread;
+	thread.start();
 
-//WIN32 Processes function - useful for responding to user inputs or other events.
-LRESULT CALLBACK WndProc(	HWND	hWnd,			// Handle For This Window
-							UINT	uMsg,			// Message For This Window
-							WPARAM	wParam,			// Additional Message Information
-							LPARAM	lParam)			// Additional Message Information
-{
-	switch (uMsg)									// Check For Windows Messages
+	double lastTime = platform.now();
+	double fpsCounterTime = 0.0;
+
+	long long frames = 0, skipped = 0;
+	double displayTotal = 0;
+	FrameStats renderWork, periodRenderWork, age;
+	renderWork.reset();
+	periodRenderWork.reset();
+	age.reset();
+	bool haveFrame = false;
+	int projectedWidth = screenWidth, projectedHeight = screenHeight;
+	float projectedHalfWidth = viewHalfWidth, projectedHalfHeight = viewHalfHeight;
+
+	bool done = false;
+	while (!done)
 	{
-		case WM_CLOSE:								// Did We Receive A Close Message?
-		{
-			PostQuitMessage(0);						// Send A Quit Message
-			return 0;								// Jump Back
+		PlatformEvent event;
+		while (platform.pollEvent(event)){
+			if (!handleEvent(event)){
+				done = true;
+			}
 		}
-		break;
-
-		case WM_SIZE:								// Resize The OpenGL Window
-		{
-			reshape(LOWORD(lParam),HIWORD(lParam));  // LoWord=Width, HiWord=Height
-			return 0;								// Jump Back
+		//whatever waited for the simulation to make room
+		input.flush();
+		if (done || keys[VK_ESCAPE] || thread.finished()){
+			break;
+		}
+		//holding return pauses the simulation
+		thread.setPaused(keys[VK_RETURN]);
+
+		if (thread.wantsContext()){
+			platform.makeCurrent(false);
+			thread.lendContext();
+			platform.makeCurrent(true);
+			//the last snapshot may point at fonts the load rebuilt
+			haveFrame = false;
 		}
-		break;
-
-		case WM_LBUTTONDOWN:
-			{
-			activityManager.getActiveState()->mouseXY.x = LOWORD(lParam);
-			activityManager.getActiveState()->mouseXY.y = screenHeight - HIWORD(lParam);
-			activityManager.getActiveState()->LMBPressed = true;
-			}
-		break;
-
-		case WM_LBUTTONUP:
-			{
-			activityManager.getActiveState()->LMBPressed = false;
-			}
-		break;
 
-		case WM_MOUSEMOVE:
-			{
-			activityManager.getActiveState()->mouseXY.x = LOWORD(lParam);
-			activityManager.getActiveState()->mouseXY.y = screenHeight - HIWORD(lParam);
+		CostClock::time_point start = CostClock::now();
+		bool fresh = thread.frames.take();
+		if (fresh){
+			haveFrame = true;
+		}
+		//no new snapshot means nothing changed, unless the window lost it
+		bool drawing = haveFrame && (fresh || redrawNeeded);
+		if (drawing){
+			const FrameSnapshot &frame = thread.frames.readSlot();
+			if (frame.width != projectedWidth || frame.height != projectedHeight
+				|| frame.halfWidth != projectedHalfWidth || frame.halfHeight != projectedHalfHeight){
+				project(frame.width, frame.height, frame.halfWidth, frame.halfHeight);
+				projectedWidth = frame.width;
+				projectedHeight = frame.height;
+				projectedHalfWidth = frame.halfWidth;
+				projectedHalfHeight = frame.halfHeight;
 			}
-		break;
-		case WM_KEYDOWN:							// Is A Key Being Held Down?
-		{
-			activityManager.getActiveState()->keys[wParam] = true;					// If So, Mark It As TRUE
-			return 0;								// Jump Back
+			renderState.beginFrame();
+			renderBackend->execute(frame.commands);
+
+			double us = elapsedUs(start, CostClock::now());
+			displayTotal += us;
+			renderWork.add(us / 1000, 0);
+			periodRenderWork.add(us / 1000, 0);
+			age.add((platform.now() - frame.time) * 1000, 0);
+			frames++;
+			redrawNeeded = false;
 		}
-		break;
-		case WM_KEYUP:								// Has A Key Been Released?
-		{
-			activityManager.getActiveState()->keys[wParam] = false;					// If So, Mark It As FALSE
-			return 0;								// Jump Back
+		else{
+			skipped++;
 		}
-		break;
-	}
 
-	// Pass All Unhandled Messages To DefWindowProc
-	return DefWindowProc(hWnd,uMsg,wParam,lParam);
-}
-
-void KillGLWindow()								// Properly Kill The Window
-{
-	if (hRC)											// Do We Have A Rendering Context?
-	{
-		if (!wglMakeCurrent(NULL,NULL))					// Are We Able To Release The DC And RC Contexts?
-		{
-			MessageBox(NULL,"Release Of DC And RC Failed.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		double now = platform.now();
+		fpsCounterTime += now - lastTime;
+		lastTime = now;
+		if (fpsCounterTime > 1 && haveFrame){
+			const FrameSnapshot &frame = thread.frames.readSlot();
+			std::cout << "GL state calls: " << renderState.lastFrame.submitted
+					  << " submitted, " << renderState.lastFrame.elided << " elided" << std::endl;
+			std::cout << "Objects: " << frame.drawn << " drawn, " << frame.culled << " culled" << std::endl;
+			printLatency("Input latency: ", frame.latency);
+			printWork("Simulation: ", frame.work);
+			printWork("Render: ", periodRenderWork);
+			printFrames("Frame times: ", pacer.period);
+			periodRenderWork.reset();
+			pacer.resetStats();
+			fpsCounterTime = 0;
 		}
 
-		if (!wglDeleteContext(hRC))						// Are We Able To Delete The RC?
-		{
-			MessageBox(NULL,"Release Rendering Context Failed.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
+		pacer.wait(platform, drawing);
+		if (drawing){
+			platform.swapBuffers();
 		}
-		hRC=NULL;										// Set RC To NULL
+		pacer.frameDone(platform);
 	}
 
-	if (hDC && !ReleaseDC(hWnd,hDC))					// Are We Able To Release The DC
-	{
-		MessageBox(NULL,"Release Device Context Failed.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
-		hDC=NULL;										// Set DC To NULL
+	thread.stop();
+	simulation = NULL;
+
+	std::cout << "ticks: " << thread.ticks << ", snapshots: " << thread.published
+			  << " (" << thread.overwritten << " never drawn), frames: " << frames << std::endl;
+	if (thread.ticks > 0){
+		std::cout << "update: " << thread.updateTotal / thread.ticks << " us/tick" << std::endl;
+	}
+	if (thread.published > 0){
+		std::cout << "record: " << thread.recordTotal / thread.published << " us/snapshot" << std::endl;
 	}
+	if (frames > 0){
+		std::cout << "display: " << displayTotal / frames << " us/frame" << std::endl;
+	}
+	if (skipped > 0){
+		std::cout << "redraws skipped: " << skipped << std::endl;
+	}
+	printWork("simulation thread: ", thread.work);
+	printWork("render thread: ", renderWork);
+	if (age.frames > 0){
+		std::cout << "snapshot age when drawn: " << age.meanMs() << " ms avg, " << age.maxMs << " ms max" << std::endl;
+	}
+	printFrames("frame times: ", pacer.total);
+	printLatency("input to simulation: ", input.total);
+}
 
-	if (hWnd && !DestroyWindow(hWnd))					// Are We Able To Destroy The Window?
-	{
-		MessageBox(NULL,"Could Not Release hWnd.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
-		hWnd=NULL;										// Set hWnd To NULL
+static int runGame(Platform &platform, bool vsync, bool threaded){
+	if (!platform.createWindow("Colour Up!", screenWidth, screenHeight)){
+		return 1;									// Quit If Window Was Not Created
 	}
+	pacer.setVSync(platform.setVSync(vsync), platform.refreshRate());
+	resize(screenWidth, screenHeight);
+	init();
 
-	if (!UnregisterClass("OpenGL",hInstance))			// Are We Able To Unregister Class
-	{
-		MessageBox(NULL,"Could Not Unregister Class.","SHUTDOWN ERROR",MB_OK | MB_ICONINFORMATION);
-		hInstance=NULL;									// Set hInstance To NULL
+	//a virtual clock is moved by the loop itself, a second thread would race it
+	if (threaded && platform.canMoveContext() && !platform.clockIsVirtual()){
+		runThreaded(platform);
+	}
+	else{
+		runSerial(platform);
 	}
-}
 
-/*	This Code Creates Our OpenGL Window.  Parameters Are:					*
- *	title			- Title To Appear At The Top Of The Window				*
- *	width			- Width Of The GL Window Or Fullscreen Mode				*
- *	height			- Height Of The GL Window Or Fullscreen Mode			*/
- 
-bool CreateGLWindow(char* title, int width, int height)
-{
-	GLuint		PixelFormat;			// Holds The Results After Searching For A Match
-	WNDCLASS	wc;						// Windows Class Structure
-	DWORD		dwExStyle;				// Window Extended Style
-	DWORD		dwStyle;				// Window Style
-	RECT		WindowRect;				// Grabs Rectangle Upper Left / Lower Right Values
-	WindowRect.left=(long)0;			// Set Left Value To 0
-	WindowRect.right=(long)width;		// Set Right Value To Requested Width
-	WindowRect.top=(long)0;				// Set Top Value To 0
-	WindowRect.bottom=(long)height;		// Set Bottom Value To Requested Height
-
-	hInstance			= GetModuleHandle(NULL);				// Grab An Instance For Our Window
-	wc.style			= CS_HREDRAW | CS_VREDRAW | CS_OWNDC;	// Redraw On Size, And Own DC For Window.
-	wc.lpfnWndProc		= (WNDPROC) WndProc;					// WndProc Handles Messages
-	wc.cbClsExtra		= 0;									// No Extra Window Data
-	wc.cbWndExtra		= 0;									// No Extra Window Data
-	wc.hInstance		= hInstance;							// Set The Instance
-	wc.hIcon			= LoadIcon(NULL, IDI_WINLOGO);			// Load The Default Icon
-	wc.hCursor			= LoadCursor(NULL, IDC_ARROW);			// Load The Arrow Pointer
-	wc.hbrBackground	= NULL;									// No Background Required For GL
-	wc.lpszMenuName		= NULL;									// We Don't Want A Menu
-	wc.lpszClassName	= "OpenGL";								// Set The Class Name
-
-	if (!RegisterClass(&wc))									// Attempt To Register The Window Class
-	{
-		MessageBox(NULL,"Failed To Register The Window Class.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;											// Return FALSE
-	}
-	
-	dwExStyle=WS_EX_APPWINDOW | WS_EX_WINDOWEDGE;			// Window Extended Style
-	dwStyle=WS_OVERLAPPEDWINDOW;							// Windows Style
-	
-	AdjustWindowRectEx(&WindowRect, dwStyle, FALSE, dwExStyle);		// Adjust Window To True Requested Size
-
-	// Create The Window
-	if (!(hWnd=CreateWindowEx(	dwExStyle,							// Extended Style For The Window
-								"OpenGL",							// Class Name
-								title,								// Window Title
-								dwStyle |							// Defined Window Style
-								WS_CLIPSIBLINGS |					// Required Window Style
-								WS_CLIPCHILDREN,					// Required Window Style
-								900, 0,								// Window Position
-								WindowRect.right-WindowRect.left,	// Calculate Window Width
-								WindowRect.bottom-WindowRect.top,	// Calculate Window Height
-								NULL,								// No Parent Window
-								NULL,								// No Menu
-								hInstance,							// Instance
-								NULL)))								// Dont Pass Anything To WM_CREATE
-	{
-		KillGLWindow();								// Reset The Display
-		MessageBox(NULL,"Window Creation Error.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;								// Return FALSE
+	platform.destroyWindow();
+
+	if (input.coalesced > 0){
+		std::cout << "input events coalesced: " << input.coalesced << std::endl;
 	}
+	return 0;
+}
 
-	static	PIXELFORMATDESCRIPTOR pfd=				// pfd Tells Windows How We Want Things To Be
-	{
-		sizeof(PIXELFORMATDESCRIPTOR),				// Size Of This Pixel Format Descriptor
-		1,											// Version Number
-		PFD_DRAW_TO_WINDOW |						// Format Must Support Window
-		PFD_SUPPORT_OPENGL |						// Format Must Support OpenGL
-		PFD_DOUBLEBUFFER,							// Must Support Double Buffering
-		PFD_TYPE_RGBA,								// Request An RGBA Format
-		24,										// Select Our Color Depth
-		0, 0, 0, 0, 0, 0,							// Color Bits Ignored
-		0,											// No Alpha Buffer
-		0,											// Shift Bit Ignored
-		0,											// No Accumulation Buffer
-		0, 0, 0, 0,									// Accumulation Bits Ignored
-		24,											// 24Bit Z-Buffer (Depth Buffer)  
-		0,											// No Stencil Buffer
-		0,											// No Auxiliary Buffer
-		PFD_MAIN_PLANE,								// Main Drawing Layer
-		0,											// Reserved
-		0, 0, 0										// Layer Masks Ignored
-	};
-	
-	if (!(hDC=GetDC(hWnd)))							// Did We Get A Device Context?
-	{
-		KillGLWindow();								// Reset The Display
-		MessageBox(NULL,"Can't Create A GL Device Context.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;								// Return FALSE
+
+static bool isAbsolute(const char *path){
+	return path[0] == '/' || path[0] == '\\' || (path[0] && path[1] == ':');
+}
+
+static int run(int argc, char **argv){
+	bool headless = false, realTime = false, vsync = false, threaded = true;
+	double fps = 60;
+	int frameLimit = 0;
+	int width = screenWidth, height = screenHeight;
+	const char *scriptPath = NULL;
+	const char *pngPath = NULL;
+	const char *dataDir = COLOURUP_DATA_DIR;
+
+	for (int a = 1; a < argc; a++){
+		if (!strcmp(argv[a], "--headless")){
+			headless = true;
+		}
+		else if (!strcmp(argv[a], "--realtime")){
+			realTime = true;
+		}
+		else if (!strcmp(argv[a], "--fps") && a + 1 < argc){
+			fps = atof(argv[++a]);
+		}
+		else if (!strcmp(argv[a], "--vsync")){
+			vsync = true;
+		}
+		else if (!strcmp(argv[a], "--serial")){
+			threaded = false;
+		}
+		else if (!strcmp(argv[a], "--frames") && a + 1 < argc){
+			frameLimit = atoi(argv[++a]);
+		}
+		else if (!strcmp(argv[a], "--script") && a + 1 < argc){
+			scriptPath = argv[++a];
+		}
+		else if (!strcmp(argv[a], "--size") && a + 2 < argc){
+			width = atoi(argv[++a]);
+			height = atoi(argv[++a]);
+		}
+		else if (!strcmp(argv[a], "--png") && a + 1 < argc){
+			pngPath = argv[++a];
+		}
+		else if (!strcmp(argv[a], "--data") && a + 1 < argc){
+			dataDir = argv[++a];
+		}
+		else if (!strcmp(argv[a], "--sweep") || !strcmp(argv[a], "-sweep")){
+			//scaling benchmark over generated towers, no window needed
+			runTowerSweep(std::cout, 1);
+			return 0;
+		}
+		else{
+			std::cerr << "usage: " << argv[0] << " [--headless] [--realtime] [--frames <n>] [--script <file>]"
+					  << " [--fps <n>] [--vsync] [--serial] [--size <w> <h>] [--png <file>] [--data <dir>] [--sweep]" << std::endl;
+			return 1;
+		}
+	}
+#ifndef HAVE_WINDOW
+	headless = true;
+#endif
+	if (width <= 0 || height <= 0){
+		std::cerr << "the size has to be positive" << std::endl;
+		return 1;
+	}
+	screenWidth = width;
+	screenHeight = height;
+	pacer.setTargetRate(fps);
+
+	//the script is read before changing to the data directory
+	HeadlessPlatform headlessPlatform;
+	if (headless){
+		if (scriptPath){
+			if (!headlessPlatform.loadScript(scriptPath)){
+				return 1;
+			}
+		}
+		else{
+			headlessPlatform.script(0, PlatformEvent::KEY_DOWN, VK_SPACE);
+			headlessPlatform.script(5, PlatformEvent::KEY_UP, VK_SPACE);
+		}
+		headlessPlatform.setFrameLimit((frameLimit > 0) ? frameLimit : 600);
+		headlessPlatform.realTime = realTime;
+		//virtual time has to be moved by something
+		if (!realTime && fps <= 0){
+			vsync = true;
+		}
+	}
+	else if (frameLimit > 0){
+		std::cerr << "--frames only applies to --headless runs" << std::endl;
 	}
 
-	if (!(PixelFormat=ChoosePixelFormat(hDC,&pfd)))	// Did Windows Find A Matching Pixel Format?
-	{
-		KillGLWindow();								// Reset The Display
-		MessageBox(NULL,"Can't Find A Suitable PixelFormat.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;								// Return FALSE
+	//the assets are loaded by relative name, the output isn't
+	std::string outPath;
+	if (pngPath){
+		outPath = pngPath;
+		char cwd[4096];
+		if (!isAbsolute(pngPath) && getcwd(cwd, sizeof(cwd))){
+			outPath = std::string(cwd) + "/" + pngPath;
+		}
+	}
+	if (chdir(dataDir) != 0){
+		std::cerr << "can't open the data directory " << dataDir << std::endl;
+		return 1;
 	}
 
-	if(!SetPixelFormat(hDC,PixelFormat,&pfd))		// Are We Able To Set The Pixel Format?
-	{
-		KillGLWindow();								// Reset The Display
-		MessageBox(NULL,"Can't Set The PixelFormat.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;								// Return FALSE
+	NullRenderBackend nullBackend;
+	SoftwareRenderBackend rasteriser((pngPath) ? width : 1, (pngPath) ? height : 1);
+	if (pngPath){
+		softwareBackend = &rasteriser;
+		renderBackend = &rasteriser;
+	}
+	else if (headless){
+		renderBackend = &nullBackend;
 	}
 
-	if (!(hRC=wglCreateContext(hDC)))				// Are We Able To Get A Rendering Context?
-	{
-		KillGLWindow();								// Reset The Display
-		MessageBox(NULL,"Can't Create A GL Rendering Context.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;								// Return FALSE
+	initialiseGame();
+
+	Platform *platform = &headlessPlatform;
+#if defined(_WIN32)
+	Win32Platform windowedPlatform;
+#elif defined(COLOURUP_GLUT)
+	GlutPlatform windowedPlatform(&argc, argv);
+#endif
+#ifdef HAVE_WINDOW
+	if (!headless){
+		platform = &windowedPlatform;
 	}
+#endif
 
-	if(!wglMakeCurrent(hDC,hRC))					// Try To Activate The Rendering Context
-	{
-		KillGLWindow();								// Reset The Display
-		MessageBox(NULL,"Can't Activate The GL Rendering Context.","ERROR",MB_OK|MB_ICONEXCLAMATION);
-		return false;								// Return FALSE
+	int result = runGame(*platform, vsync, threaded);
+
+	if (pngPath && !rasteriser.savePNG(outPath.c_str())){
+		std::cerr << "can't write " << outPath << std::endl;
+		return 1;
 	}
+	return result;
+}
 
-	ShowWindow(hWnd,SW_SHOW);						// Show The Window
-	SetForegroundWindow(hWnd);						// Slightly Higher Priority
-	SetFocus(hWnd);									// Sets Keyboard Focus To The Window
-	reshape(width, height);					// Set Up Our Perspective GL Screen
 
-	init();
-	
-	return true;									// Success
+#ifdef _WIN32
+
+int WINAPI WinMain(	HINSTANCE	hInstance,			// Instance
+					HINSTANCE	hPrevInstance,		// Previous Instance
+					LPSTR		lpCmdLine,			// Command Line Parameters
+					int			nCmdShow)			// Window Show State
+{
+	console.Open();
+	int result = run(__argc, __argv);
+	if (lpCmdLine && strstr(lpCmdLine, "-sweep")){
+		system("pause");
+	}
+	console.Close();
+	return result;
 }
 
-#pragma endregion WIN32 stuff
+#else
+
+int main(int argc, char **argv){
+	return run(argc, argv);
+}
 
+#endif
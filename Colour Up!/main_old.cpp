@@ -2,8 +2,8 @@
 #include "KeyboardDefinitions.h";	// Header File for Keyboard Definitions
 #include <windows.h>				// Header File For Windows
 #include "Image_Loading/nvImage.h"
-#include <gl\gl.h>					// Header File For The OpenGL32 Library
-#include <gl\glu.h>	
+#include <GL/gl.h>					// Header File For The OpenGL32 Library
+#include <GL/glu.h>	
 #include "GameObject.h"
 #include "BoundingBox.h"
 #include "CollidableObject.h"
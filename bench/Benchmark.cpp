@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+#include <chrono>
+#include <cstdio>
+
+static volatile double sinkValue;
+static const void * volatile sinkPointer;
+
+void benchSink(double value){
+	sinkValue = value;
+}
+
+void benchSink(const void *pointer){
+	sinkPointer = pointer;
+}
+
+//same sequence on every platform
+static unsigned int benchRandomState = 12345;
+
+float benchRandom(float low, float high){
+	benchRandomState ^= benchRandomState << 13;
+	benchRandomState ^= benchRandomState >> 17;
+	benchRandomState ^= benchRandomState << 5;
+	return low + (high - low) * (benchRandomState & 0xFFFFFF) / (float)0x1000000;
+}
+
+double benchNow(){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+BenchmarkRunner::BenchmarkRunner()
+{
+	minTime = 0.2;
+	repeats = 3;
+}
+
+void BenchmarkRunner::setFilter(const std::string &f){
+	filter = f;
+}
+
+bool BenchmarkRunner::wants(const std::string &name) const {
+	return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+BenchResult& BenchmarkRunner::run(const std::string &name, Kernel kernel, void *context){
+	//grow the batch until one takes long enough to time reliably
+	long long iterations = 1;
+	double elapsed = 0;
+	for (;;){
+		double start = benchNow();
+		kernel(iterations, context);
+		elapsed = benchNow() - start;
+		if (elapsed >= minTime / repeats || iterations >= (1LL << 40)){
+			break;
+		}
+		iterations *= (elapsed > 0) ? 2 : 8;
+	}
+
+	double best = elapsed;
+	for (int r = 1; r < repeats; r++){
+		double start = benchNow();
+		kernel(iterations, context);
+		double t = benchNow() - start;
+		if (t < best) best = t;
+	}
+
+	return add(name, iterations, best * 1e9 / iterations);
+}
+
+BenchResult& BenchmarkRunner::add(const std::string &name, long long iterations, double nsPerOp){
+	BenchResult result;
+	result.name = name;
+	result.iterations = iterations;
+	result.nsPerOp = nsPerOp;
+	results.push_back(result);
+	return results.back();
+}
+
+static void writeString(std::ostream &out, const std::string &s){
+	out << '"';
+	for (size_t i = 0; i < s.size(); i++){
+		if (s[i] == '"' || s[i] == '\\') out << '\\';
+		out << s[i];
+	}
+	out << '"';
+}
+
+static void writeNumber(std::ostream &out, double value){
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "%.3f", value);
+	out << buffer;
+}
+
+void BenchmarkRunner::writeJson(std::ostream &out) const {
+	out << "{\n  \"schema\": 1,\n  \"benchmarks\": [";
+	for (size_t i = 0; i < results.size(); i++){
+		const BenchResult &r = results[i];
+		out << ((i == 0) ? "\n" : ",\n") << "    {\"name\": ";
+		writeString(out, r.name);
+		out << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": ";
+		writeNumber(out, r.nsPerOp);
+		for (size_t c = 0; c < r.counters.size(); c++){
+			out << ", ";
+			writeString(out, r.counters[c].first);
+			out << ": ";
+			writeNumber(out, r.counters[c].second);
+		}
+		out << "}";
+	}
+	out << "\n  ]\n}\n";
+}
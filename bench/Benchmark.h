@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ostream>
+
+/*
+	Minimal timing harness for the colourup_bench executable.
+
+	Each kernel is run in growing batches until it has taken at least
+	minTime seconds, the best of a few repeats is reported as ns per op.
+	Results come out as JSON with a fixed layout (keys always in the same
+	order, kernels in registration order) so runs can be diffed commit to commit.
+*/
+
+struct BenchResult {
+	std::string name;
+	long long iterations;	//ops in the best repeat
+	double nsPerOp;
+	//optional extra numbers (e.g. object counts), written as-is
+	std::vector<std::pair<std::string, double> > counters;
+};
+
+//keeps the optimiser from throwing a kernel's result away
+void benchSink(double);
+void benchSink(const void*);
+
+class BenchmarkRunner
+{
+public:
+	typedef void(*Kernel)(long long iterations, void *context);
+
+	BenchmarkRunner();
+
+	//only run kernels whose name contains this
+	void setFilter(const std::string&);
+	bool wants(const std::string&) const;
+
+	BenchResult& run(const std::string &name, Kernel, void *context = 0);
+	//for measurements that time themselves (whole game ticks)
+	BenchResult& add(const std::string &name, long long iterations, double nsPerOp);
+
+	void writeJson(std::ostream&) const;
+
+	double minTime;
+	int repeats;
+	std::vector<BenchResult> results;
+
+private:
+	std::string filter;
+};
+
+double benchNow();	//seconds, monotonic
+//xorshift, the same sequence on every platform
+float benchRandom(float low, float high);
@@ -0,0 +1,1334 @@
+#include "Checks.h"
+#include "Benchmark.h"
+#include "BoundingCircles.h"
+#include "ColourLayers.h"
+#include "GLRenderBackend.h"
+#include "InputQueue.h"
+#include "Palette.h"
+#include "PlayGame.h"
+#include "RenderBackend.h"
+#include "RenderState.h"
+#include "SPSCQueue.h"
+#include "StaticGeometry.h"
+#include "SoftwareRenderBackend.h"
+#include "Systems.h"
+#include "TowerGenerator.h"
+#include "TowerSweep.h"
+#include "TripleBuffer.h"
+#include "Math/Affine2.h"
+#include "Math/FastMath.h"
+#include "Math/GeometryBatch.h"
+#include "Math/Matrix4SIMD.h"
+#include "Math/Point4.h"
+#include "Math/TransformBatch.h"
+#include "Math/UnitCircle.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int report(std::ostream &out, const std::string &name, double worst, double tolerance){
+	bool ok = worst <= tolerance;
+	out << (ok ? "ok   " : "FAIL ") << name << ": max difference " << worst
+		<< " (allowed " << tolerance << ")" << std::endl;
+	return ok ? 0 : 1;
+}
+
+//largest element difference, relative to the reference's largest element (or 1)
+template <typename Real> static double difference(const Real *a, const Real *reference, size_t count){
+	double scale = 1, worst = 0;
+	for (size_t i = 0; i < count; i++){
+		scale = std::max(scale, fabs((double)reference[i]));
+		worst = std::max(worst, fabs((double)a[i] - (double)reference[i]));
+	}
+	return worst / scale;
+}
+
+
+//-----MATRIX4-----//
+
+//rigid and scaled transforms about every axis, shears, and full matrices with
+//a projective bottom row; the full ones are diagonally dominant so they stay
+//well conditioned and the two inverses can be compared
+template <typename Real> static std::vector<Matrix4<Real> > checkMatrices(){
+	std::vector<Matrix4<Real> > matrices;
+	matrices.push_back(Matrix4<Real>());
+	for (int i = 0; i < 256; i++){
+		matrices.push_back(Matrix4<Real>::translate(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100))
+			* Matrix4<Real>::rotateX(benchRandom(0, 6.28f))
+			* Matrix4<Real>::rotateY(benchRandom(0, 6.28f))
+			* Matrix4<Real>::rotateZ(benchRandom(0, 6.28f))
+			* Matrix4<Real>::scale(benchRandom(0.5f, 2), benchRandom(0.5f, 2), benchRandom(0.5f, 2)));
+		matrices.push_back(Matrix4<Real>::shearX(benchRandom(-1, 1), benchRandom(-1, 1))
+			* Matrix4<Real>::rotateZ(benchRandom(0, 6.28f)));
+		Matrix4<Real> full;
+		for (int e = 0; e < 16; e++){
+			full.d[e] = benchRandom(-1, 1) + ((e % 5 == 0) ? 4 : 0);
+		}
+		matrices.push_back(full);
+	}
+	return matrices;
+}
+
+//exact is what the scalar order of operations gives, allowing for a compiler
+//that fuses multiply-adds in one path and not the other
+template <typename Real> static int checkMatrix4(std::ostream &out, const std::string &prefix, double exact, double inverseTolerance){
+	typedef Matrix4Scalar<Real> Scalar;
+	typedef Matrix4SIMD<Real> SIMD;
+	std::vector<Matrix4<Real> > matrices = checkMatrices<Real>();
+	std::string name = prefix + "/" + SIMD::isa();
+	int failures = 0;
+
+	double worst = 0;
+	for (size_t i = 0; i < matrices.size(); i++){
+		for (size_t j = 0; j < matrices.size(); j++){
+			Matrix4<Real> a = SIMD::multiply(matrices[i], matrices[j]);
+			Matrix4<Real> b = Scalar::multiply(matrices[i], matrices[j]);
+			worst = std::max(worst, difference(a.d, b.d, 16));
+		}
+	}
+	failures += report(out, name + " multiply", worst, exact);
+
+	worst = 0;
+	for (size_t i = 0; i < matrices.size(); i++){
+		Matrix4<Real> a = SIMD::transpose(matrices[i]);
+		Matrix4<Real> b = Scalar::transpose(matrices[i]);
+		worst = std::max(worst, difference(a.d, b.d, 16));
+	}
+	failures += report(out, name + " transpose", worst, 0);
+
+	worst = 0;
+	for (size_t i = 0; i < matrices.size(); i++){
+		Matrix4<Real> a = SIMD::inverse(matrices[i]);
+		Matrix4<Real> b = Scalar::inverse(matrices[i]);
+		worst = std::max(worst, difference(a.d, b.d, 16));
+	}
+	failures += report(out, name + " inverse", worst, inverseTolerance);
+
+	//odd count, so the last point isn't on a vector boundary
+	std::vector<Point3<Real> > points;
+	std::vector<Vector3<Real> > vectors;
+	for (int i = 0; i < 1023; i++){
+		points.push_back(Point3<Real>(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100)));
+		vectors.push_back(Vector3<Real>(benchRandom(-1, 1), benchRandom(-1, 1), benchRandom(-1, 1)));
+	}
+	std::vector<Point3<Real> > pointsA(points.size()), pointsB(points.size());
+	std::vector<Vector3<Real> > vectorsA(vectors.size()), vectorsB(vectors.size());
+
+	double worstPoints = 0, worstVectors = 0, worstInPlace = 0;
+	for (size_t i = 0; i < matrices.size(); i++){
+		SIMD::transformPoints(matrices[i], &points[0], &pointsA[0], points.size());
+		Scalar::transformPoints(matrices[i], &points[0], &pointsB[0], points.size());
+		worstPoints = std::max(worstPoints, difference(pointsA[0].v, pointsB[0].v, points.size() * 3));
+
+		SIMD::transformVectors(matrices[i], &vectors[0], &vectorsA[0], vectors.size());
+		Scalar::transformVectors(matrices[i], &vectors[0], &vectorsB[0], vectors.size());
+		worstVectors = std::max(worstVectors, difference(vectorsA[0].v, vectorsB[0].v, vectors.size() * 3));
+
+		pointsA = points;
+		SIMD::transformPoints(matrices[i], &pointsA[0], &pointsA[0], pointsA.size());
+		worstInPlace = std::max(worstInPlace, difference(pointsA[0].v, pointsB[0].v, points.size() * 3));
+	}
+	failures += report(out, name + " transform points", worstPoints, exact);
+	failures += report(out, name + " transform vectors", worstVectors, exact);
+	failures += report(out, name + " transform points in place", worstInPlace, exact);
+	return failures;
+}
+
+
+
+//-----BATCH TRANSFORMS-----//
+
+//the four layouts a span can be read from or written to; each keeps its own
+//storage and hands out PointSpans over it
+template <typename Real> struct CheckLayout {
+	const char *name;
+	//x y z followed by three Reals of something else, for the strided layout
+	std::vector<Real> aos, soa, strided;
+	size_t count;
+
+	CheckLayout(const char *name, size_t count)
+		: name(name), aos(count * 3), soa(count * 3), strided(count * 6), count(count) {}
+
+	PointSpan2<Real> span2(){
+		if (!strcmp(name, "aos")) return PointSpan2<Real>::strided(&aos[0], 2, count);
+		if (!strcmp(name, "soa")) return PointSpan2<Real>::soa(&soa[0], &soa[count], count);
+		return PointSpan2<Real>::strided(&strided[1], 6, count);
+	}
+
+	PointSpan3<Real> span3(){
+		if (!strcmp(name, "aos")) return PointSpan3<Real>::strided(&aos[0], 3, count);
+		if (!strcmp(name, "soa")) return PointSpan3<Real>::soa(&soa[0], &soa[count], &soa[count * 2], count);
+		return PointSpan3<Real>::strided(&strided[1], 6, count);
+	}
+};
+
+template <typename Real> static double spanDifference(const PointSpan2<Real> &a, const std::vector<Point2<Real> > &reference){
+	double worst = 0;
+	for (size_t i = 0; i < reference.size(); i++){
+		worst = std::max(worst, fabs((double)a.x[i * a.stride] - reference[i].x));
+		worst = std::max(worst, fabs((double)a.y[i * a.stride] - reference[i].y));
+	}
+	return worst;
+}
+
+template <typename Real> static double spanDifference(const PointSpan3<Real> &a, const std::vector<Point3<Real> > &reference){
+	double worst = 0;
+	for (size_t i = 0; i < reference.size(); i++){
+		worst = std::max(worst, fabs((double)a.x[i * a.stride] - reference[i].x));
+		worst = std::max(worst, fabs((double)a.y[i * a.stride] - reference[i].y));
+		worst = std::max(worst, fabs((double)a.z[i * a.stride] - reference[i].z));
+	}
+	return worst;
+}
+
+//every input layout into every output layout, and in place, against the
+//per-element operators; the batch adds in the same order so must match exactly
+template <typename Real> static int checkTransformBatch(std::ostream &out, const std::string &prefix){
+	typedef TransformBatch<Real> Batch;
+	const size_t count = 1023;
+	const char *layouts[] = { "aos", "soa", "strided" };
+	std::vector<Matrix4<Real> > matrices = checkMatrices<Real>();
+	matrices.resize(32);
+
+	std::vector<Point2<Real> > points2(count), expected2(count), expectedVectors2(count);
+	std::vector<Point3<Real> > points3(count), expected3(count), expectedVectors3(count);
+	for (size_t i = 0; i < count; i++){
+		points2[i] = Point2<Real>(benchRandom(-100, 100), benchRandom(-100, 100));
+		points3[i] = Point3<Real>(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100));
+	}
+
+	double worst2 = 0, worst3 = 0;
+	for (size_t m = 0; m < matrices.size(); m++){
+		const Matrix4<Real> &matrix = matrices[m];
+		for (size_t i = 0; i < count; i++){
+			expected2[i] = matrix * points2[i];
+			expectedVectors2[i] = Point2<Real>(matrix * points2[i].toVector2());
+			expected3[i] = matrix * points3[i];
+			expectedVectors3[i] = Point3<Real>(matrix * points3[i].toVector3());
+		}
+
+		for (int from = 0; from < 3; from++){
+			CheckLayout<Real> source(layouts[from], count);
+			PointSpan2<Real> in2 = source.span2();
+			PointSpan3<Real> in3 = source.span3();
+
+			for (int to = 0; to < 4; to++){
+				//the fourth is in place
+				CheckLayout<Real> target((to < 3) ? layouts[to] : layouts[from], count);
+				PointSpan2<Real> out2 = (to < 3) ? target.span2() : in2;
+				PointSpan3<Real> out3 = (to < 3) ? target.span3() : in3;
+
+				for (size_t i = 0; i < count; i++){
+					in2.x[i * in2.stride] = points2[i].x;
+					in2.y[i * in2.stride] = points2[i].y;
+				}
+				Batch::transformPoints2(matrix, in2, out2);
+				worst2 = std::max(worst2, spanDifference(out2, expected2));
+
+				for (size_t i = 0; i < count; i++){
+					in2.x[i * in2.stride] = points2[i].x;
+					in2.y[i * in2.stride] = points2[i].y;
+				}
+				Batch::transformVectors2(matrix, in2, out2);
+				worst2 = std::max(worst2, spanDifference(out2, expectedVectors2));
+
+				//the 3D layouts share storage with the 2D ones, so refill
+				for (size_t i = 0; i < count; i++){
+					in3.x[i * in3.stride] = points3[i].x;
+					in3.y[i * in3.stride] = points3[i].y;
+					in3.z[i * in3.stride] = points3[i].z;
+				}
+				Batch::transformPoints3(matrix, in3, out3);
+				worst3 = std::max(worst3, spanDifference(out3, expected3));
+
+				for (size_t i = 0; i < count; i++){
+					in3.x[i * in3.stride] = points3[i].x;
+					in3.y[i * in3.stride] = points3[i].y;
+					in3.z[i * in3.stride] = points3[i].z;
+				}
+				Batch::transformVectors3(matrix, in3, out3);
+				worst3 = std::max(worst3, spanDifference(out3, expectedVectors3));
+			}
+		}
+	}
+
+	int failures = 0;
+	failures += report(out, prefix + " batch transform 2d", worst2, 0);
+	failures += report(out, prefix + " batch transform 3d", worst3, 0);
+	return failures;
+}
+
+
+//-----AFFINE2-----//
+
+template <typename Real> static std::vector<Affine2<Real> > checkAffines(){
+	std::vector<Affine2<Real> > affines;
+	affines.push_back(Affine2<Real>());
+	for (int i = 0; i < 256; i++){
+		affines.push_back(Affine2<Real>::translate(benchRandom(-100, 100), benchRandom(-100, 100))
+			* Affine2<Real>::rotate(benchRandom(0, 6.28f))
+			* Affine2<Real>::scale(benchRandom(0.5f, 2), benchRandom(0.5f, 2)));
+		affines.push_back(Affine2<Real>(benchRandom(-1, 1) + 3, benchRandom(-1, 1), benchRandom(-100, 100),
+			benchRandom(-1, 1), benchRandom(-1, 1) + 3, benchRandom(-100, 100)));
+	}
+	return affines;
+}
+
+//the 2D part of a Matrix4 against an Affine2
+template <typename Real> static double affineDifference(const Affine2<Real> &a, const Matrix4<Real> &m){
+	Affine2<Real> reference(m);
+	return difference(a.d, reference.d, 6);
+}
+
+//Affine2 adds the same non-zero products in the same order as Matrix4, so
+//everything but the inverse has to agree exactly; A * A^-1 is compared with
+//the identity too, the float tolerance allows for translations of a few hundred
+template <typename Real> static int checkAffine2(std::ostream &out, const std::string &prefix, double inverseTolerance){
+	std::vector<Affine2<Real> > affines = checkAffines<Real>();
+	int failures = 0;
+
+	double worstConvert = 0, worstMultiply = 0, worstInverse = 0, worstTransform = 0;
+	for (size_t i = 0; i < affines.size(); i++){
+		Matrix4<Real> m = affines[i].toMatrix4();
+		worstConvert = std::max(worstConvert, affineDifference(affines[i], m));
+
+		for (size_t j = 0; j < affines.size(); j += 7){
+			worstMultiply = std::max(worstMultiply, affineDifference(affines[i] * affines[j], m * affines[j].toMatrix4()));
+		}
+
+		worstInverse = std::max(worstInverse, affineDifference(affines[i].inverse(), m.inverse()));
+		worstInverse = std::max(worstInverse, affineDifference(affines[i] * affines[i].inverse(), Matrix4<Real>()));
+
+		for (int p = 0; p < 16; p++){
+			Point2<Real> point(benchRandom(-100, 100), benchRandom(-100, 100));
+			Point2<Real> a = affines[i] * point, b = m * point;
+			Vector2<Real> va = affines[i] * point.toVector2(), vb = m * point.toVector2();
+			worstTransform = std::max(worstTransform, difference(a.v, b.v, 2));
+			worstTransform = std::max(worstTransform, difference(va.v, vb.v, 2));
+		}
+	}
+	failures += report(out, prefix + " to matrix4", worstConvert, 0);
+	failures += report(out, prefix + " multiply", worstMultiply, 0);
+	failures += report(out, prefix + " inverse", worstInverse, inverseTolerance);
+	failures += report(out, prefix + " transform", worstTransform, 0);
+
+	//and the batch transforms through an Affine2
+	const size_t count = 1023;
+	std::vector<Point2<Real> > points(count), batch(count);
+	double worstBatch = 0;
+	for (size_t i = 0; i < count; i++){
+		points[i] = Point2<Real>(benchRandom(-100, 100), benchRandom(-100, 100));
+	}
+	for (size_t i = 0; i < affines.size(); i++){
+		TransformBatch<Real>::transformPoints2(affines[i], PointSpan2<const Real>::aos(&points[0], count), PointSpan2<Real>::aos(&batch[0], count));
+		for (size_t p = 0; p < count; p++){
+			Point2<Real> expected = affines[i] * points[p];
+			worstBatch = std::max(worstBatch, difference(batch[p].v, expected.v, 2));
+		}
+		TransformBatch<Real>::transformVectors2(affines[i], PointSpan2<const Real>::aos(&points[0], count), PointSpan2<Real>::aos(&batch[0], count));
+		for (size_t p = 0; p < count; p++){
+			Vector2<Real> expected = affines[i] * points[p].toVector2();
+			worstBatch = std::max(worstBatch, difference(batch[p].v, expected.v, 2));
+		}
+	}
+	failures += report(out, prefix + " batch transform", worstBatch, 0);
+	return failures;
+}
+
+
+//-----GEOMETRY BATCH-----//
+
+//random segments and triangles (every fifth triangle wound the other way), plus
+//a degenerate one and duplicates so ties come up;
+//1027 of each so the scalar tail runs too
+template <typename Real> struct GeometrySoA {
+	std::vector<Real> ax, ay, bx, by, cx, cy;
+
+	GeometrySoA(){
+		for (int i = 0; i < 1027; i++){
+			Real x = benchRandom(-100, 100), y = benchRandom(-100, 100);
+			ax.push_back(x);
+			ay.push_back(y);
+			bx.push_back(x + benchRandom(-20, 20));
+			by.push_back(y + benchRandom(-20, 20));
+			cx.push_back(x + benchRandom(-10, 10));
+			cy.push_back(y + benchRandom(-10, 10));
+			if (i % 5 == 0){
+				std::swap(bx.back(), cx.back());
+				std::swap(by.back(), cy.back());
+			}
+		}
+		//a zero length segment, and so a triangle with no area
+		bx[3] = ax[3];
+		by[3] = ay[3];
+		for (int i = 600; i < 610; i++){
+			ax[i] = ax[i - 500]; ay[i] = ay[i - 500];
+			bx[i] = bx[i - 500]; by[i] = by[i - 500];
+			cx[i] = cx[i - 500]; cy[i] = cy[i - 500];
+		}
+	}
+
+	SegmentSpan2<Real> segments() const { return SegmentSpan2<Real>(&ax[0], &ay[0], &bx[0], &by[0], ax.size()); }
+	TriangleSpan2<Real> triangles() const { return TriangleSpan2<Real>(&ax[0], &ay[0], &bx[0], &by[0], &cx[0], &cy[0], ax.size()); }
+};
+
+//GeometryBatch against looping the templates it stands in for: the answers
+//(index, t, point) have to be identical, counted as mismatches
+template <typename Real> static int checkGeometryBatch(std::ostream &out, const std::string &prefix){
+	GeometrySoA<Real> soa;
+	SegmentSpan2<Real> segments = soa.segments();
+	TriangleSpan2<Real> triangles = soa.triangles();
+	int intersectMismatches = 0, nearestMismatches = 0, containsMismatches = 0, hits = 0, inside = 0;
+
+	for (int q = 0; q < 2000; q++){
+		Point2<Real> a(benchRandom(-150, 150), benchRandom(-150, 150));
+		//some lines straight through a segment's end points, to land on the bounds
+		Point2<Real> b = (q % 7 == 0) ? segments.get(q % segments.count).b : a + Vector2<Real>(benchRandom(-40, 40), benchRandom(-40, 40));
+		Segment2<Real> line(a, b);
+
+		size_t best = segments.count, index = 0;
+		Real bestT = 2, t = 0;
+		Point2<Real> bestPoint, point;
+		for (size_t i = 0; i < segments.count; i++){
+			Real ti;
+			Point2<Real> pi;
+			if (line.intersect(segments.get(i), ti, pi) && ti < bestT){
+				bestT = ti;
+				bestPoint = pi;
+				best = i;
+			}
+		}
+		bool found = GeometryBatch<Real>::nearestIntersection(line, segments, index, t, point);
+		hits += found;
+		if (found != (best != segments.count) || (found && (index != best || t != bestT || point != bestPoint))){
+			intersectMismatches++;
+		}
+
+		best = segments.count;
+		Real bestDistance = std::numeric_limits<Real>::infinity();
+		for (size_t i = 0; i < segments.count; i++){
+			Real ti;
+			Point2<Real> closest = segments.get(i).closestParamAndPointTo(a, ti);
+			if (a.sqrDistanceTo(closest) < bestDistance){
+				bestDistance = a.sqrDistanceTo(closest);
+				bestT = ti;
+				bestPoint = closest;
+				best = i;
+			}
+		}
+		found = GeometryBatch<Real>::nearestSegment(a, segments, index, t, point);
+		if (found != (best != segments.count) || (found && (index != best || t != bestT || point != bestPoint))){
+			nearestMismatches++;
+		}
+
+		best = triangles.count;
+		for (size_t i = 0; i < triangles.count && best == triangles.count; i++){
+			if (triangles.get(i).contains(a)){
+				best = i;
+			}
+		}
+		found = GeometryBatch<Real>::firstContaining(a, triangles, index);
+		inside += found;
+		if (found != (best != triangles.count) || (found && index != best)){
+			containsMismatches++;
+		}
+	}
+
+	int failures = 0;
+	failures += report(out, prefix + " nearest intersection (" + std::to_string(hits) + " hits), mismatches", intersectMismatches, 0);
+	failures += report(out, prefix + " nearest segment, mismatches", nearestMismatches, 0);
+	failures += report(out, prefix + " first containing triangle (" + std::to_string(inside) + " inside), mismatches", containsMismatches, 0);
+	return failures;
+}
+
+
+//-----BROAD PHASE-----//
+
+//BoundingCircles is only allowed to prune: every obstacle whose box collides
+//with the query box has to come back, in ascending order, before and after the
+//movers have moved. missed and unordered count queries that got it wrong.
+static int checkBoundingCircles(std::ostream &out){
+	typedef CollidableObject CO;
+	const CO::PlatformType types[] = { CO::PLATFORM, CO::MOVINGX, CO::MOVINGY, CO::ENEMY, CO::LAMBDA };
+	World world;
+	std::vector<Entity> obstacles;
+	for (int i = 0; i < 1027; i++){
+		Point2<float> size(benchRandom(5, 120), benchRandom(5, 20));
+		CollidableObject obstacle(size, Point2<float>(benchRandom(-1000, 1000), benchRandom(-1000, 1000)), types[i % 5]);
+		obstacle.setSpeedMod(40);
+		obstacle.setMotionDuration(2);
+		obstacle.motion.range = 60;
+		obstacles.push_back(spawnObstacle(world, obstacle));
+	}
+
+	BoundingCircles circles;
+	circles.assign(world, obstacles);
+	int missed = 0, unordered = 0;
+	double candidates = 0;
+	std::vector<int> near;
+	for (int pass = 0; pass < 2; pass++){
+		for (int q = 0; q < 2000; q++){
+			BoundingBox query(benchRandom(10, 300), benchRandom(10, 300));
+			query.x = benchRandom(-1100, 1100);
+			query.y = benchRandom(-1100, 1100);
+			int first = (q % 3 == 0) ? q % 1027 : 0;
+			circles.overlapping(query.x, query.y, query.halfWidth, query.halfHeight, first, near);
+			candidates += near.size();
+
+			for (size_t n = 1; n < near.size(); n++){
+				if (near[n] <= near[n - 1]){
+					unordered++;
+					break;
+				}
+			}
+			for (int i = first; i < (int)obstacles.size(); i++){
+				BoundingBox other(world.get<Transform>(obstacles[i]), world.get<AABB>(obstacles[i]));
+				if (query.collide(other) && !std::binary_search(near.begin(), near.end(), i)){
+					missed++;
+				}
+			}
+		}
+
+		//the second pass after a few seconds of movement
+		for (int t = 0; t < 300; t++){
+			moveObstacles(world, 1.0 / 60);
+			circles.update(world, obstacles);
+		}
+	}
+
+	std::string kept = std::to_string((int)(candidates / 4000)) + " of " + std::to_string(obstacles.size()) + " kept";
+	int failures = 0;
+	failures += report(out, "bounding circles (" + kept + ") missed collisions", missed, 0);
+	failures += report(out, "bounding circles out of order", unordered, 0);
+	return failures;
+}
+
+//ColourLayers splits the broad phase by layer. For every background, its
+//collidable() has to return exactly what one BoundingCircles over everything
+//returns minus the blended layer, and the per-layer queries together exactly
+//what the single one does.
+static int checkColourLayers(std::ostream &out){
+	const Color colours[] = { WHITE, CYAN, MAGENTA, YELLOW, RED };
+	const Color backgrounds[] = { BLACK, CYAN, MAGENTA, YELLOW };
+	World world;
+	std::vector<Entity> obstacles;
+	for (int i = 0; i < 1027; i++){
+		Point2<float> size(benchRandom(5, 120), benchRandom(5, 20));
+		CollidableObject obstacle(size, Point2<float>(benchRandom(-1000, 1000), benchRandom(-1000, 1000)), CollidableObject::PLATFORM);
+		obstacle.setColour(colours[(int)benchRandom(0, 4.99f)]);
+		obstacles.push_back(spawnObstacle(world, obstacle));
+	}
+
+	BoundingCircles all;
+	all.assign(world, obstacles);
+	ColourLayers layers;
+	layers.assign(world, obstacles);
+
+	Color previous = getBGColour();
+	int collidableWrong = 0, layersWrong = 0;
+	std::vector<int> near, expected, got, layer, merged;
+	for (int b = 0; b < 4; b++){
+		setBGColour(backgrounds[b]);
+		for (int q = 0; q < 500; q++){
+			float x = benchRandom(-1100, 1100), y = benchRandom(-1100, 1100);
+			float hw = benchRandom(10, 300), hh = benchRandom(10, 300);
+			int first = (q % 3 == 0) ? q % 1027 : 0;
+			all.overlapping(x, y, hw, hh, first, near);
+
+			expected.clear();
+			for (size_t n = 0; n < near.size(); n++){
+				if (!layers.isHidden(world.get<Sprite>(obstacles[near[n]]).color)){
+					expected.push_back(near[n]);
+				}
+			}
+			layers.collidable(x, y, hw, hh, first, got);
+			collidableWrong += (got != expected) ? 1 : 0;
+
+			merged.clear();
+			for (int l = 0; l < LAYER_COUNT; l++){
+				layers.overlapping((ColourLayer)l, x, y, hw, hh, first, layer);
+				merged.insert(merged.end(), layer.begin(), layer.end());
+			}
+			std::sort(merged.begin(), merged.end());
+			layersWrong += (merged != near) ? 1 : 0;
+		}
+	}
+	setBGColour(previous);
+
+	int failures = 0;
+	failures += report(out, "colour layers collidable vs filtered circles, queries differing", collidableWrong, 0);
+	failures += report(out, "colour layers per-layer queries vs one over all, queries differing", layersWrong, 0);
+	return failures;
+}
+
+
+//-----WORLD-----//
+
+//moveObstacles against stepping each CollidableObject on its own, which must
+//come out bit for bit the same; then every chunk array on a cache line, and
+//each entity still holding its own components after half of them are destroyed
+static int checkWorld(std::ostream &out){
+	typedef CollidableObject CO;
+	const CO::PlatformType types[] = { CO::PLATFORM, CO::MOVINGX, CO::MOVINGY, CO::ENEMY, CO::ALPHAFLOOR, CO::LAMBDA, CO::CMYK };
+	const int count = 3000;
+	World world;
+	std::vector<Entity> entities;
+	std::vector<CollidableObject> reference;
+	for (int i = 0; i < count; i++){
+		CollidableObject obstacle(Point2f(benchRandom(5, 120), 20), Point2f(benchRandom(-500, 500), benchRandom(-500, 500)), types[i % 7]);
+		obstacle.setSpeedMod(10 + i % 30);
+		obstacle.setMotionDuration(benchRandom(1, 4));
+		obstacle.motion.originX = obstacle.transform.x;
+		obstacle.motion.range = benchRandom(5, 40);
+		obstacle.sprite.facing[0] = 1;
+		obstacle.sprite.facing[1] = 2;
+		reference.push_back(obstacle);
+		entities.push_back(spawnObstacle(world, obstacle));
+	}
+
+	for (int t = 0; t < 600; t++){
+		moveObstacles(world, 1.0 / 60);
+		for (int i = 0; i < count; i++){
+			reference[i].move(1.0 / 60);
+		}
+	}
+	double moved = 0;
+	for (int i = 0; i < count; i++){
+		const Transform &transform = world.get<Transform>(entities[i]);
+		moved = std::max(moved, (double)std::fabs(transform.x - reference[i].transform.x));
+		moved = std::max(moved, (double)std::fabs(transform.y - reference[i].transform.y));
+		if (world.get<Sprite>(entities[i]).texture != reference[i].sprite.texture){
+			moved = std::max(moved, 1.0);
+		}
+	}
+
+	int misaligned = 0;
+	for (size_t a = 0; a < world.archetypes.size(); a++){
+		const Archetype &archetype = *world.archetypes[a];
+		for (size_t c = 0; c < archetype.chunks.size(); c++){
+			for (int t = 0; t < STORED_COMPONENT_COUNT; t++){
+				size_t start = (size_t)archetype.chunks[c].data + archetype.offsets[t];
+				if (archetype.stores(t) && start % World::CACHE_LINE != 0){
+					misaligned++;
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < count; i += 2){
+		world.destroy(entities[i]);
+	}
+	//destroying them again, or an id never handed out, mustn't touch the rest
+	for (int i = 0; i < count; i += 2){
+		world.destroy(entities[i]);
+	}
+	world.destroy(count + 100);
+	//and copies have to hold the same
+	World copied(world), assigned;
+	assigned.create(maskOf<Transform>());
+	assigned = copied;
+
+	int lost = (world.size() == count / 2 && copied.size() == count / 2 && assigned.size() == count / 2) ? 0 : 1;
+	for (int i = 1; i < count; i += 2){
+		if (!assigned.alive(entities[i]) || assigned.get<Transform>(entities[i]).x != world.get<Transform>(entities[i]).x){
+			lost++;
+		}
+		if (!world.alive(entities[i]) || world.has(entities[i], maskOf<Motion>()) != (reference[i].platformType != CO::PLATFORM
+			&& reference[i].platformType != CO::LAMBDA && reference[i].platformType != CO::CMYK)
+			|| world.get<AABB>(entities[i]).halfWidth != reference[i].box.halfWidth){
+			lost++;
+		}
+	}
+
+	int failures = 0;
+	failures += report(out, "world move vs CollidableObject::move", moved, 0);
+	failures += report(out, "world chunk arrays off a cache line", misaligned, 0);
+	failures += report(out, "world entities lost or mixed up by destroy or copy", lost, 0);
+	return failures;
+}
+
+
+//-----PALETTE-----//
+
+//the packed table against the float triples Colour.h used to hand to glColor3fv,
+//and the premultiplied variants against doing the sum in floats
+static int checkPalette(std::ostream &out){
+	const GLfloat floats[COLOR_COUNT][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, 0 }, { 1, 1, 1 }, { 0, 1, 1 }, { 1, 0, 1 }, { 1, 1, 0 } };
+	int mismatches = 0;
+	double worstUnpack = 0, worstPremultiplied = 0;
+	for (int c = 0; c < COLOR_COUNT; c++){
+		if (Palette::pack(floats[c]) != Palette::packed((Color)c)){
+			mismatches++;
+		}
+		GLfloat rgba[4];
+		Palette::unpack(Palette::packed((Color)c), rgba);
+		for (int i = 0; i < 4; i++){
+			worstUnpack = std::max(worstUnpack, fabs((double)rgba[i] - (i < 3 ? floats[c][i] : 1)));
+		}
+		for (unsigned int alpha = 0; alpha <= 255; alpha++){
+			PackedColour p = Palette::premultiplied((Color)c, alpha);
+			worstPremultiplied = std::max(worstPremultiplied, fabs(Palette::red(p) - (double)floats[c][0] * alpha));
+			worstPremultiplied = std::max(worstPremultiplied, fabs(Palette::green(p) - (double)floats[c][1] * alpha));
+			worstPremultiplied = std::max(worstPremultiplied, fabs(Palette::blue(p) - (double)floats[c][2] * alpha));
+			if (Palette::alpha(p) != alpha){
+				mismatches++;
+			}
+		}
+	}
+
+	int failures = 0;
+	failures += report(out, "palette packed table, mismatches", mismatches, 0);
+	failures += report(out, "palette unpack", worstUnpack, 0);
+	failures += report(out, "palette premultiplied (0..255)", worstPremultiplied, 0.5);
+	return failures;
+}
+
+
+//-----RENDER STATE-----//
+
+//what reached the GLDispatch, by entry point
+struct GLCalls {
+	int enables, disables, binds, blendFuncs, texEnvs, texParameters, colours;
+};
+static GLCalls glCalls;
+
+static void APIENTRY countEnable(GLenum){ glCalls.enables++; }
+static void APIENTRY countDisable(GLenum){ glCalls.disables++; }
+static void APIENTRY countBindTexture(GLenum, GLuint){ glCalls.binds++; }
+static void APIENTRY countBlendFunc(GLenum, GLenum){ glCalls.blendFuncs++; }
+static void APIENTRY countTexEnvf(GLenum, GLenum, GLfloat){ glCalls.texEnvs++; }
+static void APIENTRY countTexParameteri(GLenum, GLenum, GLint){ glCalls.texParameters++; }
+static void APIENTRY countGenTextures(GLsizei, GLuint*){}
+static void APIENTRY countColor4ubv(const GLubyte*){ glCalls.colours++; }
+
+static int countMismatches(const GLCalls &calls, const GLCalls &expected){
+	return (calls.enables != expected.enables) + (calls.disables != expected.disables)
+		+ (calls.binds != expected.binds) + (calls.blendFuncs != expected.blendFuncs)
+		+ (calls.texEnvs != expected.texEnvs) + (calls.texParameters != expected.texParameters)
+		+ (calls.colours != expected.colours);
+}
+
+static unsigned int callTotal(const GLCalls &calls){
+	return calls.enables + calls.disables + calls.binds + calls.blendFuncs + calls.texEnvs + calls.texParameters + calls.colours;
+}
+
+//a frame the way PlayGame records one (a colour before every obstacle) played
+//through GLRenderBackend's state setup into a counting GLDispatch. Without
+//elision every call has to get through, with it exactly the ones that change
+//something: counted by hand below.
+static int checkRenderState(std::ostream &out){
+	VertexBatch quad;
+	RenderVertex corners[4] = { { 0, 0, 0, 0 }, { 1, 0, 1, 0 }, { 1, 1, 1, 1 }, { 0, 1, 0, 1 } };
+	quad.vertices.assign(corners, corners + 4);
+	SharedBatch shared = std::make_shared<VertexBatch>(quad);
+	unsigned int red = Palette::packed(RED), blue = Palette::packed(BLUE);
+
+	CommandBuffer frame;
+	frame.clearColour(blue);
+	for (int i = 0; i < 3; i++){
+		frame.colour(red);
+		frame.begin(PRIM_QUADS);
+		frame.vertex(0, 0);
+		frame.vertex(1, 1);
+	}
+	for (int i = 0; i < 2; i++){
+		frame.colour(red);
+		frame.batch(shared, PRIM_QUADS, 1, TEX_MODULATE);
+	}
+	frame.pushMatrix();
+	frame.colour(blue);
+	frame.batch(shared, PRIM_QUADS, 2, TEX_REPLACE);
+	frame.popMatrix();
+	frame.colour(blue);
+	frame.begin(PRIM_POLYGON);
+	frame.vertex(0, 0);
+
+	GLDispatch counting;
+	counting.enable = countEnable;
+	counting.disable = countDisable;
+	counting.bindTexture = countBindTexture;
+	counting.blendFunc = countBlendFunc;
+	counting.texEnvf = countTexEnvf;
+	counting.texParameteri = countTexParameteri;
+	counting.genTextures = countGenTextures;
+	counting.color4ubv = countColor4ubv;
+
+	//4 untextured draws of 2 disables, 3 textured ones of 2 enables, a bind,
+	//a blend func, an env mode and 2 wrap modes, and 7 colours
+	const GLCalls everything = { 6, 8, 3, 3, 3, 6, 7 };
+	//red, then blue; texturing off, on for texture 1, 2 and off again
+	const GLCalls changes = { 2, 4, 2, 1, 2, 4, 2 };
+
+	int failures = 0;
+	for (int elide = 0; elide < 2; elide++){
+		RenderState state;
+		state.setDispatch(counting);
+		state.setElision(elide != 0);
+		memset(&glCalls, 0, sizeof(glCalls));
+		for (size_t c = 0; c < frame.commands.size(); c++){
+			applyRenderState(state, frame.commands[c]);
+		}
+		state.beginFrame();
+
+		const GLCalls &expected = elide ? changes : everything;
+		int mismatches = countMismatches(glCalls, expected);
+		unsigned int submitted = callTotal(everything), reached = callTotal(expected);
+		mismatches += (state.lastFrame.submitted != submitted) + (state.lastFrame.elided != submitted - reached);
+		failures += report(out, std::string("render state ") + (elide ? "with" : "without") + " elision, call counts off", mismatches, 0);
+	}
+	return failures;
+}
+
+
+//-----TOWERS-----//
+
+//where a platform can be: moving ones sweep 40 units right or up and back
+static BoundingBox sweptBox(const CollidableObject &object){
+	float sweepX = (object.platformType == CollidableObject::MOVINGX) ? 40.f : 0.f;
+	float sweepY = (object.platformType == CollidableObject::MOVINGY) ? 40.f : 0.f;
+	BoundingBox box(object.box.halfWidth * 2 + sweepX, object.box.halfHeight * 2 + sweepY);
+	box.x = object.transform.x + sweepX / 2;
+	box.y = object.transform.y + sweepY / 2;
+	return box;
+}
+
+static bool overlaps(const BoundingBox &a, const BoundingBox &b){
+	const float touching = 0.01f;
+	return fabs(a.x - b.x) < a.halfWidth + b.halfWidth - touching
+		&& fabs(a.y - b.y) < a.halfHeight + b.halfHeight - touching;
+}
+
+//seeded towers have to be climbable: each step of the path (the 20 high
+//platforms, in the order generated) no higher and no wider than
+//TowerGenerator's jump allows, measured from where a moving platform starts;
+//and nothing solid may overlap anything else solid anywhere along its sweep
+static int checkTowers(std::ostream &out){
+	typedef CollidableObject CO;
+	TowerGenerator generator;
+	std::vector<CO> obstacles;
+	int steps = 0, unreachable = 0, overlapping = 0;
+	double worstRise = 0, worstGap = 0;
+
+	for (unsigned int seed = 1; seed <= 20; seed++){
+		generator.generate(TowerSettings(seed, 500), obstacles);
+
+		std::vector<const CO*> path, solid;
+		for (size_t o = 0; o < obstacles.size(); o++){
+			const CO &object = obstacles[o];
+			bool platform = object.platformType == CO::PLATFORM || object.platformType == CO::MOVINGX || object.platformType == CO::MOVINGY;
+			if (!platform || object.permanent){
+				continue;
+			}
+			solid.push_back(&object);
+			if (object.box.halfHeight == 10){
+				path.push_back(&object);
+			}
+		}
+
+		for (size_t p = 1; p < path.size(); p++){
+			const CO &from = *path[p - 1], &to = *path[p];
+			double rise = (to.transform.y + to.box.halfHeight) - (from.transform.y + from.box.halfHeight);
+			//a moving platform only has to line up at one end of its sweep
+			double gap = 1e9;
+			for (int ends = 0; ends < 4; ends++){
+				float fromX = from.transform.x + ((from.platformType == CO::MOVINGX) ? 40.f * (ends & 1) : 0.f);
+				float toX = to.transform.x + ((to.platformType == CO::MOVINGX) ? 40.f * (ends >> 1) : 0.f);
+				gap = std::min(gap, (double)fabs(toX - fromX) - from.box.halfWidth - to.box.halfWidth);
+			}
+			worstRise = std::max(worstRise, rise);
+			worstGap = std::max(worstGap, gap);
+			if (rise <= 0 || rise > generator.maxRise || gap > generator.maxGap){
+				unreachable++;
+			}
+			steps++;
+		}
+
+		for (size_t a = 0; a < solid.size(); a++){
+			BoundingBox boxA = sweptBox(*solid[a]);
+			for (size_t b = a + 1; b < solid.size(); b++){
+				if (overlaps(boxA, sweptBox(*solid[b]))){
+					overlapping++;
+				}
+			}
+		}
+	}
+
+	std::ostringstream reach;
+	reach << "towers (" << steps << " steps, rise up to " << worstRise << " of " << generator.maxRise
+		<< ", gap up to " << worstGap << " of " << generator.maxGap << ") out of reach";
+	int failures = 0;
+	failures += report(out, reach.str(), unreachable, 0);
+	failures += report(out, "towers overlapping platforms", overlapping, 0);
+	return failures;
+}
+
+
+//-----SOFTWARE RASTER-----//
+
+static unsigned int randomRGBA(){
+	unsigned int rgba = 0;
+	for (int c = 0; c < 4; c++){
+		rgba |= (unsigned int)benchRandom(0, 255.99f) << (c * 8);
+	}
+	return rgba;
+}
+
+//flat and textured quads and triangles at every size and offset, modulated and
+//replaced, with translucent colours and texels, through the SSE2 spans and the
+//scalar ones. They are meant to agree bit for bit.
+static int checkSoftwareRaster(std::ostream &out){
+	const GLuint textures[2] = { 0x7fff0001, 0x7fff0002 };
+	for (int t = 0; t < 2; t++){
+		std::vector<unsigned char> texels(17 * 13 * 4);
+		for (size_t i = 0; i < texels.size(); i++){
+			texels[i] = (unsigned char)benchRandom(0, 255.99f);
+		}
+		textureStore.add(textures[t], 17, 13, GL_RGBA, &texels[0]);
+	}
+
+	const int width = 203, height = 151;
+	CommandBuffer frame;
+	frame.clearColour(Palette::packed(BLACK));
+	for (int i = 0; i < 600; i++){
+		frame.colour(randomRGBA());
+		float x = benchRandom(-20, width), y = benchRandom(-20, height);
+		float w = benchRandom(0.5f, 90), h = benchRandom(0.5f, 60);
+		float su = benchRandom(0.2f, 3), sv = benchRandom(0.2f, 3);
+		GLuint texture = textures[(i / 4) % 2];
+		switch (i % 4){
+		case 0:
+			frame.begin(PRIM_QUADS);
+			break;
+		case 1:
+			frame.begin(PRIM_QUADS, texture, TEX_MODULATE);
+			break;
+		case 2:
+			frame.begin(PRIM_QUADS, texture, TEX_REPLACE);
+			break;
+		default:
+			frame.begin(PRIM_POLYGON, texture, TEX_MODULATE);
+			frame.vertex(x, y, 0, 0);
+			frame.vertex(x + w, y + benchRandom(0, h), su, 0);
+			frame.vertex(x + benchRandom(0, w), y + h, 0, sv);
+			continue;
+		}
+		frame.vertex(x, y, 0, 0);
+		frame.vertex(x + w, y, su, 0);
+		frame.vertex(x + w, y + h, su, sv);
+		frame.vertex(x, y + h, 0, sv);
+	}
+
+	SoftwareRenderBackend simd(width, height), scalar(width, height);
+	scalar.simd = false;
+	simd.execute(frame);
+	scalar.execute(frame);
+	for (int t = 0; t < 2; t++){
+		textureStore.remove(textures[t]);
+	}
+
+	int worst = 0, differing = 0;
+	for (int p = 0; p < width * height; p++){
+		int pixelWorst = 0;
+		for (int c = 0; c < 4; c++){
+			int a = (simd.framebuffer[p] >> (c * 8)) & 0xFF, b = (scalar.framebuffer[p] >> (c * 8)) & 0xFF;
+			pixelWorst = std::max(pixelWorst, std::abs(a - b));
+		}
+		worst = std::max(worst, pixelWorst);
+		differing += (pixelWorst > 0) ? 1 : 0;
+	}
+	int failures = report(out, "software raster sse2 vs scalar (" + std::to_string(differing) + " pixels differ), channel", worst, 0);
+
+	//a texture that failed to load (0x0) draws like no texture at all
+	const GLuint unloaded = 0x7fff0003;
+	textureStore.add(unloaded, 0, 0, GL_RGBA, NULL);
+	CommandBuffer flat, missing;
+	for (int pass = 0; pass < 2; pass++){
+		CommandBuffer &quad = pass ? missing : flat;
+		quad.clearColour(Palette::packed(BLACK));
+		quad.colour(Palette::packed(CYAN));
+		if (pass){
+			quad.begin(PRIM_QUADS, unloaded, TEX_MODULATE);
+		}
+		else{
+			quad.begin(PRIM_QUADS);
+		}
+		quad.vertex(10, 10, 0, 0);
+		quad.vertex(90, 10, 1, 0);
+		quad.vertex(90, 60, 1, 1);
+		quad.vertex(10, 60, 0, 1);
+	}
+	SoftwareRenderBackend flatDrawn(100, 70), missingDrawn(100, 70);
+	flatDrawn.execute(flat);
+	missingDrawn.execute(missing);
+	textureStore.remove(unloaded);
+	int mismatched = 0;
+	for (size_t p = 0; p < flatDrawn.framebuffer.size(); p++){
+		mismatched += (flatDrawn.framebuffer[p] != missingDrawn.framebuffer[p]) ? 1 : 0;
+	}
+	failures += report(out, "software raster 0x0 texture vs untextured, pixels differing", mismatched, 0);
+	return failures;
+}
+
+
+//-----RECORDING-----//
+
+//the same game state drawn twice has to record the same frame: identical dumps
+//and an empty diff. And the diff has to notice a vertex that moved.
+static int checkRecording(std::ostream &out){
+	PlayGame game;
+	loadTower(game, 3, 2000);
+	for (int t = 0; t < 60; t++){
+		game.update(1.0 / 60);
+	}
+
+	RecordingRenderBackend recorder;
+	for (int pass = 0; pass < 2; pass++){
+		commandBuffer.clear();
+		game.draw();
+		recorder.execute(commandBuffer);
+	}
+	commandBuffer.clear();
+
+	std::ostringstream first, second, diffs;
+	RecordingRenderBackend::dump(recorder.frames[0], first);
+	RecordingRenderBackend::dump(recorder.frames[1], second);
+	int unstable = (first.str() != second.str() || first.str().empty()) ? 1 : 0;
+	int differences = RecordingRenderBackend::diff(recorder.frames[0], recorder.frames[1], diffs);
+
+	int missed = 1;
+	CommandBuffer moved = recorder.frames[1];
+	for (size_t c = 0; c < moved.commands.size(); c++){
+		if (moved.commands[c].type == CMD_DRAW && moved.commands[c].count > 0){
+			moved.vertices[moved.commands[c].first].x += 1;
+			missed = (RecordingRenderBackend::diff(recorder.frames[0], moved, diffs) == 1) ? 0 : 1;
+			break;
+		}
+	}
+
+	//a baked batch with no quads in it dumps as just its primitive
+	CommandBuffer empty;
+	empty.batch(std::make_shared<VertexBatch>(), PRIM_QUADS);
+	std::ostringstream emptyDump;
+	RecordingRenderBackend::dump(empty, emptyDump);
+	int emptyWrong = (emptyDump.str() != "BATCH QUADS\n") ? 1 : 0;
+
+	int failures = 0;
+	failures += report(out, "recording (" + std::to_string(recorder.frames[0].commands.size()) + " commands) dump changed between two draws", unstable, 0);
+	failures += report(out, "recording diff of two draws, differences", differences, 0);
+	failures += report(out, "recording diff missed a moved vertex", missed, 0);
+	failures += report(out, "recording dump of an empty batch wrong", emptyWrong, 0);
+	return failures;
+}
+
+
+//-----INPUT-----//
+
+static PlatformEvent inputEvent(PlatformEvent::Type type, int key, int x, double time){
+	PlatformEvent event;
+	event.type = type;
+	event.key = key;
+	event.x = x;
+	event.y = 0;
+	event.time = time;
+	return event;
+}
+
+//the ring hands items over in order across every wrap-around, and once
+//Capacity - 1 are in it refuses more without touching them. Then InputQueue
+//held up by a pause for far longer than the ring lasts: every key up and the
+//last mouse position have to get through. And a tap inside one step is down
+//for that step's update and up after it, not lost.
+static int checkInput(std::ostream &out){
+	SPSCQueue<int, 8> ring;
+	int item, pushed = 0, popped = 0, misordered = 0;
+	for (int round = 0; round < 100; round++){
+		//1 to 7 at a time, so head and tail wrap at every offset
+		int count = round % 7 + 1;
+		for (int i = 0; i < count; i++){
+			misordered += ring.push(pushed++) ? 0 : 1;
+		}
+		for (int i = 0; i < count; i++){
+			misordered += (ring.pop(item) && item == popped++) ? 0 : 1;
+		}
+	}
+	misordered += ring.pop(item) ? 1 : 0;
+
+	int full = 0;
+	for (int i = 0; i < 7; i++){
+		full += ring.push(100 + i) ? 0 : 1;
+	}
+	full += ring.push(200) ? 1 : 0;
+	for (int i = 0; i < 7; i++){
+		full += (ring.pop(item) && item == 100 + i) ? 0 : 1;
+	}
+	full += ring.empty() ? 0 : 1;
+
+	Activity activity;
+	memset(activity.keys, 0, sizeof(activity.keys));
+	InputQueue input;
+	input.push(inputEvent(PlatformEvent::KEY_DOWN, VK_A, 0, 0));
+	for (int i = 0; i < 5000; i++){
+		input.push(inputEvent(PlatformEvent::MOUSE_MOVE, 0, i, 0));
+		input.push(inputEvent(PlatformEvent::KEY_DOWN, VK_B, 0, 0));
+	}
+	input.push(inputEvent(PlatformEvent::KEY_UP, VK_A, 0, 0));
+	input.push(inputEvent(PlatformEvent::KEY_UP, VK_B, 0, 0));
+	input.push(inputEvent(PlatformEvent::MOUSE_MOVE, 0, 7000, 0));
+	//unpaused: a step per loop, each loop pumping events first
+	for (int step = 0; step < 4; step++){
+		input.flush();
+		input.beginStep(activity, 0, 0);
+		input.endStep();
+	}
+	int stuck = (activity.keys[VK_A] || activity.keys[VK_B] || activity.mouseXY.x != 7000) ? 1 : 0;
+
+	//down and up 2 ms apart, inside the step ending at 1 + 1/60
+	int tap = 0;
+	input.push(inputEvent(PlatformEvent::KEY_DOWN, VK_C, 0, 1.001));
+	input.push(inputEvent(PlatformEvent::KEY_UP, VK_C, 0, 1.003));
+	input.push(inputEvent(PlatformEvent::KEY_DOWN, VK_D, 0, 1.03));
+	input.beginStep(activity, 1 + 1.0 / 60, 1.02);
+	tap += (activity.keys[VK_C] && !activity.keys[VK_D]) ? 0 : 1;
+	input.endStep();
+	tap += activity.keys[VK_C] ? 1 : 0;
+	input.beginStep(activity, 1 + 2.0 / 60, 1.04);
+	tap += activity.keys[VK_D] ? 0 : 1;
+	input.endStep();
+
+	int failures = 0;
+	failures += report(out, "spsc queue order across wrap-arounds, mismatches", misordered, 0);
+	failures += report(out, "spsc queue when full, mismatches", full, 0);
+	failures += report(out, "input queue paused (" + std::to_string(input.coalesced) + " coalesced), keys stuck or moves lost", stuck, 0);
+	failures += report(out, "input queue tap within a step, mismatches", tap, 0);
+	return failures;
+}
+
+
+//-----SNAPSHOTS-----//
+
+//a frame as the simulation thread publishes it, with what its batches held
+//when it was recorded
+struct BatchFrame {
+	CommandBuffer commands;
+	double sum;
+};
+
+static double batchSum(const CommandBuffer &buffer){
+	double sum = 0;
+	for (size_t c = 0; c < buffer.commands.size(); c++){
+		const RenderCommand &command = buffer.commands[c];
+		if (command.type != CMD_BATCH){
+			continue;
+		}
+		const std::vector<RenderVertex> &vertices = buffer.batches[command.first]->vertices;
+		sum += (double)vertices.size();
+		for (size_t v = 0; v < vertices.size(); v++){
+			sum += vertices[v].x + vertices[v].y * 3;
+		}
+	}
+	return sum;
+}
+
+//PlayGame rebakes its StaticGeometry whenever a static obstacle is erased. Here
+//one is erased and the rest rebaked for every frame published, while the other
+//thread is still reading the frames it took; each one's batches have to hold
+//the vertices they were recorded with until it lets go of them
+static int checkRebake(std::ostream &out){
+	World world;
+	std::vector<Entity> entities;
+	for (int i = 0; i < 600; i++){
+		CollidableObject obstacle(Point2f(benchRandom(20, 120), 20), Point2f(benchRandom(-400, 400), i * 10.0f), CollidableObject::PLATFORM);
+		entities.push_back(spawnObstacle(world, obstacle));
+	}
+	StaticGeometry geometry;
+	geometry.bake(world, entities);
+	Camera camera;
+	camera.setOrtho(1000, 4000);
+	camera.centreOn(0, 3000);
+
+	TripleBuffer<BatchFrame> frames;
+	std::atomic<bool> finished(false);
+	std::atomic<int> taken(0);
+	std::thread producer([&](){
+		int published = 0;
+		while (entities.size() > 1){
+			size_t o = entities.size() / 3;
+			world.destroy(entities[o]);
+			entities.erase(entities.begin() + o);
+			geometry.bake(world, entities);
+
+			commandBuffer.clear();
+			geometry.draw(camera);
+			BatchFrame &frame = frames.writeSlot();
+			frame.commands.swap(commandBuffer);
+			frame.sum = batchSum(frame.commands);
+			frames.publish();
+			published++;
+			//so that the next rebake lands while the reader holds this one
+			while (taken.load() < published){
+				std::this_thread::yield();
+			}
+		}
+		finished.store(true);
+	});
+
+	int changed = 0;
+	while (!finished.load()){
+		if (frames.take()){
+			const BatchFrame &frame = frames.readSlot();
+			taken++;
+			double before = batchSum(frame.commands);
+			//and again once the producer has had time to rebake
+			std::this_thread::yield();
+			if (before != frame.sum || batchSum(frame.commands) != frame.sum){
+				changed++;
+			}
+		}
+	}
+	producer.join();
+	commandBuffer.clear();
+
+	int failures = 0;
+	failures += report(out, "static rebake with " + std::to_string(taken.load()) + " frames in flight, frames changed under the reader", changed, 0);
+	failures += report(out, "static rebake, no frame taken", taken.load() == 0 ? 1 : 0, 0);
+	return failures;
+}
+
+
+//-----CONSTEXPR-----//
+
+//the value types' constexpr operations, evaluated by the compiler; nothing to run,
+//a mistake is a build error (VS2013 has no constexpr and skips these)
+#ifdef MATH_HAS_CONSTEXPR
+static_assert(Vector2f(1, 2) + Vector2f(3, 4) == Vector2f(4, 6), "Vector2 +");
+static_assert(-Vector2f(1, 2) * 2 == Vector2f(-2, -4), "Vector2 * and unary -");
+static_assert(Vector2<double>(1, 2).dot(Vector2<double>(3, 4)) == 11, "Vector2 dot");
+static_assert(Vector2<double>(1, 0).cross(Vector2<double>(0, 1)) == 1, "Vector2 cross");
+static_assert(Vector2f(3, 4).sqrLength() == 25, "Vector2 sqrLength");
+static_assert(Vector2f(1, 2).getRotated90CCW() == Vector2f(-2, 1), "Vector2 rotate 90");
+static_assert(Point2f(5, 5) - Point2f(2, 1) == Vector2f(3, 4), "Point2 - Point2");
+static_assert(Point2f(0, 0).sqrDistanceTo(Point2f(3, 4)) == 25, "Point2 sqrDistanceTo");
+static_assert(Point2d::lerp(Point2d(0, 0), Point2d(10, 20), 0.5) == Point2d(5, 10), "Point2 lerp");
+static_assert(Point2d::areaOfTriangleTimes2(Point2d(0, 0), Point2d(2, 0), Point2d(0, 2)) == 4, "Point2 area");
+static_assert(Vector3<double>(1, 0, 0).cross(Vector3<double>(0, 1, 0)) == Vector3<double>(0, 0, 1), "Vector3 cross");
+static_assert(Vector3f(1, 2, 3).toVector2() == Vector2f(1, 2), "Vector3 toVector2");
+static_assert(Point3d(1, 2, 3) + Vector3<double>(1, 1, 1) == Point3d(2, 3, 4), "Point3 +");
+static_assert(Point3d::average(Point3d(0, 0, 0), Point3d(2, 4, 6)) == Point3d(1, 2, 3), "Point3 average");
+static_assert(Point4d(1, 2, 3, 2).inverseConvertToPoint3() == Point3d(2, 4, 6), "Point4 to Point3");
+#endif
+
+
+//-----FAST MATH-----//
+
+//FastMath against libm, over its documented range; the bounds are FastMath's own
+static int checkFastMath(std::ostream &out){
+	int failures = 0;
+
+	//every power of two (both mantissa extremes), then random mantissas
+	std::vector<float> values;
+	for (int e = -120; e <= 120; e++){
+		values.push_back(ldexpf(1.0f, e));
+		values.push_back(ldexpf(1.99999988f, e));
+	}
+	for (int i = 0; i < 100000; i++){
+		values.push_back(ldexpf(benchRandom(1, 2), (int)benchRandom(-120, 120)));
+	}
+	std::vector<float> batch(values.size());
+	FastMath::rsqrt(&values[0], &batch[0], values.size());
+	double worst = 0, worstBatch = 0;
+	for (size_t i = 0; i < values.size(); i++){
+		double exact = 1 / sqrt((double)values[i]);
+		worst = std::max(worst, fabs(FastMath::rsqrt(values[i]) - exact) / exact);
+		worstBatch = std::max(worstBatch, fabs((double)batch[i] - FastMath::rsqrt(values[i])));
+	}
+	failures += report(out, "fastmath rsqrt (relative)", worst, FastMath::rsqrtError());
+	failures += report(out, "fastmath rsqrt batch", worstBatch, 0);
+
+	//unit length, for the one-off and the batch (which has a scalar tail: 4n + 3 vectors)
+	std::vector<Vector3f> vectors, normalised(1023);
+	for (int i = 0; i < 1023; i++){
+		vectors.push_back(Vector3f(benchRandom(-1000, 1000), benchRandom(-1000, 1000), benchRandom(-1000, 1000)));
+	}
+	FastMath::normalise(&vectors[0], &normalised[0], vectors.size());
+	worst = worstBatch = 0;
+	for (size_t i = 0; i < vectors.size(); i++){
+		Vector3f one = FastMath::normalised(vectors[i]);
+		worst = std::max(worst, fabs((double)one.length() - 1));
+		worstBatch = std::max(worstBatch, fabs((double)normalised[i].length() - 1));
+	}
+	//rsqrt's error, plus a few roundings in the length and the scaling
+	failures += report(out, "fastmath normalised length", worst, FastMath::rsqrtError() + 1e-6);
+	failures += report(out, "fastmath normalise batch length", worstBatch, FastMath::rsqrtError() + 1e-6);
+
+	//a dense sweep round the circle, then the rest of the range
+	std::vector<float> angles;
+	for (int i = 0; i < 200000; i++){
+		angles.push_back(i < 100000 ? (i - 50000) * (float)(2 * M_PI / 50000) : benchRandom(-FastMath::sinCosRange(), FastMath::sinCosRange()));
+	}
+	std::vector<float> sines(angles.size()), cosines(angles.size());
+	FastMath::sinCos(&angles[0], &sines[0], &cosines[0], angles.size());
+	worst = worstBatch = 0;
+	for (size_t i = 0; i < angles.size(); i++){
+		double a = angles[i];
+		float s, c;
+		FastMath::sinCos(angles[i], s, c);
+		worst = std::max(worst, std::max(fabs(s - sin(a)), fabs(c - cos(a))));
+		worstBatch = std::max(worstBatch, std::max(fabs(sines[i] - sin(a)), fabs(cosines[i] - cos(a))));
+	}
+	failures += report(out, "fastmath sinCos (absolute)", worst, FastMath::sinCosError());
+	failures += report(out, "fastmath sinCos batch (absolute)", worstBatch, FastMath::sinCosError());
+
+	worst = 0;
+	for (int i = 0; i < 1000; i++){
+		Vector3f axis = Vector3f(benchRandom(-1, 1), benchRandom(-1, 1), benchRandom(-1, 1)).getNormalised();
+		float angle = benchRandom(-10, 10);
+		Quaternion<float> fast = FastMath::rotateAxis(axis, angle), exact = Quaternion<float>::rotateAxis(axis, angle);
+		float difference[4] = { fast.x - exact.x, fast.y - exact.y, fast.z - exact.z, fast.w - exact.w };
+		for (int j = 0; j < 4; j++){
+			worst = std::max(worst, fabs((double)difference[j]));
+		}
+	}
+	//the exact version rounds too, in sin and cos
+	failures += report(out, "fastmath quaternion rotateAxis", worst, FastMath::sinCosError() + 2e-7);
+
+	//the table is libm's, it has to match what Circle::draw used to compute exactly
+	UnitCircle<double, 72> circle;
+	worst = 0;
+	for (int i = 0; i < 360; i += 5){
+		worst = std::max(worst, fabs(circle.cosines[i / 5] - cos(i * (M_PI / 180))));
+		worst = std::max(worst, fabs(circle.sines[i / 5] - sin(i * (M_PI / 180))));
+	}
+	failures += report(out, "unit circle table", worst, 0);
+	return failures;
+}
+
+
+int runChecks(std::ostream &out){
+	int failures = 0;
+	failures += checkMatrix4<float>(out, "matrix4f", 1e-6, 1e-5);
+	failures += checkMatrix4<double>(out, "matrix4d", 1e-14, 1e-12);
+	failures += checkTransformBatch<float>(out, "matrix4f");
+	failures += checkTransformBatch<double>(out, "matrix4d");
+	failures += checkAffine2<float>(out, "affine2f", 1e-4);
+	failures += checkAffine2<double>(out, "affine2d", 1e-12);
+	failures += checkGeometryBatch<float>(out, "geometry2f");
+	failures += checkGeometryBatch<double>(out, "geometry2d");
+	failures += checkFastMath(out);
+	failures += checkBoundingCircles(out);
+	failures += checkColourLayers(out);
+	failures += checkWorld(out);
+	failures += checkPalette(out);
+	failures += checkRenderState(out);
+	failures += checkTowers(out);
+	failures += checkSoftwareRaster(out);
+	failures += checkRecording(out);
+	failures += checkInput(out);
+	failures += checkRebake(out);
+	return failures;
+}
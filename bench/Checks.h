@@ -0,0 +1,9 @@
+#pragma once
+#include <ostream>
+
+/*
+	Equivalence checks for the fast paths colourup_bench times against their
+	reference versions (colourup_bench --check). Each check prints one line
+	with the largest difference it saw; the return value is how many failed.
+*/
+int runChecks(std::ostream&);
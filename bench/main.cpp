@@ -0,0 +1,820 @@
+/*
+	colourup_bench - timings for the simulation and maths hot paths.
+
+	usage: colourup_bench [--filter <substring>] [--out <file.json>] [--full] [--check]
+
+	--full adds the 10^6 platform tower to the whole-tick runs (a few seconds
+	and a few hundred MB). JSON goes to stdout unless --out is given.
+	--check compares the SIMD paths against their scalar references instead
+	(see Checks.h) and fails if any differ by more than rounding.
+*/
+#include "Benchmark.h"
+#include "Checks.h"
+#include "BoundingBox.h"
+#include "Circle.h"
+#include "CollidableObject.h"
+#include "Palette.h"
+#include "Player.h"
+#include "PlayGame.h"
+#include "RenderBackend.h"
+#include "SoftwareRenderBackend.h"
+#include "Systems.h"
+#include "TowerSweep.h"
+#include "Math/Affine2.h"
+#include "Math/FastMath.h"
+#include "Math/GeometryBatch.h"
+#include "Math/Matrix4SIMD.h"
+#include "Math/TransformBatch.h"
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static const int SET_SIZE = 1024;		//power of two, indices are masked
+static const double TICK = 1.0 / 60;
+static const size_t BATCH_POINTS = 1000000;
+
+
+
+//-----BOUNDING VOLUMES-----//
+
+struct BoxSet {
+	std::vector<BoundingBox> boxes;
+	std::vector<Circle> circles;
+};
+
+static void fillBoxSet(BoxSet &set){
+	for (int i = 0; i < SET_SIZE; i++){
+		BoundingBox box(benchRandom(20, 100), 20);
+		box.x = benchRandom(-100, 290);
+		box.y = benchRandom(-100, 300);
+		set.boxes.push_back(box);
+		set.circles.push_back(Circle(box.x, box.y, benchRandom(10, 60)));
+	}
+}
+
+static void boundingBoxCollide(long long iterations, void *context){
+	BoxSet &set = *(BoxSet*)context;
+	int hits = 0;
+	for (long long i = 0; i < iterations; i++){
+		hits += set.boxes[i & (SET_SIZE - 1)].collide(set.boxes[(i * 7 + 1) & (SET_SIZE - 1)]);
+	}
+	benchSink(hits);
+}
+
+static void circleIntersectsCircle(long long iterations, void *context){
+	BoxSet &set = *(BoxSet*)context;
+	int hits = 0;
+	for (long long i = 0; i < iterations; i++){
+		hits += set.circles[i & (SET_SIZE - 1)].intersects(set.circles[(i * 7 + 1) & (SET_SIZE - 1)]);
+	}
+	benchSink(hits);
+}
+
+static void circleIntersectsBox(long long iterations, void *context){
+	BoxSet &set = *(BoxSet*)context;
+	int hits = 0;
+	for (long long i = 0; i < iterations; i++){
+		hits += set.circles[i & (SET_SIZE - 1)].intersects(set.boxes[(i * 7 + 1) & (SET_SIZE - 1)]);
+	}
+	benchSink(hits);
+}
+
+
+//-----OBJECT UPDATES-----//
+
+static void collidableMove(long long iterations, void *context){
+	std::vector<CollidableObject> &objects = *(std::vector<CollidableObject>*)context;
+	for (long long i = 0; i < iterations; i++){
+		objects[i & (SET_SIZE - 1)].move(TICK);
+	}
+	benchSink(objects[0].transform.x);
+}
+
+//the same movers spawned into a World; one op is one entity moved, as above
+struct MoverWorld {
+	World world;
+	Entity first;
+};
+
+static void worldMove(long long iterations, void *context){
+	MoverWorld &movers = *(MoverWorld*)context;
+	for (long long i = 0; i < iterations; i += SET_SIZE){
+		moveObstacles(movers.world, TICK);
+	}
+	benchSink(movers.world.get<Transform>(movers.first).x);
+}
+
+static void playerGetNewSpeed(long long iterations, void *context){
+	Player &player = *(Player*)context;
+	for (long long i = 0; i < iterations; i++){
+		//cycle through the inputs so every branch gets taken
+		player.moveRequestLeft = (i & 3) == 1;
+		player.moveRequestRight = (i & 3) == 2;
+		player.moveRequestUp = (i & 7) == 3;
+		player.getNewSpeed(TICK);
+		player.currentSpeedX = player.newSpeedX;
+		player.currentSpeedY = (player.newSpeedY < -200) ? 0 : player.newSpeedY;
+		player.jumping = false;
+	}
+	benchSink(player.newSpeedX + player.newSpeedY);
+}
+
+
+//-----MATRIX4-----//
+
+template <typename Real> struct MatrixSet {
+	std::vector<Matrix4<Real> > matrices;
+	std::vector<Point3<Real> > points;
+	std::vector<Point3<Real> > transformed;
+};
+
+template <typename Real> static void fillMatrixSet(MatrixSet<Real> &set){
+	for (int i = 0; i < SET_SIZE; i++){
+		Matrix4<Real> m = Matrix4<Real>::translate(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100))
+			* Matrix4<Real>::rotateZ(benchRandom(0, 6.28f))
+			* Matrix4<Real>::scale(benchRandom(0.5f, 2), benchRandom(0.5f, 2), benchRandom(0.5f, 2));
+		set.matrices.push_back(m);
+		set.points.push_back(Point3<Real>(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100)));
+	}
+	set.transformed.resize(set.points.size());
+}
+
+//Ops is Matrix4Scalar (the template's own operators) or Matrix4SIMD
+template <typename Real, typename Ops> static void matrixMultiply(long long iterations, void *context){
+	MatrixSet<Real> &set = *(MatrixSet<Real>*)context;
+	Matrix4<Real> acc;
+	for (long long i = 0; i < iterations; i++){
+		acc = Ops::multiply(set.matrices[i & (SET_SIZE - 1)], set.matrices[(i * 7 + 1) & (SET_SIZE - 1)]);
+		benchSink(&acc);
+	}
+	benchSink(acc.d[0]);
+}
+
+template <typename Real, typename Ops> static void matrixInverse(long long iterations, void *context){
+	MatrixSet<Real> &set = *(MatrixSet<Real>*)context;
+	Matrix4<Real> acc;
+	for (long long i = 0; i < iterations; i++){
+		acc = Ops::inverse(set.matrices[i & (SET_SIZE - 1)]);
+		benchSink(&acc);
+	}
+	benchSink(acc.d[0]);
+}
+
+template <typename Real, typename Ops> static void matrixTranspose(long long iterations, void *context){
+	MatrixSet<Real> &set = *(MatrixSet<Real>*)context;
+	Matrix4<Real> acc;
+	for (long long i = 0; i < iterations; i++){
+		acc = Ops::transpose(set.matrices[i & (SET_SIZE - 1)]);
+		benchSink(&acc);
+	}
+	benchSink(acc.d[0]);
+}
+
+//one op per point, a whole set of points per call
+template <typename Real, typename Ops> static void matrixTransformPoints(long long iterations, void *context){
+	MatrixSet<Real> &set = *(MatrixSet<Real>*)context;
+	for (long long i = 0; i < iterations; i += SET_SIZE){
+		size_t count = (size_t)std::min<long long>(SET_SIZE, iterations - i);
+		Ops::transformPoints(set.matrices[(i >> 10) & (SET_SIZE - 1)], &set.points[0], &set.transformed[0], count);
+		benchSink(&set.transformed[0]);
+	}
+	benchSink(set.transformed[0].x);
+}
+
+template <typename Real> static void matrixTransformPoint(long long iterations, void *context){
+	MatrixSet<Real> &set = *(MatrixSet<Real>*)context;
+	Real sum = 0;
+	for (long long i = 0; i < iterations; i++){
+		Point3<Real> p = set.matrices[(i >> 10) & (SET_SIZE - 1)] * set.points[i & (SET_SIZE - 1)];
+		sum += p.x;
+	}
+	benchSink(sum);
+}
+
+
+//-----AFFINE2-----//
+
+//the same 2D transforms as Affine2s and as Matrix4s
+struct AffineSet {
+	std::vector<Affine2f> affines;
+	std::vector<Matrix4f> matrices;
+	std::vector<Point2f> points;
+};
+
+static void fillAffineSet(AffineSet &set){
+	for (int i = 0; i < SET_SIZE; i++){
+		Affine2f a = Affine2f::translate(benchRandom(-100, 100), benchRandom(-100, 100))
+			* Affine2f::rotate(benchRandom(0, 6.28f))
+			* Affine2f::scale(benchRandom(0.5f, 2), benchRandom(0.5f, 2));
+		set.affines.push_back(a);
+		set.matrices.push_back(a.toMatrix4());
+		set.points.push_back(Point2f(benchRandom(-100, 100), benchRandom(-100, 100)));
+	}
+}
+
+//Transform is Affine2f or Matrix4f
+template <typename Transform> static const std::vector<Transform>& transforms(const AffineSet&);
+template <> const std::vector<Affine2f>& transforms<Affine2f>(const AffineSet &set){ return set.affines; }
+template <> const std::vector<Matrix4f>& transforms<Matrix4f>(const AffineSet &set){ return set.matrices; }
+
+template <typename Transform> static void transform2dMultiply(long long iterations, void *context){
+	AffineSet &set = *(AffineSet*)context;
+	const std::vector<Transform> &t = transforms<Transform>(set);
+	Transform acc;
+	for (long long i = 0; i < iterations; i++){
+		acc = t[i & (SET_SIZE - 1)] * t[(i * 7 + 1) & (SET_SIZE - 1)];
+		benchSink(&acc);
+	}
+	benchSink(acc.d[0]);
+}
+
+template <typename Transform> static void transform2dInverse(long long iterations, void *context){
+	AffineSet &set = *(AffineSet*)context;
+	const std::vector<Transform> &t = transforms<Transform>(set);
+	Transform acc;
+	for (long long i = 0; i < iterations; i++){
+		acc = t[i & (SET_SIZE - 1)].inverse();
+		benchSink(&acc);
+	}
+	benchSink(acc.d[0]);
+}
+
+template <typename Transform> static void transform2dPoint(long long iterations, void *context){
+	AffineSet &set = *(AffineSet*)context;
+	const std::vector<Transform> &t = transforms<Transform>(set);
+	float sum = 0;
+	for (long long i = 0; i < iterations; i++){
+		Point2f p = t[(i >> 10) & (SET_SIZE - 1)] * set.points[i & (SET_SIZE - 1)];
+		sum += p.x;
+	}
+	benchSink(sum);
+}
+
+
+//-----FAST MATH-----//
+
+//FastMath against the libm calls it stands in for
+struct FastMathSet {
+	std::vector<Vector3f> vectors, normalised;
+	std::vector<float> angles, sines, cosines;
+};
+
+static void fillFastMathSet(FastMathSet &set){
+	for (int i = 0; i < SET_SIZE; i++){
+		set.vectors.push_back(Vector3f(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100)));
+		set.angles.push_back(benchRandom(-10, 10));
+	}
+	set.normalised.resize(SET_SIZE);
+	set.sines.resize(SET_SIZE);
+	set.cosines.resize(SET_SIZE);
+}
+
+static void normaliseLibm(long long iterations, void *context){
+	FastMathSet &set = *(FastMathSet*)context;
+	float sum = 0;
+	for (long long i = 0; i < iterations; i++){
+		sum += set.vectors[i & (SET_SIZE - 1)].getNormalised().x;
+	}
+	benchSink(sum);
+}
+
+static void normaliseFast(long long iterations, void *context){
+	FastMathSet &set = *(FastMathSet*)context;
+	float sum = 0;
+	for (long long i = 0; i < iterations; i++){
+		sum += FastMath::normalised(set.vectors[i & (SET_SIZE - 1)]).x;
+	}
+	benchSink(sum);
+}
+
+//per vector, SET_SIZE at a time
+static void normaliseFastBatch(long long iterations, void *context){
+	FastMathSet &set = *(FastMathSet*)context;
+	for (long long i = 0; i < iterations; i += SET_SIZE){
+		size_t count = (size_t)std::min<long long>(SET_SIZE, iterations - i);
+		FastMath::normalise(&set.vectors[0], &set.normalised[0], count);
+		benchSink(&set.normalised[0]);
+	}
+}
+
+static void sinCosLibm(long long iterations, void *context){
+	FastMathSet &set = *(FastMathSet*)context;
+	float sum = 0;
+	for (long long i = 0; i < iterations; i++){
+		float a = set.angles[i & (SET_SIZE - 1)];
+		sum += sinf(a) + cosf(a);
+	}
+	benchSink(sum);
+}
+
+static void sinCosFast(long long iterations, void *context){
+	FastMathSet &set = *(FastMathSet*)context;
+	float sum = 0;
+	for (long long i = 0; i < iterations; i++){
+		float s, c;
+		FastMath::sinCos(set.angles[i & (SET_SIZE - 1)], s, c);
+		sum += s + c;
+	}
+	benchSink(sum);
+}
+
+//per angle, SET_SIZE at a time
+static void sinCosFastBatch(long long iterations, void *context){
+	FastMathSet &set = *(FastMathSet*)context;
+	for (long long i = 0; i < iterations; i += SET_SIZE){
+		size_t count = (size_t)std::min<long long>(SET_SIZE, iterations - i);
+		FastMath::sinCos(&set.angles[0], &set.sines[0], &set.cosines[0], count);
+		benchSink(&set.sines[0]);
+		benchSink(&set.cosines[0]);
+	}
+}
+
+
+//-----GEOMETRY BATCH-----//
+
+//one line or point against 4096 segments or triangles, as a long line of sight or a
+//slope-heavy level would; ns are per query, not per element
+static const int GEOMETRY_COUNT = 4096;
+
+struct GeometrySet {
+	std::vector<float> ax, ay, bx, by, cx, cy;
+	std::vector<Segment2f> lines;
+	SegmentSpan2<float> segments;
+	TriangleSpan2<float> triangles;
+};
+
+static void fillGeometrySet(GeometrySet &set){
+	for (int i = 0; i < GEOMETRY_COUNT; i++){
+		float x = benchRandom(-100, 290), y = benchRandom(-100, 10000);
+		set.ax.push_back(x);
+		set.ay.push_back(y);
+		set.bx.push_back(x + benchRandom(-40, 40));
+		set.by.push_back(y + benchRandom(-40, 40));
+		set.cx.push_back(x + benchRandom(-40, 40));
+		set.cy.push_back(y + benchRandom(-40, 40));
+	}
+	for (int i = 0; i < SET_SIZE; i++){
+		Point2f a(benchRandom(-100, 290), benchRandom(-100, 10000));
+		set.lines.push_back(Segment2f(a, a + Vector2f(benchRandom(-400, 400), benchRandom(-400, 400))));
+	}
+	set.segments = SegmentSpan2<float>(&set.ax[0], &set.ay[0], &set.bx[0], &set.by[0], GEOMETRY_COUNT);
+	set.triangles = TriangleSpan2<float>(&set.ax[0], &set.ay[0], &set.bx[0], &set.by[0], &set.cx[0], &set.cy[0], GEOMETRY_COUNT);
+}
+
+static void segmentNearestHitLoop(long long iterations, void *context){
+	GeometrySet &set = *(GeometrySet*)context;
+	size_t found = 0;
+	for (long long i = 0; i < iterations; i++){
+		const Segment2f &line = set.lines[i & (SET_SIZE - 1)];
+		float bestT = 2;
+		size_t best = GEOMETRY_COUNT;
+		for (size_t s = 0; s < GEOMETRY_COUNT; s++){
+			float t;
+			Point2f p;
+			if (line.intersect(set.segments.get(s), t, p) && t < bestT){
+				bestT = t;
+				best = s;
+			}
+		}
+		found += best;
+	}
+	benchSink((double)found);
+}
+
+static void segmentNearestHitBatch(long long iterations, void *context){
+	GeometrySet &set = *(GeometrySet*)context;
+	size_t found = 0;
+	for (long long i = 0; i < iterations; i++){
+		size_t index = GEOMETRY_COUNT;
+		float t;
+		Point2f p;
+		GeometryBatch<float>::nearestIntersection(set.lines[i & (SET_SIZE - 1)], set.segments, index, t, p);
+		found += index;
+	}
+	benchSink((double)found);
+}
+
+static void segmentNearestPointLoop(long long iterations, void *context){
+	GeometrySet &set = *(GeometrySet*)context;
+	size_t found = 0;
+	for (long long i = 0; i < iterations; i++){
+		const Point2f &p = set.lines[i & (SET_SIZE - 1)].a;
+		float bestDistance = 1e30f;
+		size_t best = GEOMETRY_COUNT;
+		for (size_t s = 0; s < GEOMETRY_COUNT; s++){
+			float t;
+			float distance = p.sqrDistanceTo(set.segments.get(s).closestParamAndPointTo(p, t));
+			if (distance < bestDistance){
+				bestDistance = distance;
+				best = s;
+			}
+		}
+		found += best;
+	}
+	benchSink((double)found);
+}
+
+static void segmentNearestPointBatch(long long iterations, void *context){
+	GeometrySet &set = *(GeometrySet*)context;
+	size_t found = 0;
+	for (long long i = 0; i < iterations; i++){
+		size_t index = GEOMETRY_COUNT;
+		float t;
+		Point2f closest;
+		GeometryBatch<float>::nearestSegment(set.lines[i & (SET_SIZE - 1)].a, set.segments, index, t, closest);
+		found += index;
+	}
+	benchSink((double)found);
+}
+
+static void triangleContainsLoop(long long iterations, void *context){
+	GeometrySet &set = *(GeometrySet*)context;
+	size_t found = 0;
+	for (long long i = 0; i < iterations; i++){
+		const Point2f &p = set.lines[i & (SET_SIZE - 1)].b;
+		size_t s = 0;
+		while (s < GEOMETRY_COUNT && !set.triangles.get(s).contains(p)){
+			s++;
+		}
+		found += s;
+	}
+	benchSink((double)found);
+}
+
+static void triangleContainsBatch(long long iterations, void *context){
+	GeometrySet &set = *(GeometrySet*)context;
+	size_t found = 0;
+	for (long long i = 0; i < iterations; i++){
+		size_t index = GEOMETRY_COUNT;
+		GeometryBatch<float>::firstContaining(set.lines[i & (SET_SIZE - 1)].b, set.triangles, index);
+		found += index;
+	}
+	benchSink((double)found);
+}
+
+
+//-----BATCH TRANSFORMS-----//
+
+//10^6 points each way round, well outside the caches
+struct BatchSet {
+	Matrix4f matrix;
+	std::vector<Point2f> points2, transformed2;
+	std::vector<Point3f> points3, transformed3;
+	std::vector<float> xs, ys, zs, outXs, outYs, outZs;
+};
+
+static void fillBatchSet(BatchSet &set){
+	set.matrix = Matrix4f::translate(12, -40, 3) * Matrix4f::rotateZ(0.7f) * Matrix4f::scale(1.5f, 0.5f, 2);
+	for (size_t i = 0; i < BATCH_POINTS; i++){
+		set.points3.push_back(Point3f(benchRandom(-100, 100), benchRandom(-100, 100), benchRandom(-100, 100)));
+		set.points2.push_back(set.points3.back().toPoint2());
+		set.xs.push_back(set.points3.back().x);
+		set.ys.push_back(set.points3.back().y);
+		set.zs.push_back(set.points3.back().z);
+	}
+	set.transformed2.resize(BATCH_POINTS);
+	set.transformed3.resize(BATCH_POINTS);
+	set.outXs.resize(BATCH_POINTS);
+	set.outYs.resize(BATCH_POINTS);
+	set.outZs.resize(BATCH_POINTS);
+}
+
+//one op per point, the set from the start in chunks of up to all of it
+static void transformPoints2Operator(long long iterations, void *context){
+	BatchSet &set = *(BatchSet*)context;
+	for (long long done = 0, count = 0; done < iterations; done += count){
+		count = std::min<long long>(BATCH_POINTS, iterations - done);
+		for (long long i = 0; i < count; i++){
+			set.transformed2[i] = set.matrix * set.points2[i];
+		}
+		benchSink(&set.transformed2[0]);
+	}
+}
+
+static void transformPoints2BatchAoS(long long iterations, void *context){
+	BatchSet &set = *(BatchSet*)context;
+	for (long long done = 0, count = 0; done < iterations; done += count){
+		count = std::min<long long>(BATCH_POINTS, iterations - done);
+		TransformBatchf::transformPoints2(set.matrix, PointSpan2<const float>::aos(&set.points2[0], (size_t)count),
+			PointSpan2f::aos(&set.transformed2[0], (size_t)count));
+		benchSink(&set.transformed2[0]);
+	}
+}
+
+static void transformPoints2BatchSoA(long long iterations, void *context){
+	BatchSet &set = *(BatchSet*)context;
+	for (long long done = 0, count = 0; done < iterations; done += count){
+		count = std::min<long long>(BATCH_POINTS, iterations - done);
+		TransformBatchf::transformPoints2(set.matrix, PointSpan2<const float>::soa(&set.xs[0], &set.ys[0], (size_t)count),
+			PointSpan2f::soa(&set.outXs[0], &set.outYs[0], (size_t)count));
+		benchSink(&set.outXs[0]);
+	}
+}
+
+static void transformPoints3Operator(long long iterations, void *context){
+	BatchSet &set = *(BatchSet*)context;
+	for (long long done = 0, count = 0; done < iterations; done += count){
+		count = std::min<long long>(BATCH_POINTS, iterations - done);
+		for (long long i = 0; i < count; i++){
+			set.transformed3[i] = set.matrix * set.points3[i];
+		}
+		benchSink(&set.transformed3[0]);
+	}
+}
+
+static void transformPoints3BatchAoS(long long iterations, void *context){
+	BatchSet &set = *(BatchSet*)context;
+	for (long long done = 0, count = 0; done < iterations; done += count){
+		count = std::min<long long>(BATCH_POINTS, iterations - done);
+		TransformBatchf::transformPoints3(set.matrix, PointSpan3<const float>::aos(&set.points3[0], (size_t)count),
+			PointSpan3f::aos(&set.transformed3[0], (size_t)count));
+		benchSink(&set.transformed3[0]);
+	}
+}
+
+static void transformPoints3BatchSoA(long long iterations, void *context){
+	BatchSet &set = *(BatchSet*)context;
+	for (long long done = 0, count = 0; done < iterations; done += count){
+		count = std::min<long long>(BATCH_POINTS, iterations - done);
+		TransformBatchf::transformPoints3(set.matrix, PointSpan3<const float>::soa(&set.xs[0], &set.ys[0], &set.zs[0], (size_t)count),
+			PointSpan3f::soa(&set.outXs[0], &set.outYs[0], &set.outZs[0], (size_t)count));
+		benchSink(&set.outXs[0]);
+	}
+}
+
+
+//-----RENDER SUBMISSION-----//
+
+//a second into a generated tower, one frame recorded; an op is that whole frame
+//walked by NullRenderBackend, the cost of submission with nothing behind it
+struct SubmitSet {
+	CommandBuffer frame;
+	NullRenderBackend backend;
+};
+
+static void nullSubmit(long long iterations, void *context){
+	SubmitSet &set = *(SubmitSet*)context;
+	for (long long i = 0; i < iterations; i++){
+		set.backend.execute(set.frame);
+	}
+	benchSink((double)set.backend.vertices);
+}
+
+static void runSubmit(BenchmarkRunner &runner, int platforms){
+	std::ostringstream name;
+	name << "null_backend_submit/" << platforms;
+	if (!runner.wants(name.str())){
+		return;
+	}
+
+	SubmitSet set;
+	PlayGame game;
+	loadTower(game, 1, platforms);
+	for (int t = 0; t < 60; t++){
+		game.update(TICK);
+	}
+	commandBuffer.clear();
+	game.draw();
+	set.frame = commandBuffer;
+	commandBuffer.clear();
+
+	BenchResult &result = runner.run(name.str(), nullSubmit, &set);
+	result.counters.push_back(std::make_pair(std::string("commands"), (double)set.frame.commands.size()));
+	result.counters.push_back(std::make_pair(std::string("vertices"), (double)(set.backend.vertices / set.backend.frames)));
+}
+
+
+//-----SOFTWARE RASTER-----//
+
+//200 flat and textured (modulated, translucent) quads over a cleared 1000x1000
+//framebuffer, an op is the whole frame; once with the SSE2 spans, once without
+struct RasterSet {
+	RasterSet() : simd(1000, 1000), scalar(1000, 1000) {}
+
+	CommandBuffer frame;
+	SoftwareRenderBackend simd, scalar;
+};
+
+static const GLuint RASTER_TEXTURE = 0x7fff0001;
+
+static void fillRasterSet(RasterSet &set){
+	std::vector<unsigned char> texels(64 * 64 * 4);
+	for (size_t i = 0; i < texels.size(); i++){
+		texels[i] = (unsigned char)benchRandom(0, 255.99f);
+	}
+	textureStore.add(RASTER_TEXTURE, 64, 64, GL_RGBA, &texels[0]);
+	set.scalar.simd = false;
+
+	set.frame.clearColour(Palette::packed(BLACK));
+	for (int i = 0; i < 200; i++){
+		set.frame.colour(Palette::packed((Color)(i % COLOR_COUNT)));
+		if (i & 1){
+			set.frame.begin(PRIM_QUADS, RASTER_TEXTURE, TEX_MODULATE);
+		}
+		else{
+			set.frame.begin(PRIM_QUADS);
+		}
+		float x = benchRandom(-50, 950), y = benchRandom(-50, 950);
+		float w = benchRandom(20, 300), h = benchRandom(10, 120);
+		set.frame.vertex(x, y, 0, 0);
+		set.frame.vertex(x + w, y, w / 64, 0);
+		set.frame.vertex(x + w, y + h, w / 64, h / 64);
+		set.frame.vertex(x, y + h, 0, h / 64);
+	}
+}
+
+static void rasterSIMD(long long iterations, void *context){
+	RasterSet &set = *(RasterSet*)context;
+	for (long long i = 0; i < iterations; i++){
+		set.simd.execute(set.frame);
+	}
+	benchSink(&set.simd.framebuffer[0]);
+}
+
+static void rasterScalar(long long iterations, void *context){
+	RasterSet &set = *(RasterSet*)context;
+	for (long long i = 0; i < iterations; i++){
+		set.scalar.execute(set.frame);
+	}
+	benchSink(&set.scalar.framebuffer[0]);
+}
+
+
+//-----WHOLE TICKS-----//
+
+static void runTicks(BenchmarkRunner &runner, int platforms){
+	std::ostringstream tickName, collisionName, drawName;
+	tickName << "playgame_tick/" << platforms;
+	collisionName << "playgame_collision/" << platforms;
+	drawName << "playgame_draw/" << platforms;
+	if (!runner.wants(tickName.str()) && !runner.wants(collisionName.str()) && !runner.wants(drawName.str())){
+		return;
+	}
+
+	int ticks = (platforms >= 1000000) ? 30 : (platforms >= 100000) ? 120 : 600;
+	TowerSample sample = measureTower(1, platforms, ticks);
+
+	BenchResult &tick = runner.add(tickName.str(), ticks, sample.tickUs * 1000);
+	tick.counters.push_back(std::make_pair(std::string("obstacles"), (double)sample.obstacles));
+	tick.counters.push_back(std::make_pair(std::string("generate_ms"), sample.generateMs));
+	tick.counters.push_back(std::make_pair(std::string("prepare_ms"), sample.prepareMs));
+	BenchResult &collision = runner.add(collisionName.str(), ticks, sample.collisionUs * 1000);
+	collision.counters.push_back(std::make_pair(std::string("obstacles"), (double)sample.obstacles));
+	collision.counters.push_back(std::make_pair(std::string("pruned_percent"), sample.prunedPercent));
+	BenchResult &draw = runner.add(drawName.str(), ticks, sample.drawUs * 1000);
+	draw.counters.push_back(std::make_pair(std::string("visible"), sample.visible));
+	draw.counters.push_back(std::make_pair(std::string("culled"), sample.culled));
+	draw.counters.push_back(std::make_pair(std::string("chunks_drawn"), sample.chunksDrawn));
+	draw.counters.push_back(std::make_pair(std::string("chunks"), (double)sample.chunks));
+}
+
+
+int main(int argc, char **argv){
+	BenchmarkRunner runner;
+	const char *outPath = 0;
+	bool full = false, check = false;
+
+	for (int a = 1; a < argc; a++){
+		if (!strcmp(argv[a], "--filter") && a + 1 < argc){
+			runner.setFilter(argv[++a]);
+		}
+		else if (!strcmp(argv[a], "--out") && a + 1 < argc){
+			outPath = argv[++a];
+		}
+		else if (!strcmp(argv[a], "--full")){
+			full = true;
+		}
+		else if (!strcmp(argv[a], "--check")){
+			check = true;
+		}
+		else{
+			std::cerr << "usage: " << argv[0] << " [--filter <substring>] [--out <file.json>] [--full] [--check]" << std::endl;
+			return 1;
+		}
+	}
+	if (check){
+		return (runChecks(std::cout) == 0) ? 0 : 1;
+	}
+
+	BoxSet boxes;
+	fillBoxSet(boxes);
+
+	std::vector<CollidableObject> movers;
+	CollidableObject::PlatformType moverTypes[] = { CollidableObject::MOVINGX, CollidableObject::MOVINGY, CollidableObject::ENEMY, CollidableObject::ALPHAFLOOR };
+	for (int i = 0; i < SET_SIZE; i++){
+		CollidableObject mover(Point2f(60, 20), Point2f(benchRandom(-100, 290), benchRandom(-100, 300)), moverTypes[i & 3]);
+		mover.setMotionDuration(benchRandom(1, 4));
+		mover.setSpeedMod(20);
+		mover.motion.range = 20;
+		movers.push_back(mover);
+	}
+	MoverWorld moverWorld;
+	for (int i = 0; i < SET_SIZE; i++){
+		Entity e = spawnObstacle(moverWorld.world, movers[i]);
+		if (i == 0){
+			moverWorld.first = e;
+		}
+	}
+
+	Player player(Point2f(20, 20), Point2f(100, -70));
+
+	MatrixSet<float> matricesF;
+	MatrixSet<double> matricesD;
+	fillMatrixSet(matricesF);
+	fillMatrixSet(matricesD);
+	AffineSet affines;
+	fillAffineSet(affines);
+	FastMathSet fastMath;
+	fillFastMathSet(fastMath);
+	GeometrySet geometry;
+	fillGeometrySet(geometry);
+	BatchSet batch;
+	RasterSet raster;
+
+	struct { const char *name; BenchmarkRunner::Kernel kernel; void *context; } kernels[] = {
+		{ "boundingbox_collide", boundingBoxCollide, &boxes },
+		{ "circle_intersects_circle", circleIntersectsCircle, &boxes },
+		{ "circle_intersects_box", circleIntersectsBox, &boxes },
+		{ "collidable_move", collidableMove, &movers },
+		{ "world_move", worldMove, &moverWorld },
+		{ "player_get_new_speed", playerGetNewSpeed, &player },
+		{ "matrix4f_multiply", matrixMultiply<float, Matrix4Scalar<float> >, &matricesF },
+		{ "matrix4d_multiply", matrixMultiply<double, Matrix4Scalar<double> >, &matricesD },
+		{ "matrix4f_multiply_simd", matrixMultiply<float, Matrix4SIMD<float> >, &matricesF },
+		{ "matrix4d_multiply_simd", matrixMultiply<double, Matrix4SIMD<double> >, &matricesD },
+		{ "matrix4f_inverse", matrixInverse<float, Matrix4Scalar<float> >, &matricesF },
+		{ "matrix4d_inverse", matrixInverse<double, Matrix4Scalar<double> >, &matricesD },
+		{ "matrix4f_inverse_simd", matrixInverse<float, Matrix4SIMD<float> >, &matricesF },
+		{ "matrix4d_inverse_simd", matrixInverse<double, Matrix4SIMD<double> >, &matricesD },
+		{ "matrix4f_transpose", matrixTranspose<float, Matrix4Scalar<float> >, &matricesF },
+		{ "matrix4d_transpose", matrixTranspose<double, Matrix4Scalar<double> >, &matricesD },
+		{ "matrix4f_transpose_simd", matrixTranspose<float, Matrix4SIMD<float> >, &matricesF },
+		{ "matrix4d_transpose_simd", matrixTranspose<double, Matrix4SIMD<double> >, &matricesD },
+		{ "matrix4f_transform_point", matrixTransformPoint<float>, &matricesF },
+		{ "matrix4d_transform_point", matrixTransformPoint<double>, &matricesD },
+		{ "matrix4f_transform_points", matrixTransformPoints<float, Matrix4Scalar<float> >, &matricesF },
+		{ "matrix4d_transform_points", matrixTransformPoints<double, Matrix4Scalar<double> >, &matricesD },
+		{ "matrix4f_transform_points_simd", matrixTransformPoints<float, Matrix4SIMD<float> >, &matricesF },
+		{ "matrix4d_transform_points_simd", matrixTransformPoints<double, Matrix4SIMD<double> >, &matricesD },
+		{ "transform2d_multiply_matrix4f", transform2dMultiply<Matrix4f>, &affines },
+		{ "transform2d_multiply_affine2f", transform2dMultiply<Affine2f>, &affines },
+		{ "transform2d_inverse_matrix4f", transform2dInverse<Matrix4f>, &affines },
+		{ "transform2d_inverse_affine2f", transform2dInverse<Affine2f>, &affines },
+		{ "transform2d_point_matrix4f", transform2dPoint<Matrix4f>, &affines },
+		{ "transform2d_point_affine2f", transform2dPoint<Affine2f>, &affines },
+		{ "normalise_vector3f_libm", normaliseLibm, &fastMath },
+		{ "normalise_vector3f_fast", normaliseFast, &fastMath },
+		{ "normalise_vector3f_fast_batch", normaliseFastBatch, &fastMath },
+		{ "sincos_libm", sinCosLibm, &fastMath },
+		{ "sincos_fast", sinCosFast, &fastMath },
+		{ "sincos_fast_batch", sinCosFastBatch, &fastMath },
+		{ "segment_nearest_hit_loop/4096", segmentNearestHitLoop, &geometry },
+		{ "segment_nearest_hit_batch/4096", segmentNearestHitBatch, &geometry },
+		{ "segment_nearest_point_loop/4096", segmentNearestPointLoop, &geometry },
+		{ "segment_nearest_point_batch/4096", segmentNearestPointBatch, &geometry },
+		{ "triangle_first_containing_loop/4096", triangleContainsLoop, &geometry },
+		{ "triangle_first_containing_batch/4096", triangleContainsBatch, &geometry },
+		{ "batch_points2f_operator/1000000", transformPoints2Operator, &batch },
+		{ "batch_points2f_aos/1000000", transformPoints2BatchAoS, &batch },
+		{ "batch_points2f_soa/1000000", transformPoints2BatchSoA, &batch },
+		{ "batch_points3f_operator/1000000", transformPoints3Operator, &batch },
+		{ "batch_points3f_aos/1000000", transformPoints3BatchAoS, &batch },
+		{ "batch_points3f_soa/1000000", transformPoints3BatchSoA, &batch },
+		{ "software_raster/1000x1000", rasterSIMD, &raster },
+		{ "software_raster_scalar/1000x1000", rasterScalar, &raster },
+	};
+	//a few tens of MB, only when something uses it
+	for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++){
+		if (kernels[k].context == &batch && runner.wants(kernels[k].name)){
+			fillBatchSet(batch);
+			break;
+		}
+	}
+	for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++){
+		if (kernels[k].context == &raster && runner.wants(kernels[k].name)){
+			fillRasterSet(raster);
+			break;
+		}
+	}
+	for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++){
+		if (runner.wants(kernels[k].name)){
+			runner.run(kernels[k].name, kernels[k].kernel, kernels[k].context);
+		}
+	}
+
+	runSubmit(runner, 10000);
+	for (int platforms = 100; platforms <= ((full) ? 1000000 : 100000); platforms *= 10){
+		runTicks(runner, platforms);
+	}
+
+	if (outPath){
+		std::ofstream out(outPath);
+		runner.writeJson(out);
+	}
+	else{
+		runner.writeJson(std::cout);
+	}
+	return 0;
+}